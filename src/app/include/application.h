@@ -68,6 +68,8 @@ private:
     bool initializeHardware();
     bool initializeCore();
     bool initializeData();
+    void initializeFringingModel();
+    static void scheduleFringingModelUpdate();
     bool initializeUI();
     void connectSignals();
 };
\ No newline at end of file
@@ -12,6 +12,7 @@ class DataRecorder;
 class SafetyManager;
 class SerialInterface;
 class ExportManager;
+class ExportJob;
 class Logger;
 struct SensorData;
 struct MeasurementData;
@@ -106,10 +107,16 @@ public:
     // 获取传感器数据（JSON格式）
     std::string getCurrentSensorDataJson() const;
     std::string getAllMeasurementsJson() const;
+    // 记录数据的统计和电容-高度线性回归（按数据版本增量缓存）
+    std::string getAnalysisJson() const;
+    // 传感器数据流的平均功率谱（频率、密度和峰值频率）
+    std::string getSpectrumJson() const;
     
     // ===== 数据导出API =====
     bool exportToCSV(const std::string& filename);
     bool exportWithOptions(const std::string& filename, int format);
+    // 后台导出，不阻塞调用线程；返回的任务句柄提供进度、取消和等待
+    std::shared_ptr<ExportJob> exportInBackground(const std::string& filename, int format);
     std::string getExportStatisticsJson() const;
     std::string generateDefaultFilename() const;
     
@@ -5,6 +5,7 @@
 #include <QMainWindow>  // 添加这个
 #include <QWidget> 
 #include <QDir>
+#include <atomic>
 #include "../../ui/include/mainwindow.h"
 #include "../../hardware/include/serial_interface.h"
 #include "../../hardware/include/sensor_interface.h"
@@ -17,6 +18,9 @@
 #include "../../data/include/file_manager.h"
 #include "../../utils/include/logger.h"
 #include "../../models/include/system_config.h"
+#include "../../models/include/fringing_capacitance.h"
+#include "../../models/include/physics_calculator.h"
+#include "../../utils/include/thread_pool.h"
 
 Application::Application(QObject* parent)
     : QObject(parent)
@@ -38,6 +42,7 @@ bool Application::initialize() {
     dir.mkpath("./runtime/data");
     dir.mkpath("./runtime/logs");
     dir.mkpath("./runtime/config");
+    dir.mkpath("./runtime/cache");
 
     m_controller = std::make_unique<ApplicationController>();
     
@@ -60,6 +65,8 @@ bool Application::initialize() {
         return false;
     }
 
+    initializeFringingModel();
+
     m_controller->initialize(
         m_serialInterface,
         m_motorController,
@@ -90,6 +97,7 @@ void Application::shutdown() {
     // 停止所有活动
     if (m_sensorManager) {
         m_sensorManager->stop();
+        m_sensorManager->saveTemperatureCompensation("./runtime/config/temperature_compensation.json");
     }
     
     if (m_motorController) {
@@ -192,6 +200,7 @@ bool Application::initializeCore() {
             LOG_ERROR("SensorManager is null after creation");
             return false;
         }
+        m_sensorManager->loadTemperatureCompensation("./runtime/config/temperature_compensation.json");
 
         LOG_INFO("Creating DataRecorder...");
         m_dataRecorder = std::make_unique<DataRecorder>();
@@ -226,6 +235,30 @@ bool Application::initializeData() {
     }
 }
 
+void Application::initializeFringingModel() {
+    // 校准写回或修改极板面积、限位后表格失效，随配置变更通知重新加载或构建
+    SystemConfig::getInstance().setConfigChangeCallback([]() { scheduleFringingModelUpdate(); });
+    scheduleFringingModelUpdate();
+}
+
+void Application::scheduleFringingModelUpdate() {
+    static std::atomic<bool> updateQueued{false};
+
+    auto model = PhysicsCalculator::getFringingModel();
+    if (model && model->matches(SystemConfig::getInstance())) {
+        return;
+    }
+    // 首次构建表格需要数秒，放到线程池中进行；完成前理论电容按平行板公式计算。
+    // 排队期间的多次变更只构建一次
+    if (updateQueued.exchange(true)) {
+        return;
+    }
+    ThreadPool::shared().post([]() {
+        updateQueued.store(false);
+        FringingCapacitanceModel::ensureInstalled(SystemConfig::getInstance(), "./runtime/cache");
+    });
+}
+
 bool Application::initializeUI() {
     try {
         // 创建主窗口
@@ -5,6 +5,9 @@
 #include "../../core/include/safety_manager.h"
 #include "../../core/include/data_recorder.h"
 #include "../../data/include/export_manager.h"
+#include "../../data/include/spectrogram.h"
+#include "../../data/include/analysis_cache.h"
+#include "../../data/include/data_processor.h"
 #include "../../models/include/device_info.h"
 #include "../../models/include/sensor_data.h"
 #include "../../models/include/measurement_data.h"
@@ -18,6 +21,7 @@
 #include <ctime>
 #include <thread>
 #include <atomic>
+#include <algorithm>
 
 // 实现结构体
 struct ApplicationController::Impl {
@@ -27,6 +31,11 @@ struct ApplicationController::Impl {
     std::shared_ptr<SafetyManager> safety;
     std::shared_ptr<DataRecorder> recorder;
     std::shared_ptr<ExportManager> exporter;
+    // 传感器数据流的实时频谱（观察机械共振），在setupCallbacks中按采样间隔创建
+    std::shared_ptr<StreamingSpectrogram> spectrogram;
+    // 记录数据的统计和回归按数据版本缓存，界面刷新时只处理新增和淘汰的记录
+    DataProcessor processor;
+    AnalysisCache analysisCache;
 
     std::thread serialReadThread;
     std::atomic<bool> isReading{false};
@@ -478,6 +487,9 @@ bool ApplicationController::startSensorMonitoring() {
         return false;
     }
     pImpl->sensor->setDataCallback([this](const SensorData& data) {
+        if (pImpl->spectrogram) {
+            pImpl->spectrogram->pushSensorData(data);
+        }
         {
             std::lock_guard<std::mutex> lock(pImpl->stateMutex);
             pImpl->lastSensorData = data;
@@ -545,6 +557,64 @@ std::string ApplicationController::getCurrentSensorDataJson() const {
     return pImpl->sensorDataToJson(data);
 }
 
+std::string ApplicationController::getAnalysisJson() const {
+    if (!pImpl->recorder || !pImpl->recorder->hasData()) {
+        return "{}";
+    }
+    
+    auto recorder = pImpl->recorder;
+    AnalysisCache::DeltaSource source = [recorder](const DatasetVersion& since, DatasetVersion& current) {
+        return recorder->getMeasurementsSince(since, current);
+    };
+    DatasetVersion version = recorder->getVersion();
+    DataStatistics stats = pImpl->analysisCache.statistics(pImpl->processor, version, source);
+    LinearRegression fit = pImpl->analysisCache.regression(pImpl->processor, version, source,
+                                                           DataField::HEIGHT, DataField::CAPACITANCE);
+    
+    std::stringstream json;
+    json << std::fixed << std::setprecision(4);
+    json << "{\"count\":" << stats.dataCount
+         << ",\"meanHeight\":" << stats.meanHeight
+         << ",\"stdDevHeight\":" << stats.stdDevHeight
+         << ",\"medianHeight\":" << stats.median
+         << ",\"meanAngle\":" << stats.meanAngle
+         << ",\"meanCapacitance\":" << stats.meanCapacitance
+         << ",\"stdDevCapacitance\":" << stats.stdDevCapacitance
+         << ",\"minCapacitance\":" << stats.minCapacitance
+         << ",\"maxCapacitance\":" << stats.maxCapacitance
+         << ",\"meanTemperature\":" << stats.meanTemperature
+         << ",\"regression\":{\"slope\":" << fit.slope
+         << ",\"intercept\":" << fit.intercept
+         << ",\"rSquared\":" << fit.rSquared << "}}";
+    return json.str();
+}
+
+std::string ApplicationController::getSpectrumJson() const {
+    if (!pImpl->spectrogram || pImpl->spectrogram->getFrameCount() == 0) {
+        return "{}";
+    }
+    
+    const auto& spectrogram = *pImpl->spectrogram;
+    std::vector<double> frequencies = spectrogram.getFrequencies();
+    std::vector<double> density = spectrogram.getAveragedDensity();
+    
+    std::stringstream json;
+    json << std::setprecision(6);
+    json << "{\"samplingRate\":" << spectrogram.getSamplingRate()
+         << ",\"frames\":" << spectrogram.getFrameCount()
+         << ",\"peakFrequency\":" << spectrogram.getPeakFrequency()
+         << ",\"frequencies\":[";
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        json << (i > 0 ? "," : "") << frequencies[i];
+    }
+    json << "],\"density\":[";
+    for (size_t i = 0; i < density.size(); ++i) {
+        json << (i > 0 ? "," : "") << density[i];
+    }
+    json << "]}";
+    return json.str();
+}
+
 std::string ApplicationController::Impl::sensorDataToJson(const SensorData& data) const {
     auto doubleToJson = [](double value) -> std::string {
         if (std::isnan(value)) {
@@ -605,6 +675,58 @@ bool ApplicationController::exportToCSV(const std::string& filename) {
     }
 }
 
+bool ApplicationController::exportWithOptions(const std::string& filename, int format) {
+    if (!pImpl->recorder || !pImpl->exporter) {
+        Logger::getInstance().error("DataRecorder or ExportManager not available");
+        return false;
+    }
+    
+    if (format < 0 || format > static_cast<int>(ExportFormat::CUSTOM)) {
+        Logger::getInstance().error("Invalid export format: " + std::to_string(format));
+        return false;
+    }
+    
+    ExportOptions options = pImpl->exporter->getDefaultOptions();
+    options.format = static_cast<ExportFormat>(format);
+    
+    try {
+        // 记录器直接作为分块数据源，导出过程中不复制全部记录
+        bool success = pImpl->exporter->exportData(*pImpl->recorder, filename, options);
+        
+        if (success) {
+            Logger::getInstance().info("Data exported to: " + filename);
+        } else {
+            Logger::getInstance().error("Failed to export data: " + pImpl->exporter->getLastError());
+        }
+        
+        return success;
+        
+    } catch (const std::exception& e) {
+        Logger::getInstance().error("Export failed: " + std::string(e.what()));
+        return false;
+    }
+}
+
+std::shared_ptr<ExportJob> ApplicationController::exportInBackground(const std::string& filename, int format) {
+    if (!pImpl->recorder || !pImpl->exporter) {
+        Logger::getInstance().error("DataRecorder or ExportManager not available");
+        return nullptr;
+    }
+    
+    if (format < 0 || format > static_cast<int>(ExportFormat::CUSTOM)) {
+        Logger::getInstance().error("Invalid export format: " + std::to_string(format));
+        return nullptr;
+    }
+    
+    ExportTarget target;
+    target.filename = filename;
+    target.options = pImpl->exporter->getDefaultOptions();
+    target.options.format = static_cast<ExportFormat>(format);
+    
+    Logger::getInstance().info("Background export started: " + filename);
+    return pImpl->exporter->submitExport(pImpl->recorder, {target});
+}
+
 std::vector<MeasurementData> ApplicationController::getRecordedData() const {
     std::vector<MeasurementData> result;
     
@@ -727,6 +849,10 @@ void ApplicationController::Impl::setupCallbacks() {
     // 设置电机回调
     if (motor) {
         motor->setStatusCallback([this](MotorStatus status) {
+            // 台架静止时学习温度漂移
+            if (sensor) {
+                sensor->setCompensationLearning(status == MotorStatus::IDLE);
+            }
             if (motorCallback) {
                 motorCallback(static_cast<int>(status));
             }
@@ -737,11 +863,20 @@ void ApplicationController::Impl::setupCallbacks() {
                 errorCallback(error.message);
             }
         });
+        
+        if (sensor) {
+            sensor->setCompensationLearning(motor->getStatus() == MotorStatus::IDLE);
+        }
     }
     
     // 设置传感器回调
     if (sensor) {
+        int intervalMs = std::max(sensor->getUpdateInterval(), 1);
+        spectrogram = std::make_shared<StreamingSpectrogram>(1000.0 / intervalMs);
+        
         sensor->setDataCallback([this](const SensorData& data) {
+            spectrogram->pushSensorData(data);
+            
             std::lock_guard<std::mutex> lock(stateMutex);
             lastSensorData = data;
             
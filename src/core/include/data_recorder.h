@@ -13,13 +13,16 @@
 #include <ctime>
 #include "../../models/include/measurement_data.h"
 #include "../../models/include/data_statistics.h"
+#include "../../models/include/dataset_version.h"
+#include "../../models/include/measurement_source.h"
+#include "sensor_quantiles.h"
 
-class DataRecorder {
+class DataRecorder : public MeasurementSource {
 public:
 
     DataRecorder();
     
-    ~DataRecorder();
+    ~DataRecorder() override;
     
     using DataChangeCallback = std::function<void(int recordCount)>;
     using ExportProgressCallback = std::function<void(int current, int total)>;
@@ -33,6 +36,18 @@ public:
     int getRecordCount() const;
     MeasurementData getLatestMeasurement() const;
     std::vector<MeasurementData> getAllMeasurements() const;
+    
+    // 版本信息：追加记录时size增加，超出上限淘汰首部记录时evicted增加，其他修改使epoch递增
+    DatasetVersion getVersion() const;
+    // 返回since之后追加且仍保留的记录；当前版本不能由since经追加和淘汰得到时返回全部记录。
+    // current输出对应的版本
+    std::vector<MeasurementData> getMeasurementsSince(const DatasetVersion& since,
+                                                      DatasetVersion& current) const;
+    
+    // 分块遍历（MeasurementSource）：遍历开始时的记录，每块在锁内复制，回调在锁外执行；
+    // 遍历期间淘汰首部记录不影响遍历；未读记录已被淘汰或发生其他修改时提前结束并返回false
+    size_t size() const override;
+    bool forEachChunk(const ChunkVisitor& visitor) const override;
     std::vector<MeasurementData> getMeasurementsInTimeRange(
         const std::chrono::system_clock::time_point& start,
         const std::chrono::system_clock::time_point& end) const;
@@ -72,6 +87,13 @@ public:
     // 统计信息
     DataStatistics getStatistics() const;
     
+    // 分位数草图：覆盖自上次clear以来记录的全部数据（包括已被淘汰或压缩掉的记录），
+    // 其他会话或数据块的草图可合并进来，历史查询无需回读原始数据
+    double getQuantile(SensorChannel channel, double q) const;
+    QuantileSketch getQuantileSketch(SensorChannel channel) const;
+    SensorQuantiles getQuantiles() const;
+    void mergeQuantiles(const SensorQuantiles& other);
+    
     // 回调设置
     void setDataChangeCallback(DataChangeCallback callback);
     void setExportProgressCallback(ExportProgressCallback callback);
@@ -104,6 +126,11 @@ private:
     mutable std::mutex mutex;
     std::deque<MeasurementData> measurements;
     
+    // 版本
+    const uint64_t datasetId;
+    uint64_t epoch{0};
+    size_t evicted{0};      // 本epoch内从首部淘汰的记录数
+    
     // 限制参数
     std::atomic<size_t> maxRecords{10000};
     std::atomic<size_t> memoryLimit{100 * 1024 * 1024}; // 100MB默认
@@ -127,6 +154,7 @@ private:
     // 统计缓存
     mutable DataStatistics cachedStatistics;
     mutable bool statisticsValid{false};
+    SensorQuantiles quantiles;
     
     // 内存使用估算
     mutable std::atomic<size_t> estimatedMemoryUsage{0};
@@ -10,6 +10,8 @@
 #include <deque>
 #include <chrono>
 #include "../../models/include/sensor_data.h"
+#include "sensor_quantiles.h"
+#include "temperature_compensator.h"
 
 // 前向声明
 class SerialInterface;
@@ -54,6 +56,21 @@ public:
     std::vector<SensorData> getDataHistory() const;
     SensorData getAverageData(size_t count) const; // 获取最近n个数据的平均值
     
+    // 分位数（覆盖自上次reset以来的全部读数，不受历史长度限制）
+    double getQuantile(SensorChannel channel, double q) const;
+    QuantileSketch getQuantileSketch(SensorChannel channel) const;
+    SensorQuantiles getQuantiles() const;
+    
+    // 温度补偿：空闲期间学习，读数在进入历史、回调和记录之前补偿
+    void setTemperatureCompensationEnabled(bool enable);
+    bool isTemperatureCompensationEnabled() const { return compensationEnabled; }
+    void setCompensationLearning(bool idle);   // 台架静止时为true，每次由false变为true开始新的空闲期
+    bool isCompensationLearning() const { return compensationLearning; }
+    ChannelCompensation getTemperatureCompensation(SensorChannel channel) const;
+    TemperatureCompensator getTemperatureCompensator() const;
+    bool saveTemperatureCompensation(const std::string& filename) const;
+    bool loadTemperatureCompensation(const std::string& filename);
+    
     // 配置方法
     void setUpdateInterval(int intervalMs);
     int getUpdateInterval() const { return updateInterval; }
@@ -86,6 +103,7 @@ private:
     void updateThread();           // 更新线程函数
     bool performRead();            // 执行读取操作
     void processNewData(const SensorData& data);
+    SensorData compensate(const SensorData& raw);   // 需持有mutex
     bool isDataValid(const SensorData& data) const;
     bool shouldFilterData(const SensorData& newData) const;
     void updateStatistics(bool success, int64_t readTime);
@@ -107,6 +125,10 @@ private:
     SensorData latestData;
     std::deque<SensorData> dataHistory;
     bool hasData{false};
+    SensorQuantiles quantiles;
+    TemperatureCompensator compensator;
+    std::atomic<bool> compensationEnabled{true};
+    std::atomic<bool> compensationLearning{false};
     
     // 配置参数
     std::atomic<int> updateInterval{2000};  // 默认2秒
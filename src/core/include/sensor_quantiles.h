@@ -0,0 +1,32 @@
+#ifndef SENSOR_QUANTILES_H
+#define SENSOR_QUANTILES_H
+
+#include <array>
+#include "../../models/include/sensor_data.h"
+#include "../../utils/include/quantile_sketch.h"
+
+/**
+ * @brief 按传感器通道维护的分位数草图
+ *
+ * 每个通道一个 QuantileSketch，只收录有效标志为真的读数。
+ * 本类不加锁，由所属的 SensorManager / DataRecorder 在自身互斥锁内调用。
+ */
+class SensorQuantiles {
+public:
+    static constexpr size_t kChannelCount = static_cast<size_t>(SensorChannel::COUNT);
+
+    explicit SensorQuantiles(double compression = 100.0);
+
+    void add(const SensorData& data);
+    void merge(const SensorQuantiles& other);
+    void reset();
+
+    double quantile(SensorChannel channel, double q) const;
+    const QuantileSketch& sketch(SensorChannel channel) const;
+    QuantileSketch& sketch(SensorChannel channel);
+
+private:
+    std::array<QuantileSketch, kChannelCount> sketches;
+};
+
+#endif // SENSOR_QUANTILES_H
@@ -0,0 +1,101 @@
+#ifndef TEMPERATURE_COMPENSATOR_H
+#define TEMPERATURE_COMPENSATOR_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include "../../models/include/sensor_data.h"
+
+/**
+ * @brief 温度补偿选项
+ */
+struct CompensationOptions {
+    double forgettingFactor = 0.999;    // 遗忘因子λ，有效记忆约 1/(1-λ) 个样本
+    size_t minSamples = 30;             // 判定可信所需的最少学习样本数
+    double minTemperatureSpan = 0.5;    // °C，学习期间温度变化不足时系数不可辨识
+    double maxRelativeError = 0.3;      // 系数标准误差与系数之比的上限
+};
+
+/**
+ * @brief 单个通道的温度系数
+ */
+struct ChannelCompensation {
+    double coefficient = 0.0;       // 每°C的漂移（通道单位/°C）
+    double standardError = 0.0;     // 系数的标准误差
+    double residualStd = 0.0;       // 模型残差的标准差（通道单位）
+    size_t samples = 0;
+    double temperatureSpan = 0.0;   // 学习样本覆盖的温度范围(°C)
+    bool confident = false;         // 可信时才参与补偿
+};
+
+/**
+ * @brief 在线学习的温度漂移补偿
+ *
+ * 每个距离通道和电容通道一个模型 y = a + b·(T − T_ref)，用带遗忘因子的递推最小二乘
+ * 在空闲期间（台架静止、读数只受漂移影响）学习，每个样本的代价为常数。
+ * 每个空闲期开始时重置截距a的协方差：不同位置的读数截距不同，温度系数b则在各空闲期间累积。
+ * 补偿值为 y − b·(T − T_ref)，只对可信的通道生效。
+ *
+ * 本类不加锁，由所属的 SensorManager 在自身互斥锁内调用。
+ */
+class TemperatureCompensator {
+public:
+    static constexpr size_t kChannelCount = static_cast<size_t>(SensorChannel::COUNT);
+
+    explicit TemperatureCompensator(const CompensationOptions& options = CompensationOptions());
+
+    void setOptions(const CompensationOptions& options) { this->options = options; }
+    const CompensationOptions& getOptions() const { return options; }
+
+    /**
+     * @brief 开始新的空闲期（截距重新学习）
+     */
+    void beginIdlePeriod();
+
+    /**
+     * @brief 用一条原始读数更新各通道模型；温度无效时忽略
+     */
+    void learn(const SensorData& raw);
+
+    /**
+     * @brief 返回补偿后的读数（温度与无效通道保持原值）
+     */
+    SensorData apply(const SensorData& raw) const;
+    double correct(SensorChannel channel, double value, double temperature) const;
+
+    static bool isCompensated(SensorChannel channel);
+    ChannelCompensation getCompensation(SensorChannel channel) const;
+    double getReferenceTemperature() const { return referenceTemperature; }
+    bool hasReferenceTemperature() const { return hasReference; }
+
+    void reset();
+
+    // 持久化（JSON），跨会话保留学习结果
+    bool saveToFile(const std::string& filename) const;
+    bool loadFromFile(const std::string& filename);
+
+private:
+    struct ChannelState {
+        double offset = 0.0;
+        double coefficient = 0.0;
+        double p00 = 0.0;            // 参数协方差（未乘残差方差）
+        double p01 = 0.0;
+        double p11 = 0.0;
+        double residualVariance = 0.0;
+        size_t samples = 0;
+        double minTemperature = 0.0;
+        double maxTemperature = 0.0;
+        bool newPeriod = true;
+    };
+
+    void resetChannel(ChannelState& state) const;
+    void update(ChannelState& state, double x, double y) const;
+    ChannelCompensation summarize(const ChannelState& state) const;
+
+    CompensationOptions options;
+    std::array<ChannelState, kChannelCount> channels;
+    double referenceTemperature = 0.0;
+    bool hasReference = false;
+};
+
+#endif // TEMPERATURE_COMPENSATOR_H
@@ -1,14 +1,20 @@
 #include "../include/data_recorder.h"
 #include <mutex>
-#include "../../models/include/system_config.h"
+#include "../../models/include/csv_measurement_source.h"
 #include "../../utils/include/logger.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
 #include <ctime>
+#include <cstdlib>
 
-DataRecorder::DataRecorder() {
+namespace {
+std::atomic<uint64_t> nextDatasetId{1};
+}
+
+DataRecorder::DataRecorder()
+    : datasetId(nextDatasetId++) {
     LOG_INFO("DataRecorder initialized");
 }
 
@@ -36,8 +42,9 @@ void DataRecorder::recordMeasurement(const MeasurementData& measurement) {
         }
         
         measurements.push_back(measurement);
+        quantiles.add(measurement.getSensorData());
         estimatedMemoryUsage += estimateRecordSize(measurement);
-        statisticsValid = false;
+        updateStatistics(measurement);
         
         // 执行限制检查
         enforceMaxRecords();
@@ -72,6 +79,61 @@ std::vector<MeasurementData> DataRecorder::getAllMeasurements() const {
     return std::vector<MeasurementData>(measurements.begin(), measurements.end());
 }
 
+DatasetVersion DataRecorder::getVersion() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return DatasetVersion{datasetId, epoch, evicted, measurements.size()};
+}
+
+std::vector<MeasurementData> DataRecorder::getMeasurementsSince(const DatasetVersion& since,
+                                                                DatasetVersion& current) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    current = DatasetVersion{datasetId, epoch, evicted, measurements.size()};
+    size_t first = 0;
+    if (since.precedes(current) && since.appended() > evicted) {
+        first = since.appended() - evicted;
+    }
+    return std::vector<MeasurementData>(measurements.begin() + first, measurements.end());
+}
+
+size_t DataRecorder::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return measurements.size();
+}
+
+bool DataRecorder::forEachChunk(const ChunkVisitor& visitor) const {
+    constexpr size_t chunkSize = 4096;
+    uint64_t startEpoch = 0;
+    size_t next = 0;    // 下一条要读取的记录的绝对序号
+    size_t end = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        startEpoch = epoch;
+        next = evicted;
+        end = evicted + measurements.size();
+    }
+    
+    std::vector<MeasurementData> buffer;
+    buffer.reserve(std::min(chunkSize, end - next));
+    while (next < end) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // 首部淘汰不影响尚未读取的记录；只有未读记录已被淘汰或发生其他修改时才无法继续
+            if (epoch != startEpoch || next < evicted) {
+                LOG_WARNING("Measurements changed during chunked read, iteration stopped");
+                return false;
+            }
+            size_t begin = next - evicted;
+            size_t count = std::min(chunkSize, end - next);
+            buffer.assign(measurements.begin() + begin, measurements.begin() + begin + count);
+        }
+        next += buffer.size();
+        if (!visitor(buffer.data(), buffer.size())) {
+            break;
+        }
+    }
+    return true;
+}
+
 std::vector<MeasurementData> DataRecorder::getMeasurementsInTimeRange(
     const std::chrono::system_clock::time_point& start,
     const std::chrono::system_clock::time_point& end) const {
@@ -108,8 +170,11 @@ void DataRecorder::clear() {
     {
         std::lock_guard<std::mutex> lock(mutex);
         measurements.clear();
+        quantiles.reset();
         estimatedMemoryUsage = 0;
         statisticsValid = false;
+        ++epoch;
+        evicted = 0;
     }
     
     notifyDataChange();
@@ -133,12 +198,6 @@ size_t DataRecorder::getEstimatedMemoryUsage() const {
 }
 
 bool DataRecorder::exportToCSV(const std::string& filename) const {
-    std::vector<MeasurementData> dataCopy;
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        dataCopy.assign(measurements.begin(), measurements.end());
-    }
-    
     std::ofstream file(filename);
     if (!file.is_open()) {
         LOG_ERROR("Failed to open file for export: " + filename);
@@ -146,42 +205,67 @@ bool DataRecorder::exportToCSV(const std::string& filename) const {
     }
     
     file << MeasurementData::getCSVHeader() << "\n";
-    int total = static_cast<int>(dataCopy.size());
-    for (int i = 0; i < total; ++i) {
-        file << dataCopy[i].toCSV() << "\n";
-        notifyExportProgress(i+1, total);
-    }
+    
+    // 分块遍历，每次只复制一块记录
+    const int total = static_cast<int>(size());
+    int current = 0;
+    std::string block;
+    bool complete = forEachChunk([&](const MeasurementData* rows, size_t count) {
+        block.clear();
+        for (size_t i = 0; i < count; ++i) {
+            block += rows[i].toCSV();
+            block += '\n';
+        }
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        current += static_cast<int>(count);
+        notifyExportProgress(std::min(current, total), total);
+        return static_cast<bool>(file);
+    });
     
     file.close();
-    LOG_INFO_F("Exported %d measurements to %s", total, filename.c_str());
+    if (!file) {
+        LOG_ERROR("Failed to write export file: " + filename);
+        return false;
+    }
+    // 读到的记录少于开始时的记录数，说明遍历中途停止
+    if (!complete || current < total) {
+        LOG_ERROR_F("Export to %s incomplete: measurements changed after %d of %d records",
+                    filename.c_str(), current, total);
+        return false;
+    }
+    LOG_INFO_F("Exported %d measurements to %s", current, filename.c_str());
     return true;
 }
 
 bool DataRecorder::importFromCSV(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    CsvMeasurementSource source(filename);
+    if (!source.isOpen()) {
         LOG_ERROR("Failed to open file for import: " + filename);
         return false;
     }
     
     clear();
     
-    std::string line;
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        
-        SensorData sensorData;
-        MeasurementData measurement(0.0, 0.0, sensorData);
-        
-        if (measurement.isValid()) {
-            recordMeasurement(measurement);
+    size_t imported = 0;
+    size_t skipped = 0;
+    bool complete = source.forEachChunk([&](const MeasurementData* rows, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (rows[i].isValid()) {
+                recordMeasurement(rows[i]);
+                ++imported;
+            } else {
+                ++skipped;
+            }
         }
+        return true;
+    });
+    skipped += source.getSkippedRows();
+    if (!complete) {
+        LOG_ERROR_F("Failed to read %s after %zu measurements", filename.c_str(), imported);
+        return false;
     }
     
-    file.close();
-    LOG_INFO_F("Imported measurements from %s", filename.c_str());
+    LOG_INFO_F("Imported %zu measurements from %s (%zu rows skipped)", imported, filename.c_str(), skipped);
     return true;
 }
 
@@ -239,6 +323,11 @@ void DataRecorder::compressData() {
     
     size_t removed = measurements.size() - compressed.size();
     measurements = std::move(compressed);
+    if (removed > 0) {
+        statisticsValid = false;
+        ++epoch;
+        evicted = 0;
+    }
     
     LOG_INFO_F("Data compression removed %zu similar records", removed);
 }
@@ -297,6 +386,26 @@ DataStatistics DataRecorder::getStatistics() const {
     return stats;
 }
 
+double DataRecorder::getQuantile(SensorChannel channel, double q) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles.quantile(channel, q);
+}
+
+QuantileSketch DataRecorder::getQuantileSketch(SensorChannel channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles.sketch(channel);
+}
+
+SensorQuantiles DataRecorder::getQuantiles() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles;
+}
+
+void DataRecorder::mergeQuantiles(const SensorQuantiles& other) {
+    std::lock_guard<std::mutex> lock(mutex);
+    quantiles.merge(other);
+}
+
 void DataRecorder::setDataChangeCallback(DataChangeCallback callback) {
     std::lock_guard<std::mutex> lock(mutex);
     dataChangeCallback = std::move(callback);
@@ -334,6 +443,7 @@ void DataRecorder::enforceMaxRecords() {
         estimatedMemoryUsage -= estimateRecordSize(measurements.front());
         measurements.pop_front();
         statisticsValid = false;
+        ++evicted;
     }
 }
 
@@ -342,9 +452,35 @@ void DataRecorder::enforceMemoryLimit() {
         estimatedMemoryUsage -= estimateRecordSize(measurements.front());
         measurements.pop_front();
         statisticsValid = false;
+        ++evicted;
     }
 }
 
+void DataRecorder::updateStatistics(const MeasurementData& measurement) {
+    // 追加记录时增量更新缓存的统计量，无需重新遍历全部记录
+    if (!statisticsValid || cachedStatistics.dataCount <= 0) {
+        statisticsValid = false;
+        return;
+    }
+    
+    DataStatistics& stats = cachedStatistics;
+    double height = measurement.getSetHeight();
+    double angle = measurement.getSetAngle();
+    double cap = measurement.getTheoreticalCapacitance();
+    double n = static_cast<double>(++stats.dataCount);
+    
+    stats.meanHeight += (height - stats.meanHeight) / n;
+    stats.meanAngle += (angle - stats.meanAngle) / n;
+    stats.meanCapacitance += (cap - stats.meanCapacitance) / n;
+    stats.minHeight = std::min(stats.minHeight, height);
+    stats.maxHeight = std::max(stats.maxHeight, height);
+    stats.minAngle = std::min(stats.minAngle, angle);
+    stats.maxAngle = std::max(stats.maxAngle, angle);
+    stats.minCapacitance = std::min(stats.minCapacitance, cap);
+    stats.maxCapacitance = std::max(stats.maxCapacitance, cap);
+    stats.lastRecordTime = measurement.getTimestamp();
+}
+
 void DataRecorder::autoSaveThreadFunction() {
     LOG_INFO("Auto-save thread started");
     
@@ -139,6 +139,64 @@ SensorData SensorManager::getAverageData(size_t count) const {
     return avgData;
 }
 
+double SensorManager::getQuantile(SensorChannel channel, double q) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles.quantile(channel, q);
+}
+
+QuantileSketch SensorManager::getQuantileSketch(SensorChannel channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles.sketch(channel);
+}
+
+SensorQuantiles SensorManager::getQuantiles() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quantiles;
+}
+
+void SensorManager::setTemperatureCompensationEnabled(bool enable) {
+    compensationEnabled = enable;
+    LOG_INFO(std::string("Temperature compensation ") + (enable ? "enabled" : "disabled"));
+}
+
+void SensorManager::setCompensationLearning(bool idle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idle && !compensationLearning) {
+        compensator.beginIdlePeriod();
+    }
+    compensationLearning = idle;
+}
+
+ChannelCompensation SensorManager::getTemperatureCompensation(SensorChannel channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compensator.getCompensation(channel);
+}
+
+TemperatureCompensator SensorManager::getTemperatureCompensator() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compensator;
+}
+
+bool SensorManager::saveTemperatureCompensation(const std::string& filename) const {
+    TemperatureCompensator snapshot = getTemperatureCompensator();
+    return snapshot.saveToFile(filename);
+}
+
+bool SensorManager::loadTemperatureCompensation(const std::string& filename) {
+    TemperatureCompensator loaded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        loaded.setOptions(compensator.getOptions());
+    }
+    if (!loaded.loadFromFile(filename)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    compensator = loaded;
+    LOG_INFO("Temperature compensation loaded from " + filename);
+    return true;
+}
+
 void SensorManager::setUpdateInterval(int intervalMs) {
     updateInterval = intervalMs;
     cv.notify_all(); // 通知线程更新间隔已改变
@@ -193,6 +251,8 @@ void SensorManager::reset() {
     hasData = false;
     latestData = SensorData();
     dataHistory.clear();
+    quantiles.reset();
+    compensator.beginIdlePeriod();
     statistics = SensorStatistics();
     
     LOG_INFO("SensorManager reset");
@@ -280,13 +340,24 @@ bool SensorManager::performRead() {
     }
 }
 
-void SensorManager::processNewData(const SensorData& data) {
+SensorData SensorManager::compensate(const SensorData& raw) {
+    // 学习使用原始读数，补偿只作用于输出
+    if (compensationLearning) {
+        compensator.learn(raw);
+    }
+    return compensationEnabled ? compensator.apply(raw) : raw;
+}
+
+void SensorManager::processNewData(const SensorData& raw) {
     DataCallback cb;
+    SensorData data;
     {
       std::lock_guard<std::mutex> lock(mutex);
+      data = compensate(raw);
       latestData = data;
       hasData = true;
       dataHistory.push_back(data);
+      quantiles.add(data);
       while (dataHistory.size() > maxHistorySize) {
           dataHistory.pop_front();
       }
@@ -358,12 +429,14 @@ void SensorManager::notifyError(const std::string& error) {
     }
 }
 
-void SensorManager::updateLatestData(const SensorData& data) {
+void SensorManager::updateLatestData(const SensorData& raw) {
     std::lock_guard<std::mutex> lock(mutex);
+    SensorData data = compensate(raw);
     latestData = data;
     hasData = true;
     
     dataHistory.push_back(data);
+    quantiles.add(data);
     while (dataHistory.size() > maxHistorySize) {
         dataHistory.pop_front();
     }
@@ -0,0 +1,38 @@
+#include "../include/sensor_quantiles.h"
+
+SensorQuantiles::SensorQuantiles(double compression) {
+    sketches.fill(QuantileSketch(compression));
+}
+
+void SensorQuantiles::add(const SensorData& data) {
+    for (size_t i = 0; i < kChannelCount; ++i) {
+        auto channel = static_cast<SensorChannel>(i);
+        if (data.isChannelValid(channel)) {
+            sketches[i].add(data.getChannelValue(channel));
+        }
+    }
+}
+
+void SensorQuantiles::merge(const SensorQuantiles& other) {
+    for (size_t i = 0; i < kChannelCount; ++i) {
+        sketches[i].merge(other.sketches[i]);
+    }
+}
+
+void SensorQuantiles::reset() {
+    for (auto& sketch : sketches) {
+        sketch.reset();
+    }
+}
+
+double SensorQuantiles::quantile(SensorChannel channel, double q) const {
+    return sketch(channel).quantile(q);
+}
+
+const QuantileSketch& SensorQuantiles::sketch(SensorChannel channel) const {
+    return sketches[static_cast<size_t>(channel)];
+}
+
+QuantileSketch& SensorQuantiles::sketch(SensorChannel channel) {
+    return sketches[static_cast<size_t>(channel)];
+}
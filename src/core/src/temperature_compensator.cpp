@@ -0,0 +1,270 @@
+#include "../include/temperature_compensator.h"
+#include "../../utils/include/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <regex>
+#include <sstream>
+
+namespace {
+
+// 截距与系数的先验方差：截距在每个空闲期由第一个样本确定，系数初值为0
+constexpr double kOffsetPrior = 1e8;
+constexpr double kCoefficientPrior = 1e4;
+
+constexpr SensorChannel kCompensatedChannels[] = {
+    SensorChannel::DISTANCE_UPPER_1,
+    SensorChannel::DISTANCE_UPPER_2,
+    SensorChannel::DISTANCE_LOWER_1,
+    SensorChannel::DISTANCE_LOWER_2,
+    SensorChannel::CAPACITANCE,
+};
+
+const char* channelKey(SensorChannel channel) {
+    switch (channel) {
+        case SensorChannel::DISTANCE_UPPER_1: return "distanceUpper1";
+        case SensorChannel::DISTANCE_UPPER_2: return "distanceUpper2";
+        case SensorChannel::DISTANCE_LOWER_1: return "distanceLower1";
+        case SensorChannel::DISTANCE_LOWER_2: return "distanceLower2";
+        case SensorChannel::CAPACITANCE:      return "capacitance";
+        default:                              return "";
+    }
+}
+
+bool readNumber(const std::string& text, const std::string& key, double& value) {
+    std::regex pattern("\"" + key + R"("\s*:\s*([-+0-9.eE]+))");
+    std::smatch match;
+    if (!std::regex_search(text, match, pattern)) {
+        return false;
+    }
+    value = std::stod(match[1]);
+    return true;
+}
+
+} // namespace
+
+TemperatureCompensator::TemperatureCompensator(const CompensationOptions& options)
+    : options(options) {
+    reset();
+}
+
+bool TemperatureCompensator::isCompensated(SensorChannel channel) {
+    return std::find(std::begin(kCompensatedChannels), std::end(kCompensatedChannels), channel) !=
+           std::end(kCompensatedChannels);
+}
+
+void TemperatureCompensator::resetChannel(ChannelState& state) const {
+    state = ChannelState();
+    state.p00 = kOffsetPrior;
+    state.p11 = kCoefficientPrior;
+}
+
+void TemperatureCompensator::reset() {
+    for (auto& state : channels) {
+        resetChannel(state);
+    }
+    referenceTemperature = 0.0;
+    hasReference = false;
+}
+
+void TemperatureCompensator::beginIdlePeriod() {
+    for (auto& state : channels) {
+        state.newPeriod = true;
+    }
+}
+
+void TemperatureCompensator::update(ChannelState& state, double x, double y) const {
+    const double lambda = options.forgettingFactor;
+
+    if (state.newPeriod) {
+        // 截距与系数不再相关，截距重新由数据确定
+        state.p00 = kOffsetPrior;
+        state.p01 = 0.0;
+        state.newPeriod = false;
+    }
+
+    // 回归向量 φ = [1, x]
+    double g0 = state.p00 + state.p01 * x;
+    double g1 = state.p01 + state.p11 * x;
+    double denominator = lambda + g0 + g1 * x;
+    double k0 = g0 / denominator;
+    double k1 = g1 / denominator;
+
+    double error = y - (state.offset + state.coefficient * x);
+    state.offset += k0 * error;
+    state.coefficient += k1 * error;
+
+    state.p00 = (state.p00 - k0 * g0) / lambda;
+    state.p01 = (state.p01 - k0 * g1) / lambda;
+    // 温度不变时系数没有新信息，限制协方差增长（防止遗忘导致的协方差发散）
+    state.p11 = std::min((state.p11 - k1 * g1) / lambda, kCoefficientPrior);
+
+    // 后验误差的指数加权方差；空闲期第一个样本的后验误差接近0，不受截距跳变影响
+    double posterior = error * lambda / denominator;
+    double weight = std::max(1.0 - lambda, 1.0 / static_cast<double>(state.samples + 1));
+    state.residualVariance += weight * (posterior * posterior - state.residualVariance);
+
+    state.samples++;
+    double temperature = x + referenceTemperature;
+    if (state.samples == 1) {
+        state.minTemperature = temperature;
+        state.maxTemperature = temperature;
+    } else {
+        state.minTemperature = std::min(state.minTemperature, temperature);
+        state.maxTemperature = std::max(state.maxTemperature, temperature);
+    }
+}
+
+void TemperatureCompensator::learn(const SensorData& raw) {
+    if (!raw.isValid.temperature || !std::isfinite(raw.temperature)) {
+        return;
+    }
+    if (!hasReference) {
+        referenceTemperature = raw.temperature;
+        hasReference = true;
+    }
+
+    const double x = raw.temperature - referenceTemperature;
+    for (SensorChannel channel : kCompensatedChannels) {
+        if (raw.isChannelValid(channel)) {
+            double y = raw.getChannelValue(channel);
+            if (std::isfinite(y)) {
+                update(channels[static_cast<size_t>(channel)], x, y);
+            }
+        }
+    }
+}
+
+ChannelCompensation TemperatureCompensator::summarize(const ChannelState& state) const {
+    ChannelCompensation result;
+    result.coefficient = state.coefficient;
+    result.samples = state.samples;
+    result.residualStd = std::sqrt(std::max(state.residualVariance, 0.0));
+    result.standardError = std::sqrt(std::max(state.residualVariance * state.p11, 0.0));
+    result.temperatureSpan = state.samples > 0 ? state.maxTemperature - state.minTemperature : 0.0;
+    result.confident = state.samples >= options.minSamples &&
+                       result.temperatureSpan >= options.minTemperatureSpan &&
+                       result.standardError <= options.maxRelativeError * std::abs(state.coefficient);
+    return result;
+}
+
+ChannelCompensation TemperatureCompensator::getCompensation(SensorChannel channel) const {
+    if (!isCompensated(channel)) {
+        return ChannelCompensation();
+    }
+    return summarize(channels[static_cast<size_t>(channel)]);
+}
+
+double TemperatureCompensator::correct(SensorChannel channel, double value, double temperature) const {
+    if (!hasReference || !isCompensated(channel)) {
+        return value;
+    }
+    const ChannelState& state = channels[static_cast<size_t>(channel)];
+    if (!summarize(state).confident) {
+        return value;
+    }
+    return value - state.coefficient * (temperature - referenceTemperature);
+}
+
+SensorData TemperatureCompensator::apply(const SensorData& raw) const {
+    SensorData corrected = raw;
+    if (!hasReference || !raw.isValid.temperature || !std::isfinite(raw.temperature)) {
+        return corrected;
+    }
+    for (SensorChannel channel : kCompensatedChannels) {
+        if (raw.isChannelValid(channel)) {
+            corrected.setChannelValue(channel, correct(channel, raw.getChannelValue(channel), raw.temperature));
+        }
+    }
+    return corrected;
+}
+
+bool TemperatureCompensator::saveToFile(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot save temperature compensation: " + filename);
+        return false;
+    }
+
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "{\n";
+    file << "    \"hasReference\": " << (hasReference ? 1 : 0) << ",\n";
+    file << "    \"referenceTemperature\": " << referenceTemperature << ",\n";
+    file << "    \"channels\": {\n";
+    const size_t count = std::size(kCompensatedChannels);
+    for (size_t i = 0; i < count; ++i) {
+        SensorChannel channel = kCompensatedChannels[i];
+        const ChannelState& state = channels[static_cast<size_t>(channel)];
+        file << "        \"" << channelKey(channel) << "\": {"
+             << "\"offset\": " << state.offset
+             << ", \"coefficient\": " << state.coefficient
+             << ", \"p00\": " << state.p00
+             << ", \"p01\": " << state.p01
+             << ", \"p11\": " << state.p11
+             << ", \"residualVariance\": " << state.residualVariance
+             << ", \"samples\": " << state.samples
+             << ", \"minTemperature\": " << state.minTemperature
+             << ", \"maxTemperature\": " << state.maxTemperature
+             << "}" << (i + 1 < count ? "," : "") << "\n";
+    }
+    file << "    }\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+bool TemperatureCompensator::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    try {
+        double flag = 0.0;
+        double reference = 0.0;
+        if (!readNumber(content, "hasReference", flag) || !readNumber(content, "referenceTemperature", reference)) {
+            LOG_ERROR("Invalid temperature compensation file: " + filename);
+            return false;
+        }
+
+        std::array<ChannelState, kChannelCount> loaded = channels;
+        for (SensorChannel channel : kCompensatedChannels) {
+            ChannelState& state = loaded[static_cast<size_t>(channel)];
+            resetChannel(state);
+
+            std::regex blockPattern("\"" + std::string(channelKey(channel)) + R"("\s*:\s*\{([^}]*)\})");
+            std::smatch block;
+            if (!std::regex_search(content, block, blockPattern)) {
+                continue;
+            }
+            std::string text = block[1];
+            double samples = 0.0;
+            bool ok = readNumber(text, "offset", state.offset) &&
+                      readNumber(text, "coefficient", state.coefficient) &&
+                      readNumber(text, "p00", state.p00) &&
+                      readNumber(text, "p01", state.p01) &&
+                      readNumber(text, "p11", state.p11) &&
+                      readNumber(text, "residualVariance", state.residualVariance) &&
+                      readNumber(text, "samples", samples) &&
+                      readNumber(text, "minTemperature", state.minTemperature) &&
+                      readNumber(text, "maxTemperature", state.maxTemperature);
+            if (!ok) {
+                LOG_ERROR("Invalid temperature compensation entry: " + std::string(channelKey(channel)));
+                return false;
+            }
+            state.samples = static_cast<size_t>(samples);
+            state.newPeriod = true;   // 新会话中的位置未知，截距重新学习
+        }
+
+        channels = loaded;
+        hasReference = flag != 0.0;
+        referenceTemperature = reference;
+    } catch (const std::exception& e) {
+        LOG_ERROR(std::string("Failed to parse temperature compensation: ") + e.what());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef ANALYSIS_CACHE_H
+#define ANALYSIS_CACHE_H
+
+#include <any>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "data_processor.h"
+#include "../../models/include/dataset_version.h"
+#include "../../utils/include/sliding_median.h"
+
+/**
+ * @brief 版本化的分析结果缓存
+ *
+ * - 通用结果按 (数据集, 版本, 操作, 参数) 缓存，数据未变化时直接返回，按LRU淘汰
+ * - 统计量和线性回归按记录块保存矩累加器：末尾追加的记录并入最后的块，首部淘汰时丢弃整块、
+ *   只重算部分淘汰的首块，再合并各块的矩；记录数达到上限后持续滚动也不需要从头计算。
+ *   epoch变化（清空、压缩、导入）时从头计算
+ *
+ * 记录通过 DeltaSource 按需获取（如 DataRecorder::getMeasurementsSince），
+ * 版本未变化时不会调用。线程安全。
+ */
+class AnalysisCache {
+public:
+    using DeltaSource = std::function<std::vector<MeasurementData>(const DatasetVersion& since,
+                                                                   DatasetVersion& current)>;
+
+    explicit AnalysisCache(size_t capacity = 32);
+
+    /**
+     * @brief 增量统计（与 DataProcessor::calculateStatistics 结果一致）
+     */
+    DataStatistics statistics(const DataProcessor& processor, const DatasetVersion& version,
+                              const DeltaSource& source);
+
+    /**
+     * @brief 增量线性回归（斜率、截距、R²和标准误差由矩得到，不含逐点残差）
+     */
+    LinearRegression regression(const DataProcessor& processor, const DatasetVersion& version,
+                                const DeltaSource& source, DataField xField, DataField yField);
+
+    /**
+     * @brief 通用结果缓存：命中时返回缓存值，否则调用compute并缓存
+     */
+    template <typename T>
+    T getOrCompute(const DatasetVersion& version, const std::string& operation,
+                   const std::string& parameters, const std::function<T()>& compute) {
+        Key key{version.datasetId, version.epoch, version.evicted, version.size, operation, parameters};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (const std::any* cached = lookup(key)) {
+                if (const T* value = std::any_cast<T>(cached)) {
+                    ++hits;
+                    return *value;
+                }
+            }
+            ++misses;
+        }
+
+        // 计算不持锁，其他分析可以同时命中缓存
+        T value = compute();
+        std::lock_guard<std::mutex> lock(mutex);
+        store(key, value);
+        return value;
+    }
+
+    void invalidate(uint64_t datasetId);
+    void clear();
+
+    size_t hitCount() const;
+    size_t missCount() const;
+
+private:
+    using Key = std::tuple<uint64_t, uint64_t, size_t, size_t, std::string, std::string>;
+
+    struct Entry {
+        std::any value;
+        std::list<Key>::iterator position;
+    };
+
+    // 一段连续记录的矩；保留各记录的字段值和时间戳，首部被部分淘汰时据此重算
+    struct Block {
+        size_t first = 0;               // 块首记录的绝对序号
+        RunningMoments moments;
+        std::vector<double> values;     // 按行存放，每行为各字段的值
+        std::vector<int64_t> timestamps;
+    };
+
+    // 增量状态：每个 (数据集, 操作) 一份
+    struct IncrementalState {
+        DatasetVersion version;
+        std::deque<Block> blocks;
+        RunningMoments moments;         // 全部块合并后的结果
+        SlidingMedian heightMedian;     // 仅统计使用
+    };
+
+    const std::any* lookup(const Key& key);
+    void store(const Key& key, std::any value);
+    IncrementalState& refresh(const DataProcessor& processor, const DatasetVersion& version,
+                              const DeltaSource& source, const std::string& operation,
+                              const std::vector<DataField>& fields, bool trackMedian);
+    static void evictBefore(IncrementalState& state, size_t first, size_t dims, bool trackMedian);
+    static void append(IncrementalState& state, const MeasurementColumns& columns, size_t first,
+                       const std::vector<MeasurementData>& delta, bool trackMedian);
+
+    size_t capacity;
+    std::map<Key, Entry> entries;
+    std::list<Key> recency;             // 队首为最近使用
+    std::map<std::pair<uint64_t, std::string>, IncrementalState> incremental;
+    size_t hits = 0;
+    size_t misses = 0;
+    mutable std::mutex mutex;
+};
+
+#endif // ANALYSIS_CACHE_H
@@ -0,0 +1,82 @@
+#ifndef ANALYSIS_PIPELINE_H
+#define ANALYSIS_PIPELINE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "data_processor.h"
+#include "../../models/include/measurement_source.h"
+
+/**
+ * @brief 惰性、融合的分析流水线
+ *
+ * 先组合操作，执行终端操作（collect / regress / moments）时才遍历数据源，且只遍历一次：
+ * 每个数据块只提取用到的字段，在块内依次完成筛选和逐元素变换，再把保留下来的行追加到输出列。
+ * 只有被选择的列会被物化，不再产生整条记录的中间副本。
+ *
+ * 各操作按固定阶段执行，与调用顺序无关：筛选（作用于原始字段值）→ 变换 → 平滑 → 终端操作。
+ * 平滑需要相邻样本，在筛选后的列上进行。
+ *
+ * 示例：最近10分钟、角度为0、中值平滑后拟合 C 与 1/h
+ * @code
+ * AnalysisPipeline(recorder, processor)
+ *     .timeRange(now - 600000, now)
+ *     .where(DataField::ANGLE, 0.0, 0.0)
+ *     .map(DataField::HEIGHT, [](double h) { return 1.0 / h; })
+ *     .smooth(DataField::CAPACITANCE, SmoothingMethod::MEDIAN, 5)
+ *     .regress(DataField::HEIGHT, DataField::CAPACITANCE);
+ * @endcode
+ */
+class AnalysisPipeline {
+public:
+    AnalysisPipeline(const MeasurementSource& source, const DataProcessor& processor);
+
+    // 组合操作
+    AnalysisPipeline& select(const std::vector<DataField>& fields);
+    AnalysisPipeline& timeRange(int64_t startMs, int64_t endMs);
+    AnalysisPipeline& where(DataField field, double minValue, double maxValue);
+    AnalysisPipeline& where(std::function<bool(const MeasurementData&)> predicate);
+    AnalysisPipeline& map(DataField field, std::function<double(double)> fn);
+    AnalysisPipeline& smooth(DataField field, SmoothingMethod method, int windowSize,
+                             int polynomialOrder = 2);
+
+    // 终端操作（被取消或数据源未能提供全部记录时返回空结果）
+    MeasurementColumns collect() const;
+    LinearRegression regress(DataField xField, DataField yField) const;
+    RunningMoments moments(const std::vector<DataField>& fields) const;
+
+private:
+    struct RangeFilter {
+        DataField field;
+        double minValue;
+        double maxValue;
+    };
+
+    struct Mapping {
+        DataField field;
+        std::function<double(double)> fn;
+    };
+
+    struct Smoothing {
+        DataField field;
+        SmoothingMethod method;
+        int windowSize;
+        int polynomialOrder;
+    };
+
+    // 遍历一次数据源，对每个块调用sink(columns, count)，columns按outputs顺序、只含保留的行
+    bool run(const std::vector<DataField>& outputs,
+             const std::function<void(const std::vector<const double*>&, size_t)>& sink) const;
+    MeasurementColumns collect(std::vector<DataField> outputs) const;
+    bool needsSmoothing(const std::vector<DataField>& fields) const;
+
+    const MeasurementSource& source;
+    const DataProcessor& processor;
+    std::vector<DataField> selected;
+    std::vector<RangeFilter> ranges;
+    std::vector<std::function<bool(const MeasurementData&)>> predicates;
+    std::vector<Mapping> mappings;
+    std::vector<Smoothing> smoothings;
+};
+
+#endif // ANALYSIS_PIPELINE_H
@@ -0,0 +1,103 @@
+#ifndef CHUNKED_EXPORT_H
+#define CHUNKED_EXPORT_H
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include "../../utils/include/thread_pool.h"
+
+/**
+ * @brief 导出字节流的目标
+ */
+class ByteSink {
+public:
+    virtual ~ByteSink() = default;
+    virtual bool write(const char* data, size_t size) = 0;
+    virtual bool close() = 0;
+    virtual size_t bytesWritten() const = 0;
+};
+
+/**
+ * @brief 写入文件的ByteSink
+ *
+ * 流不使用自身的缓冲区：调用方交来的已经是整块数据，每次write()直接成为一次系统调用。
+ */
+class FileSink : public ByteSink {
+public:
+    FileSink() = default;
+    ~FileSink() override;
+
+    bool open(const std::string& filename);
+    bool isOpen() const { return file.is_open(); }
+
+    bool write(const char* data, size_t size) override;
+    bool close() override;
+    size_t bytesWritten() const override { return written; }
+
+private:
+    std::ofstream file;
+    size_t written = 0;
+};
+
+/**
+ * @brief 分块并行格式化、单线程按序写出
+ *
+ * 数据按块编号，每批若干块在共享线程池上并行格式化到各自的缓冲区（调用线程也参与）；
+ * 格式化好的一批交给写线程，按块序逐块写入ByteSink，同时格式化下一批。
+ * 两组缓冲区轮换使用，容量在各批之间保留，稳定后不再分配内存。
+ */
+class ChunkedExport {
+public:
+    // 把第chunk块追加到out（out已清空，容量保留）
+    using FormatFn = std::function<void(size_t chunk, std::string& out)>;
+    // 第chunk块写出后在写线程中调用
+    using ChunkWrittenFn = std::function<void(size_t chunk)>;
+
+    struct Options {
+        size_t batchChunks = 0;          // 每批块数，0表示线程池线程数+1
+        CancellationToken cancellation;
+    };
+
+    /**
+     * @brief 逐批提交的写出管线（块数事先未知时使用，如流式数据源）
+     *
+     * 构造时启动写线程；submit()并行格式化一批并交给写线程，块编号在各批之间连续；
+     * finish()等待全部写出。析构时未finish则丢弃未写出的批次。
+     */
+    class Writer {
+    public:
+        Writer(ByteSink& sink, ChunkWrittenFn onChunkWritten, const Options& options);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        size_t batchChunks() const { return batchSize; }
+
+        /**
+         * @brief 格式化count（不超过batchChunks()）块，format的chunk参数为批内序号
+         * @return 写入失败、取消或格式化抛出异常后返回false，之后的提交都被忽略
+         */
+        bool submit(size_t count, const FormatFn& format);
+
+        // 等待已提交的批次全部写出并结束写线程；error给出第一个失败原因
+        bool finish(std::string* error = nullptr);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+        size_t batchSize;
+    };
+
+    /**
+     * @brief 格式化并写出 [0, chunkCount) 全部块
+     * @return 全部写出返回true；写入失败、取消或格式化抛出异常时返回false，error给出原因
+     */
+    static bool run(size_t chunkCount, const FormatFn& format, ByteSink& sink,
+                    const ChunkWrittenFn& onChunkWritten, const Options& options,
+                    std::string* error = nullptr);
+};
+
+#endif // CHUNKED_EXPORT_H
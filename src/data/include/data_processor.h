@@ -8,21 +8,10 @@
 #include <complex>
 #include "../../models/include/measurement_data.h"
 #include "../../models/include/data_statistics.h"
-
-/**
- * @brief 数据字段枚举
- */
-enum class DataField {
-    HEIGHT,
-    ANGLE,
-    CAPACITANCE,
-    TEMPERATURE,
-    UPPER_SENSOR_1,
-    UPPER_SENSOR_2,
-    LOWER_SENSOR_1,
-    LOWER_SENSOR_2,
-    TIMESTAMP
-};
+#include "../../models/include/capacitance_calibrator.h"
+#include "field_access.h"
+#include "../../utils/include/running_moments.h"
+#include "../../utils/include/thread_pool.h"
 
 /**
  * @brief 平滑方法枚举
@@ -43,6 +32,14 @@ enum class InterpolationMethod {
     SPLINE
 };
 
+/**
+ * @brief 数值积分方法枚举
+ */
+enum class IntegrationMethod {
+    TRAPEZOID,
+    SIMPSON
+};
+
 /**
  * @brief 归一化方法枚举
  */
@@ -52,6 +49,33 @@ enum class NormalizationMethod {
     DECIMAL_SCALING
 };
 
+/**
+ * @brief 窗函数枚举
+ */
+enum class WindowFunction {
+    RECTANGULAR,
+    HANN,
+    HAMMING,
+    BLACKMAN
+};
+
+/**
+ * @brief 频谱分段平均方式
+ */
+enum class SpectralAveraging {
+    MEAN,
+    MEDIAN
+};
+
+/**
+ * @brief 曲面网格空缺单元的填充方法
+ */
+enum class SurfaceFillMethod {
+    NONE,               // 保持0.0
+    NEAREST,            // 最近的有数据单元
+    INVERSE_DISTANCE    // 反距离加权
+};
+
 /**
  * @brief 趋势方向枚举
  */
@@ -83,6 +107,15 @@ struct PolynomialFit {
     double rmse;
 };
 
+/**
+ * @brief 批量拟合的一组数据（weights为空表示等权）
+ */
+struct PolynomialSeries {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> weights;
+};
+
 /**
  * @brief FFT结果
  */
@@ -94,6 +127,71 @@ struct FFTResult {
     double samplingRate;
 };
 
+/**
+ * @brief Welch功率谱估计参数
+ */
+struct WelchOptions {
+    size_t segmentLength = 256;              // 每段样本数
+    double overlap = 0.5;                    // 相邻段重叠比例 [0, 1)
+    WindowFunction window = WindowFunction::HANN;
+    SpectralAveraging averaging = SpectralAveraging::MEAN;
+    bool removeMean = true;                  // 每段去除直流分量
+};
+
+/**
+ * @brief 功率谱密度结果（单边）
+ */
+struct PowerSpectrum {
+    std::vector<double> frequencies;
+    std::vector<double> density;             // 单位²/Hz
+    double dominantFrequency = 0.0;
+    double samplingRate = 0.0;
+    int segmentCount = 0;
+};
+
+/**
+ * @brief 通道间互相关分析参数
+ */
+struct CrossCorrelationOptions {
+    double samplingRate = 0.0;               // 重采样频率(Hz)，0表示按时间戳估计
+    double maxLagSeconds = 0.0;              // 搜索的最大时滞，0表示不限制
+    bool removeMean = true;                  // 相关前去除各通道均值
+    WelchOptions coherence;                  // 相干函数的分段参数（重叠、窗函数）
+};
+
+/**
+ * @brief 一对通道的时滞估计
+ *
+ * lagSeconds > 0 表示response滞后于reference。
+ */
+struct ChannelLag {
+    DataField reference;
+    DataField response;
+    double lagSamples = 0.0;                 // 经抛物线插值的亚采样时滞
+    double lagSeconds = 0.0;
+    double peakCorrelation = 0.0;            // 归一化互相关峰值 [-1, 1]
+    std::vector<double> coherence;           // 幅值平方相干函数，与frequencies对应
+    double meanCoherence = 0.0;
+};
+
+/**
+ * @brief 多通道互相关结果（每对通道一项，按fields顺序 i < j）
+ */
+struct CrossCorrelationResult {
+    std::vector<DataField> fields;
+    std::vector<ChannelLag> pairs;
+    std::vector<double> frequencies;         // 相干函数频点
+    double samplingRate = 0.0;
+    size_t sampleCount = 0;                  // 重采样后的样本数
+
+    const ChannelLag* find(DataField reference, DataField response) const {
+        for (const auto& pair : pairs) {
+            if (pair.reference == reference && pair.response == response) return &pair;
+        }
+        return nullptr;
+    }
+};
+
 /**
  * @brief 趋势分析结果
  */
@@ -165,6 +263,90 @@ struct ChartData3D {
     std::string title;
 };
 
+/**
+ * @brief K-means聚类选项
+ */
+struct ClusteringOptions {
+    bool normalize = true;                                       // 聚类前对各特征归一化
+    NormalizationMethod normalization = NormalizationMethod::Z_SCORE;
+    int maxIterations = 100;
+    double tolerance = 1e-6;       // 质心最大位移（归一化空间）低于该值视为收敛
+    size_t miniBatchSize = 0;      // 0表示全量Lloyd迭代；>0时使用mini-batch更新
+    unsigned int seed = 42;        // 固定种子，结果可复现
+    int numThreads = 0;            // 0表示使用全部硬件线程
+};
+
+/**
+ * @brief K-means聚类结果
+ */
+struct ClusteringResult {
+    std::vector<int> labels;                     // 每条记录所属的簇
+    std::vector<std::vector<double>> centroids;  // 质心（原始单位，按features顺序）
+    std::vector<size_t> clusterSizes;
+    double inertia = 0.0;                        // 簇内平方和（归一化空间）
+    int iterations = 0;
+};
+
+/**
+ * @brief 列式测量数据
+ *
+ * 每个字段一段连续数组，供多字段批量处理使用，避免逐条访问MeasurementData。
+ */
+struct MeasurementColumns {
+    std::vector<DataField> fields;
+    std::vector<std::vector<double>> values;   // 与fields一一对应
+    size_t rows = 0;
+
+    const std::vector<double>* find(DataField field) const {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i] == field) return &values[i];
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief 相关矩阵
+ */
+struct CorrelationMatrix {
+    std::vector<DataField> fields;
+    std::vector<double> covariance;    // fields.size()²，按行存放
+    std::vector<double> correlation;   // fields.size()²，按行存放
+    size_t sampleCount = 0;
+
+    double at(size_t i, size_t j) const { return correlation[i * fields.size() + j]; }
+};
+
+/**
+ * @brief 3D曲面网格化选项
+ *
+ * 某轴的不同坐标值不超过该轴分辨率时直接使用这些坐标作为网格（规则扫描），
+ * 否则在坐标范围内等分为指定数量的单元，落入同一单元的点取平均。
+ */
+struct SurfaceGridOptions {
+    size_t xResolution = 50;
+    size_t yResolution = 50;
+    SurfaceFillMethod fill = SurfaceFillMethod::INVERSE_DISTANCE;
+    size_t neighbours = 8;      // 反距离加权使用的近邻单元数
+    double power = 2.0;         // 反距离加权指数
+};
+
+/**
+ * @brief 并行执行策略
+ *
+ * 大数据量的统计、回归、异常值检测、Welch谱估计和聚类按chunkSize行分块，
+ * 在共享线程池上并行计算各块的部分结果后按块序合并，结果与线程数无关。
+ * 取消令牌在块边界检查，被取消的调用返回空结果；progress在每块完成后调用（可能来自工作线程）。
+ * 界面线程可通过 ThreadPool::shared().submit() 在后台调用分析方法，避免阻塞事件循环。
+ */
+struct ExecutionPolicy {
+    bool parallel = true;
+    size_t chunkSize = 65536;       // 每块行数
+    int maxThreads = 0;             // 0表示使用线程池全部线程
+    CancellationToken cancellation;
+    std::function<void(size_t completed, size_t total)> progress;
+};
+
 /**
  * @brief 数据处理器类
  * 
@@ -187,22 +369,56 @@ class DataProcessor {
          */
         ~DataProcessor();
         
+        // 执行策略（不要在分析进行中修改）
+        void setExecutionPolicy(const ExecutionPolicy& policy);
+        const ExecutionPolicy& getExecutionPolicy() const { return executionPolicy; }
+        
         // 统计分析
         DataStatistics calculateStatistics(const std::vector<MeasurementData>& data);
         double calculateCorrelation(const std::vector<MeasurementData>& data,
                                    DataField field1, DataField field2);
+        CorrelationMatrix calculateCorrelationMatrix(const std::vector<MeasurementData>& data,
+                                                     const std::vector<DataField>& fields = {});
+        RunningMoments computeMoments(const std::vector<MeasurementData>& data,
+                                      const std::vector<DataField>& fields) const;
+        
+        // 由矩累加器构造结果，用于增量更新：
+        // 统计为 statisticsFields() 顺序的四维矩（不含中位数和时间），回归为(x, y)二维矩（不含逐点残差）
+        static const std::vector<DataField>& statisticsFields();
+        DataStatistics statisticsFromMoments(const RunningMoments& moments) const;
+        LinearRegression regressionFromMoments(const RunningMoments& moments) const;
         
         // 回归分析
         LinearRegression performLinearRegression(const std::vector<MeasurementData>& data,
                                                DataField xField, DataField yField);
+        LinearRegression linearRegression(const std::vector<double>& x, const std::vector<double>& y) const;
         PolynomialFit performPolynomialFitting(const std::vector<MeasurementData>& data,
                                               DataField xField, DataField yField, int degree);
-        double predict(const LinearRegression& model, double x);
-        double predict(const PolynomialFit& model, double x);
+        PolynomialFit fitPolynomial(const std::vector<double>& x, const std::vector<double>& y,
+                                    int degree, const std::vector<double>& weights = {}) const;
+        std::vector<PolynomialFit> fitPolynomialBatch(const std::vector<PolynomialSeries>& series,
+                                                      int degree) const;
+        std::vector<PolynomialFit> fitPolynomialBatch(const std::vector<double>& x,
+                                                      const std::vector<std::vector<double>>& ySeries,
+                                                      int degree) const;
+        double predict(const LinearRegression& model, double x) const;
+        double predict(const PolynomialFit& model, double x) const;
         
         // 数据平滑
         std::vector<MeasurementData> smoothData(const std::vector<MeasurementData>& data,
-                                               SmoothingMethod method, int windowSize);
+                                               SmoothingMethod method, int windowSize,
+                                               int polynomialOrder = 2);
+        MeasurementColumns smoothColumns(const std::vector<MeasurementData>& data,
+                                         SmoothingMethod method, int windowSize,
+                                         int polynomialOrder = 2,
+                                         const std::vector<DataField>& fields = {},
+                                         bool parallel = false);
+        std::vector<double> smoothValues(const std::vector<double>& values, SmoothingMethod method,
+                                         int windowSize, int polynomialOrder = 2) const;
+        
+        // 列式数据（单次遍历提取多个字段）
+        MeasurementColumns extractColumns(const std::vector<MeasurementData>& data,
+                                          const std::vector<DataField>& fields) const;
         
         // 异常值检测
         std::vector<size_t> detectOutliers(const std::vector<MeasurementData>& data,
@@ -218,6 +434,20 @@ class DataProcessor {
         FFTResult performFFT(const std::vector<MeasurementData>& data, DataField field);
         std::vector<size_t> findPeaks(const FFTResult& fft, double threshold);
         
+        // 功率谱密度（Welch方法）
+        PowerSpectrum performWelchPSD(const std::vector<MeasurementData>& data, DataField field,
+                                      const WelchOptions& options = WelchOptions());
+        PowerSpectrum welchPSD(const std::vector<double>& values, double samplingRate,
+                               const WelchOptions& options = WelchOptions()) const;
+        
+        // 互相关与时滞估计（FFT，O(n log n)）
+        // crossCorrelation返回 r[k] = Σ x[t]·y[t+k]，k = -(n-1)..(n-1)，下标 k+n-1
+        std::vector<double> crossCorrelation(const std::vector<double>& x,
+                                             const std::vector<double>& y) const;
+        CrossCorrelationResult analyzeChannelLags(const std::vector<MeasurementData>& data,
+                                                  const std::vector<DataField>& fields = {},
+                                                  const CrossCorrelationOptions& options = CrossCorrelationOptions());
+        
         // 数据分组
         std::map<std::string, std::vector<MeasurementData>> groupData(
             const std::vector<MeasurementData>& data,
@@ -230,11 +460,15 @@ class DataProcessor {
         ChartData2D prepareScatterPlotData(const std::vector<MeasurementData>& data,
                                            DataField xField, DataField yField);
         ChartData3D prepare3DSurfaceData(const std::vector<MeasurementData>& data,
-                                         DataField xField, DataField yField, DataField zField);
+                                         DataField xField, DataField yField, DataField zField,
+                                         const SurfaceGridOptions& options = SurfaceGridOptions());
         
         // 误差分析
         ErrorAnalysis analyzeError(const std::vector<double>& theoretical,
                                   const std::vector<double>& measured);
+        // 实测电容相对于给定模型参数的误差（理论值按设定高度和角度批量计算）
+        ErrorAnalysis analyzeCapacitanceError(const std::vector<MeasurementData>& data,
+                                              const CapacitorParameters& parameters);
         
         // 数据归一化
         std::vector<MeasurementData> normalizeData(const std::vector<MeasurementData>& data,
@@ -247,17 +481,24 @@ class DataProcessor {
         std::vector<DerivativePoint> calculateDerivative(const std::vector<MeasurementData>& data,
                                                         DataField xField, DataField yField);
         double calculateIntegral(const std::vector<MeasurementData>& data,
-                               DataField xField, DataField yField);
+                               DataField xField, DataField yField,
+                               IntegrationMethod method = IntegrationMethod::TRAPEZOID);
         
         // 聚类分析
         std::vector<std::vector<MeasurementData>> performClustering(
             const std::vector<MeasurementData>& data,
             int numClusters,
-            const std::vector<DataField>& features);
+            const std::vector<DataField>& features,
+            NormalizationMethod normalization = NormalizationMethod::Z_SCORE);
+        ClusteringResult performKMeans(const std::vector<MeasurementData>& data,
+                                       int numClusters,
+                                       const std::vector<DataField>& features,
+                                       const ClusteringOptions& options = ClusteringOptions());
         
         // 实用方法
         std::string getFieldName(DataField field) const;
         std::string getFieldUnit(DataField field) const;
+        static std::vector<double> createWindow(WindowFunction window, size_t length);
         
     private:
         // 辅助方法
@@ -265,6 +506,15 @@ class DataProcessor {
         void setFieldValue(MeasurementData& data, DataField field, double value) const;
         std::vector<double> extractFieldValues(const std::vector<MeasurementData>& data,
                                              DataField field) const;
+        void normalizeValues(std::vector<double>& values, NormalizationMethod method,
+                             double* offset = nullptr, double* scale = nullptr) const;
+        // physical为false时高度/角度按原值写入（不检查安全范围、不重算理论电容），用于归一化等非物理值
+        void writeColumns(std::vector<MeasurementData>& data, const MeasurementColumns& columns,
+                          bool physical = true) const;
+        double estimateSamplingRate(const std::vector<MeasurementData>& data) const;
+        size_t chunkCountFor(size_t rows) const;
+        bool forEachChunk(size_t chunkCount, const std::function<void(size_t)>& fn,
+                          int maxThreads = 0) const;
         
         // 统计计算
         double calculateMean(const std::vector<double>& values) const;
@@ -277,24 +527,25 @@ class DataProcessor {
         std::vector<double> movingAverage(const std::vector<double>& data, int windowSize) const;
         std::vector<double> gaussianSmooth(const std::vector<double>& data, int windowSize, double sigma) const;
         std::vector<double> medianFilter(const std::vector<double>& data, int windowSize) const;
+        std::vector<double> savitzkyGolay(const std::vector<double>& data, int windowSize, int order) const;
         
-        // 线性代数
-        std::vector<double> gaussianElimination(std::vector<std::vector<double>>& a, 
-                                              std::vector<double>& b) const;
+        // 拟合评估
+        PolynomialFit evaluateFit(std::vector<double> coefficients, int degree,
+                                  const std::vector<double>& x, const std::vector<double>& y,
+                                  const std::vector<double>& weights) const;
         
-        // FFT实现
-        std::vector<std::complex<double>> fft(const std::vector<std::complex<double>>& data) const;
-        std::vector<std::complex<double>> dft(const std::vector<std::complex<double>>& data) const;
         // 插值实现
         double linearInterpolate(double x0, double y0, double x1, double y1, double x) const;
-        double cubicInterpolate(const std::vector<double>& x, const std::vector<double>& y, double xi) const;
+        double cubicInterpolate(const std::vector<double>& x, const std::vector<double>& y,
+                                size_t interval, double xi) const;
         
-        // K-means聚类
-        std::vector<std::vector<size_t>> kMeansClustering(const std::vector<std::vector<double>>& data,
-                                                          int k, int maxIterations = 100) const;
+        // K-means聚类（columns为列式特征，每列一个特征）
+        ClusteringResult kMeansClustering(const std::vector<std::vector<double>>& columns,
+                                          size_t k, const ClusteringOptions& options) const;
         
         // 成员变量
         mutable std::vector<double> workBuffer; // 工作缓冲区
+        ExecutionPolicy executionPolicy;
     };
     
 #endif // DATA_PROCESSOR_H
\ No newline at end of file
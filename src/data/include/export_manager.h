@@ -8,7 +8,14 @@
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include "../../models/include/measurement_data.h"
+#include "../../models/include/measurement_source.h"
+#include "../../utils/include/thread_pool.h"
+
+class TimestampFormatter;
+class RecordWriter;
 
 enum class ExportFormat {
     CSV,
@@ -44,7 +51,10 @@ struct ExportOptions {
     // 性能选项
     bool useBuffering = true;
     size_t bufferSize = 1024 * 1024; // 1MB
-    bool compress = false;
+    size_t chunkRecords = 16384;     // CSV/JSON按块并行格式化，每块记录数；进度按块报告
+    bool compress = false;           // gzip压缩，在写出过程中流式进行
+    int compressionLevel = 6;        // zlib压缩级别 0-9
+    size_t compressionThreads = 1;   // >1时按块并行压缩（类似pigz），0表示线程池线程数+1
     
     // 文件名选项
     bool autoGenerateFilename = false;
@@ -67,6 +77,64 @@ struct ExportStatistics {
     std::string filename;
 };
 
+// 一个导出目标；statistics为true时写统计摘要（同exportStatistics），忽略options.format（options.compress仍有效）
+struct ExportTarget {
+    std::string filename;
+    ExportOptions options;
+    bool statistics = false;
+};
+
+enum class ExportJobStatus {
+    PENDING,
+    RUNNING,
+    COMPLETED,
+    FAILED,
+    CANCELLED
+};
+
+/**
+ * @brief 后台导出任务的句柄（ExportManager::submitExport返回）
+ *
+ * 各查询方法可以在任意线程调用；进度按全部目标已写出的记录计算。
+ */
+class ExportJob {
+public:
+    ExportJobStatus getStatus() const;
+    bool isFinished() const;
+    int getProgress() const;
+    size_t getBytesWritten() const;
+    std::string getError() const;
+    // 完成后每个目标一项
+    std::vector<ExportStatistics> getStatistics() const;
+    
+    // 请求取消：任务在下一个数据块边界停止，已写出的文件保留
+    void cancel();
+    
+    ExportJobStatus wait() const;
+    // 超时返回false
+    bool waitFor(int timeoutMs) const;
+    
+private:
+    friend class ExportManager;
+    ExportJob() = default;
+    
+    void setRunning();
+    void complete(ExportJobStatus finalStatus, const std::string& reason,
+                  std::vector<ExportStatistics> results);
+    
+    mutable std::mutex mutex;
+    mutable std::condition_variable finishedCondition;
+    ExportJobStatus status = ExportJobStatus::PENDING;
+    std::string error;
+    std::vector<ExportStatistics> statistics;
+    
+    CancellationToken cancellation;
+    std::atomic<size_t> recordsWritten{0};
+    std::atomic<size_t> totalRecords{0};   // 记录数 × 目标数
+    std::atomic<size_t> bytesWritten{0};
+    std::atomic<int> reportedProgress{-1};
+};
+
 class ExportManager {
 public:
     ExportManager();
@@ -79,15 +147,33 @@ public:
                    const std::string& filename,
                    const ExportOptions& options = ExportOptions());
     
+    // 从分块数据源流式导出（记录器、CSV文件等），不需要一次性复制全部记录
+    bool exportData(const MeasurementSource& source,
+                   const std::string& filename,
+                   const ExportOptions& options = ExportOptions());
+    
     bool exportFiltered(const std::vector<MeasurementData>& data,
                        const std::string& filename,
                        const ExportOptions& options,
                        std::function<bool(const MeasurementData&)> filter);
     
+    // 全部文件共用一次读取遍历
     bool batchExport(const std::vector<MeasurementData>& data,
                     const std::vector<std::string>& filenames,
                     const std::vector<ExportOptions>& options);
     
+    /**
+     * @brief 在后台工作线程中导出，立即返回任务句柄
+     *
+     * 多个目标（如CSV、JSON和统计摘要）共用一次对source的读取遍历。
+     * 每个目标完成后经CompletionCallback通知，进度同时经ProgressCallback报告（0-100）。
+     * ExportManager析构时取消并等待未完成的任务。
+     */
+    std::shared_ptr<ExportJob> submitExport(std::shared_ptr<const MeasurementSource> source,
+                                            const std::vector<ExportTarget>& targets);
+    std::shared_ptr<ExportJob> submitExport(std::vector<MeasurementData> data,
+                                            const std::vector<ExportTarget>& targets);
+    
     void addTemplate(const ExportTemplate& template_);
     void removeTemplate(const std::string& name);
     std::vector<ExportTemplate> getTemplates() const;
@@ -120,41 +206,35 @@ public:
     ExportOptions getDefaultOptions() const;
     
 private:
-    // 内部导出方法
-    bool exportCSV(const std::vector<MeasurementData>& data,
-                  const std::string& filename,
-                  const ExportOptions& options);
+    // 创建并打开一个目标的写出器；失败时返回nullptr，error给出原因
+    std::unique_ptr<RecordWriter> createWriter(const ExportTarget& target,
+                                               const std::function<void(size_t, size_t)>& progress,
+                                               const CancellationToken& cancellation,
+                                               std::string& error) const;
     
-    bool exportJSON(const std::vector<MeasurementData>& data,
-                   const std::string& filename,
-                   const ExportOptions& options);
-    
-    bool exportXML(const std::vector<MeasurementData>& data,
-                  const std::string& filename,
-                  const ExportOptions& options);
-    
-    bool exportText(const std::vector<MeasurementData>& data,
-                   const std::string& filename,
-                   const ExportOptions& options);
+    // 一次读取遍历写出全部目标，成功后逐个通知完成
+    bool runExport(const MeasurementSource& source, const std::vector<ExportTarget>& targets,
+                   const CancellationToken& cancellation,
+                   const std::function<void(size_t, size_t)>& progress,
+                   std::vector<ExportStatistics>& results, std::string& error);
     
-    bool exportMATLAB(const std::vector<MeasurementData>& data,
-                     const std::string& filename,
-                     const ExportOptions& options);
+    void runJob(ExportJob& job, const MeasurementSource& source, const std::vector<ExportTarget>& targets);
     
     // 辅助方法
     std::string formatValue(double value, int decimalPlaces) const;
     std::string formatTimestamp(int64_t timestamp, const std::string& format) const;
-    std::string escapeCSV(const std::string& value, const ExportOptions& options) const;
+    // out中从fieldStart开始的字段含分隔符、引号或换行时原地加引号转义
+    void escapeCSV(std::string& out, size_t fieldStart, const ExportOptions& options) const;
     std::string generateCSVHeader(const ExportOptions& options) const;
-    std::string measurementToCSV(const MeasurementData& data, const ExportOptions& options) const;
-    std::string measurementToJSON(const MeasurementData& data, const ExportOptions& options) const;
+    // 记录直接追加到块缓冲区；timestamps由调用方按块持有，复用分钟缓存
+    void appendCSVRecord(std::string& out, const MeasurementData& data,
+                         const ExportOptions& options, TimestampFormatter& timestamps) const;
+    void appendJSONRecord(std::string& out, const MeasurementData& data, const ExportOptions& options) const;
     
     void notifyProgress(int current, int total);
     void notifyCompletion(const ExportStatistics& stats);
     void setError(const std::string& error);
     
-    bool compressFile(const std::string& filename);
-    
     // 成员变量
     mutable std::mutex mutex;
     
@@ -174,9 +254,9 @@ private:
     // 统计信息
     ExportStatistics lastExportStats;
     
-    // 缓冲区
-    std::unique_ptr<char[]> writeBuffer;
-    size_t writeBufferSize = 1024 * 1024; // 1MB
+    // 后台任务
+    std::unique_ptr<ThreadPool> jobPool;
+    std::vector<std::weak_ptr<ExportJob>> jobs;
 };
 
 #endif // EXPORT_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef FIELD_ACCESS_H
+#define FIELD_ACCESS_H
+
+#include <cstddef>
+#include "../../models/include/measurement_data.h"
+
+/**
+ * @brief 数据字段枚举
+ */
+enum class DataField {
+    HEIGHT,
+    ANGLE,
+    CAPACITANCE,
+    TEMPERATURE,
+    UPPER_SENSOR_1,
+    UPPER_SENSOR_2,
+    LOWER_SENSOR_1,
+    LOWER_SENSOR_2,
+    TIMESTAMP
+};
+
+/**
+ * @brief 编译期字段标签
+ */
+template <DataField F>
+struct FieldTag {
+    static constexpr DataField field = F;
+};
+
+/**
+ * @brief 编译期字段访问器
+ *
+ * 每个字段一个特化，get/set是内联的直接成员访问。
+ * 以FieldTag为参数实例化的核函数，循环体内没有按字段的分支，编译器可以内联和向量化；
+ * 运行期字段通过 dispatchField() 在每次调用时分派一次。
+ */
+template <DataField F>
+struct FieldAccessor;
+
+template <>
+struct FieldAccessor<DataField::HEIGHT> {
+    static double get(const MeasurementData& m) { return m.getSetHeight(); }
+    static void set(MeasurementData& m, double value) { m.setHeight(value); }
+};
+
+template <>
+struct FieldAccessor<DataField::ANGLE> {
+    static double get(const MeasurementData& m) { return m.getSetAngle(); }
+    static void set(MeasurementData& m, double value) { m.setAngle(value); }
+};
+
+template <double SensorData::*Member>
+struct SensorFieldAccessor {
+    static double get(const MeasurementData& m) { return m.getSensorData().*Member; }
+    static void set(MeasurementData& m, double value) {
+        SensorData sensor = m.getSensorData();
+        sensor.*Member = value;
+        m.updateSensorData(sensor);
+    }
+};
+
+template <>
+struct FieldAccessor<DataField::CAPACITANCE> : SensorFieldAccessor<&SensorData::capacitance> {};
+template <>
+struct FieldAccessor<DataField::TEMPERATURE> : SensorFieldAccessor<&SensorData::temperature> {};
+template <>
+struct FieldAccessor<DataField::UPPER_SENSOR_1> : SensorFieldAccessor<&SensorData::distanceUpper1> {};
+template <>
+struct FieldAccessor<DataField::UPPER_SENSOR_2> : SensorFieldAccessor<&SensorData::distanceUpper2> {};
+template <>
+struct FieldAccessor<DataField::LOWER_SENSOR_1> : SensorFieldAccessor<&SensorData::distanceLower1> {};
+template <>
+struct FieldAccessor<DataField::LOWER_SENSOR_2> : SensorFieldAccessor<&SensorData::distanceLower2> {};
+
+template <>
+struct FieldAccessor<DataField::TIMESTAMP> {
+    static double get(const MeasurementData& m) { return static_cast<double>(m.getTimestamp()); }
+    static void set(MeasurementData&, double) {}   // 时间戳不应被修改
+};
+
+template <DataField F>
+inline double getField(const MeasurementData& m, FieldTag<F>) {
+    return FieldAccessor<F>::get(m);
+}
+
+template <DataField F>
+inline void setField(MeasurementData& m, double value, FieldTag<F>) {
+    FieldAccessor<F>::set(m, value);
+}
+
+/**
+ * @brief 运行期字段到编译期标签的分派：fn(FieldTag<F>{})
+ */
+template <typename Fn>
+auto dispatchField(DataField field, Fn&& fn) {
+    switch (field) {
+        case DataField::HEIGHT:         return fn(FieldTag<DataField::HEIGHT>{});
+        case DataField::ANGLE:          return fn(FieldTag<DataField::ANGLE>{});
+        case DataField::CAPACITANCE:    return fn(FieldTag<DataField::CAPACITANCE>{});
+        case DataField::TEMPERATURE:    return fn(FieldTag<DataField::TEMPERATURE>{});
+        case DataField::UPPER_SENSOR_1: return fn(FieldTag<DataField::UPPER_SENSOR_1>{});
+        case DataField::UPPER_SENSOR_2: return fn(FieldTag<DataField::UPPER_SENSOR_2>{});
+        case DataField::LOWER_SENSOR_1: return fn(FieldTag<DataField::LOWER_SENSOR_1>{});
+        case DataField::LOWER_SENSOR_2: return fn(FieldTag<DataField::LOWER_SENSOR_2>{});
+        case DataField::TIMESTAMP:
+        default:                        return fn(FieldTag<DataField::TIMESTAMP>{});
+    }
+}
+
+/**
+ * @brief 把count条连续记录的字段F依次写入out
+ */
+template <DataField F>
+inline void gatherField(const MeasurementData* rows, size_t count, double* out, FieldTag<F>) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = FieldAccessor<F>::get(rows[i]);
+    }
+}
+
+inline void gatherField(DataField field, const MeasurementData* rows, size_t count, double* out) {
+    dispatchField(field, [&](auto tag) { gatherField(rows, count, out, tag); });
+}
+
+#endif // FIELD_ACCESS_H
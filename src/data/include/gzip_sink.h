@@ -0,0 +1,67 @@
+#ifndef GZIP_SINK_H
+#define GZIP_SINK_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "chunked_export.h"
+
+struct z_stream_s;
+
+struct GzipOptions {
+    int level = 6;          // zlib压缩级别，0为仅存储，9为最高压缩比
+    size_t threads = 1;     // >1时按块并行压缩；0表示线程池线程数+1
+    size_t blockSize = 128 * 1024;
+};
+
+/**
+ * @brief 流式gzip压缩，压缩结果写入下游ByteSink
+ *
+ * 单线程时整个文件是一个deflate流。多线程时按pigz的方式把输入切成固定大小的块，
+ * 每块以前一块末尾32KB为预置字典独立压缩并以同步刷新结束，各块输出按序拼接成
+ * 一个合法的gzip成员；CRC按块计算后合并。压缩在写出线程中进行，不需要事后再处理文件。
+ */
+class GzipSink : public ByteSink {
+public:
+    GzipSink(std::unique_ptr<ByteSink> downstream, const GzipOptions& options = GzipOptions());
+    ~GzipSink() override;
+
+    GzipSink(const GzipSink&) = delete;
+    GzipSink& operator=(const GzipSink&) = delete;
+
+    bool write(const char* data, size_t size) override;
+    // 结束压缩流、写出gzip尾部并关闭下游
+    bool close() override;
+
+    // 已写入下游的压缩字节数
+    size_t bytesWritten() const override { return downstream->bytesWritten(); }
+    // 已接收的未压缩字节数
+    size_t bytesConsumed() const { return consumed; }
+
+private:
+    bool writeHeader();
+    bool deflateStream(const char* data, size_t size, int flush);
+    bool compressBlocks(bool final);
+
+    std::unique_ptr<ByteSink> downstream;
+    GzipOptions options;
+    size_t threads;
+    bool headerWritten = false;
+    bool closed = false;
+    bool failed = false;
+    uint64_t consumed = 0;
+    unsigned long crc = 0;
+
+    // 单线程：一个持续的deflate流
+    std::unique_ptr<z_stream_s> stream;
+    std::vector<unsigned char> output;
+
+    // 多线程：待压缩的输入（前部保留上一批最后32KB作为字典）与各块的输出
+    std::string pending;
+    size_t dictionarySize = 0;
+    std::vector<std::string> blockOutputs;
+    std::vector<unsigned long> blockCrcs;
+};
+
+#endif // GZIP_SINK_H
@@ -0,0 +1,128 @@
+#ifndef RECORD_WRITER_H
+#define RECORD_WRITER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "chunked_export.h"
+#include "gzip_sink.h"
+#include "../../models/include/measurement_source.h"
+
+/**
+ * @brief 一个导出目标的增量写出
+ *
+ * 数据源的每一块调用一次write()，遍历结束后调用finish()。
+ * 多个目标可以共用一次读取遍历（见drive()）。
+ */
+class RecordWriter {
+public:
+    // 增量进度：又有records条记录、bytes字节写出（可能在写线程中调用）
+    using ProgressFn = std::function<void(size_t records, size_t bytes)>;
+
+    virtual ~RecordWriter() = default;
+
+    // 失败或取消后返回false，原因见getError()
+    virtual bool write(const MeasurementData* rows, size_t count) = 0;
+    virtual bool finish() = 0;
+    virtual size_t getBytesWritten() const = 0;
+
+    size_t getRecordCount() const { return records; }
+    const std::string& getFilename() const { return filename; }
+    const std::string& getError() const { return error; }
+
+    /**
+     * @brief 遍历一次source，每块依次交给全部writers，结束后逐个finish()
+     * @return 任一目标失败或取消时停止读取并返回false，error给出第一个失败原因；
+     *         数据源中途停止或提供的记录少于开始时的size()时同样返回false
+     */
+    static bool drive(const MeasurementSource& source, const std::vector<RecordWriter*>& writers,
+                      const CancellationToken& cancellation, std::string* error = nullptr);
+
+protected:
+    std::string filename;
+    std::string error;
+    size_t records = 0;
+};
+
+/**
+ * @brief 逐条格式化的文本格式（CSV、JSON、XML等）：prefix、各记录、suffix
+ *
+ * 记录按chunkRecords条重新分块（与数据源的块大小无关），经ChunkedExport并行格式化、按序写出。
+ * 数据源的块小于一批时先复制凑满一批，因此内存占用不超过一批记录及其两组格式化缓冲区。
+ */
+class ChunkedRecordWriter : public RecordWriter {
+public:
+    // 把rows[0, count)追加到out；firstIndex为rows[0]在整个导出中的序号
+    using ChunkFormatter = std::function<void(const MeasurementData* rows, size_t count,
+                                              size_t firstIndex, std::string& out)>;
+
+    ChunkedRecordWriter(ChunkFormatter formatter, size_t chunkRecords,
+                        ProgressFn progress = nullptr,
+                        const CancellationToken& cancellation = CancellationToken());
+    ~ChunkedRecordWriter() override;
+
+    // compression非空时经GzipSink压缩后写入文件
+    bool open(const std::string& filename, const std::string& prefix, const std::string& suffix,
+              const GzipOptions* compression = nullptr);
+
+    bool write(const MeasurementData* rows, size_t count) override;
+    bool finish() override;
+    size_t getBytesWritten() const override;
+
+private:
+    bool submit(const MeasurementData* rows, size_t count);
+    void chunkWritten(size_t chunk);
+
+    ChunkFormatter formatter;
+    size_t chunkRecords;
+    ProgressFn progress;
+    CancellationToken cancellation;
+    std::string suffix;
+
+    std::unique_ptr<ByteSink> sink;
+    std::unique_ptr<ChunkedExport::Writer> writer;
+    size_t batchRecords = 0;
+    std::vector<MeasurementData> pending;
+    bool failed = false;
+
+    // 各块结束处的记录序号，写线程据此报告进度
+    std::mutex endsMutex;
+    std::vector<size_t> chunkEnds;
+    size_t reportedRecords = 0;   // 仅写线程访问
+    size_t reportedBytes = 0;
+};
+
+/**
+ * @brief 统计摘要（设定高度、角度、理论电容的均值与范围，时间范围）
+ */
+class StatisticsRecordWriter : public RecordWriter {
+public:
+    // compression非空时摘要经GzipSink压缩后写入文件
+    explicit StatisticsRecordWriter(const std::string& filename, ProgressFn progress = nullptr,
+                                    const GzipOptions* compression = nullptr);
+
+    bool write(const MeasurementData* rows, size_t count) override;
+    bool finish() override;
+    size_t getBytesWritten() const override { return bytes; }
+
+private:
+    ProgressFn progress;
+    bool compress = false;
+    GzipOptions compression;
+    size_t bytes = 0;
+
+    double sumHeight = 0.0;
+    double sumAngle = 0.0;
+    double sumCapacitance = 0.0;
+    double minHeight = 0.0;
+    double maxHeight = 0.0;
+    double minAngle = 0.0;
+    double maxAngle = 0.0;
+    int64_t firstTimestamp = 0;
+    int64_t lastTimestamp = 0;
+};
+
+#endif // RECORD_WRITER_H
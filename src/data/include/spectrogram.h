@@ -0,0 +1,97 @@
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "data_processor.h"
+#include "../../models/include/sensor_data.h"
+
+class FFTPlan;
+
+/**
+ * @brief 频谱图帧
+ */
+struct SpectrogramFrame {
+    size_t index = 0;                // 帧序号
+    double time = 0.0;               // 帧中心时间（秒，自第一个样本起）
+    std::vector<double> density;     // 单边功率谱密度
+    double peakFrequency = 0.0;      // 本帧能量最大的频率（不含直流）
+};
+
+/**
+ * @brief 流式短时傅里叶变换
+ *
+ * 逐个接收传感器样本，每累计 hopLength 个新样本输出一帧频谱，
+ * 内部只保留一个帧长的环形缓冲区，适合在采集过程中实时观察机械共振。
+ */
+class StreamingSpectrogram {
+public:
+    using FrameCallback = std::function<void(const SpectrogramFrame& frame)>;
+
+    StreamingSpectrogram(double samplingRate,
+                         size_t frameLength = 256,
+                         size_t hopLength = 128,
+                         WindowFunction window = WindowFunction::HANN);
+    ~StreamingSpectrogram();
+
+    // 输入样本
+    void pushSample(double value);
+    void pushSamples(const double* values, size_t count);
+    void pushSamples(const std::vector<double>& values);
+    void pushSensorData(const SensorData& data);
+
+    // 配置
+    void setFrameCallback(FrameCallback callback);
+    void setField(DataField field);
+    DataField getField() const;
+    void setAveragingFactor(double alpha);
+
+    // 结果访问
+    std::vector<double> getFrequencies() const;
+    std::vector<double> getAveragedDensity() const;
+    double getPeakFrequency() const;
+    size_t getFrameCount() const;
+    double getSamplingRate() const { return samplingRate; }
+    size_t getFrameLength() const { return frameLength; }
+    size_t getHopLength() const { return hopLength; }
+
+    void reset();
+
+    static bool sensorValue(const SensorData& data, DataField field, double& value);
+
+private:
+    void appendSamples(const double* values, size_t count, std::vector<SpectrogramFrame>& frames);  // 需持有mutex
+    void computeFrame(SpectrogramFrame& frame);
+
+    const double samplingRate;
+    const size_t frameLength;
+    const size_t hopLength;
+    DataField field = DataField::CAPACITANCE;
+
+    mutable std::mutex mutex;
+
+    // 环形缓冲区
+    std::vector<double> ring;
+    size_t writePos = 0;
+    size_t totalSamples = 0;
+    size_t samplesSinceFrame = 0;
+
+    // 预分配的工作区
+    std::vector<double> window;
+    std::vector<double> scale;
+    std::vector<double> segment;
+    std::vector<std::complex<double>> spectrum;
+    std::shared_ptr<const FFTPlan> plan;
+
+    // 指数平均谱
+    std::vector<double> averaged;
+    double averagingFactor = 0.2;
+    size_t frameCount = 0;
+
+    FrameCallback frameCallback;
+};
+
+#endif // SPECTROGRAM_H
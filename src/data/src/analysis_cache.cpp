@@ -0,0 +1,190 @@
+#include "../include/analysis_cache.h"
+#include "../../utils/include/logger.h"
+#include <algorithm>
+
+AnalysisCache::AnalysisCache(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)) {
+}
+
+const std::any* AnalysisCache::lookup(const Key& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return nullptr;
+    }
+    recency.splice(recency.begin(), recency, it->second.position);
+    return &it->second.value;
+}
+
+void AnalysisCache::store(const Key& key, std::any value) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.value = std::move(value);
+        recency.splice(recency.begin(), recency, it->second.position);
+        return;
+    }
+
+    recency.push_front(key);
+    entries.emplace(key, Entry{std::move(value), recency.begin()});
+    while (entries.size() > capacity) {
+        entries.erase(recency.back());
+        recency.pop_back();
+    }
+}
+
+namespace {
+constexpr size_t kBlockRecords = 1024;
+}
+
+void AnalysisCache::evictBefore(IncrementalState& state, size_t first, size_t dims, bool trackMedian) {
+    // 统计字段的第0列为高度
+    while (!state.blocks.empty()) {
+        Block& block = state.blocks.front();
+        size_t count = block.timestamps.size();
+        if (block.first >= first) {
+            break;
+        }
+        size_t dropped = std::min(first - block.first, count);
+        if (trackMedian) {
+            for (size_t r = 0; r < dropped; ++r) {
+                state.heightMedian.erase(block.values[r * dims]);
+            }
+        }
+        if (dropped == count) {
+            state.blocks.pop_front();
+            continue;
+        }
+
+        // 部分淘汰：去掉首部记录后重算本块的矩
+        block.values.erase(block.values.begin(), block.values.begin() + dropped * dims);
+        block.timestamps.erase(block.timestamps.begin(), block.timestamps.begin() + dropped);
+        block.first += dropped;
+        block.moments.reset();
+        for (size_t r = 0; r < block.timestamps.size(); ++r) {
+            block.moments.add(&block.values[r * dims]);
+        }
+        break;
+    }
+}
+
+void AnalysisCache::append(IncrementalState& state, const MeasurementColumns& columns, size_t first,
+                           const std::vector<MeasurementData>& delta, bool trackMedian) {
+    const size_t dims = columns.fields.size();
+    std::vector<double> row(dims);
+    for (size_t i = 0; i < columns.rows; ++i) {
+        if (state.blocks.empty() || state.blocks.back().timestamps.size() >= kBlockRecords) {
+            Block block;
+            block.first = first + i;
+            block.moments = RunningMoments(dims);
+            block.values.reserve(kBlockRecords * dims);
+            block.timestamps.reserve(kBlockRecords);
+            state.blocks.push_back(std::move(block));
+        }
+        Block& block = state.blocks.back();
+        for (size_t f = 0; f < dims; ++f) {
+            row[f] = columns.values[f][i];
+        }
+        block.moments.add(row.data());
+        block.values.insert(block.values.end(), row.begin(), row.end());
+        block.timestamps.push_back(delta[i].getTimestamp());
+        if (trackMedian) {
+            state.heightMedian.insert(row[0]);
+        }
+    }
+}
+
+AnalysisCache::IncrementalState& AnalysisCache::refresh(const DataProcessor& processor,
+                                                        const DatasetVersion& version,
+                                                        const DeltaSource& source,
+                                                        const std::string& operation,
+                                                        const std::vector<DataField>& fields,
+                                                        bool trackMedian) {
+    IncrementalState& state = incremental[{version.datasetId, operation}];
+    if (version.datasetId != 0 && state.version == version) {
+        ++hits;
+        return state;
+    }
+    ++misses;
+
+    DatasetVersion current;
+    std::vector<MeasurementData> delta = source(state.version, current);
+
+    // 只有追加和首部淘汰时，delta为仍保留的新增记录；否则source返回的是全部记录，从头累加
+    size_t first = current.evicted;
+    if (state.version.precedes(current)) {
+        first = std::max(state.version.appended(), current.evicted);
+    } else {
+        state.blocks.clear();
+        state.heightMedian.clear();
+    }
+    evictBefore(state, current.evicted, fields.size(), trackMedian);
+    append(state, processor.extractColumns(delta, fields), first, delta, trackMedian);
+
+    state.moments = RunningMoments(fields.size());
+    for (const Block& block : state.blocks) {
+        state.moments.merge(block.moments);
+    }
+    state.version = current;
+    return state;
+}
+
+DataStatistics AnalysisCache::statistics(const DataProcessor& processor, const DatasetVersion& version,
+                                         const DeltaSource& source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    IncrementalState& state = refresh(processor, version, source, "statistics",
+                                      DataProcessor::statisticsFields(), true);
+
+    DataStatistics stats = processor.statisticsFromMoments(state.moments);
+    if (stats.dataCount > 0) {
+        stats.firstRecordTime = state.blocks.front().timestamps.front();
+        stats.lastRecordTime = state.blocks.back().timestamps.back();
+        stats.median = state.heightMedian.median();
+    }
+    return stats;
+}
+
+LinearRegression AnalysisCache::regression(const DataProcessor& processor, const DatasetVersion& version,
+                                           const DeltaSource& source, DataField xField, DataField yField) {
+    std::string operation = "regression:" + std::to_string(static_cast<int>(xField)) +
+                            ":" + std::to_string(static_cast<int>(yField));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    IncrementalState& state = refresh(processor, version, source, operation, {xField, yField}, false);
+    return processor.regressionFromMoments(state.moments);
+}
+
+void AnalysisCache::invalidate(uint64_t datasetId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (std::get<0>(it->first) == datasetId) {
+            recency.erase(it->second.position);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = incremental.begin(); it != incremental.end();) {
+        if (it->first.first == datasetId) {
+            it = incremental.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AnalysisCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    recency.clear();
+    incremental.clear();
+    LOG_INFO("Analysis cache cleared");
+}
+
+size_t AnalysisCache::hitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+size_t AnalysisCache::missCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
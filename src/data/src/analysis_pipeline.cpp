@@ -0,0 +1,246 @@
+#include "../include/analysis_pipeline.h"
+#include "../../utils/include/logger.h"
+#include <algorithm>
+
+AnalysisPipeline::AnalysisPipeline(const MeasurementSource& source, const DataProcessor& processor)
+    : source(source), processor(processor) {
+}
+
+AnalysisPipeline& AnalysisPipeline::select(const std::vector<DataField>& fields) {
+    for (DataField field : fields) {
+        if (std::find(selected.begin(), selected.end(), field) == selected.end()) {
+            selected.push_back(field);
+        }
+    }
+    return *this;
+}
+
+AnalysisPipeline& AnalysisPipeline::timeRange(int64_t startMs, int64_t endMs) {
+    ranges.push_back({DataField::TIMESTAMP, static_cast<double>(startMs), static_cast<double>(endMs)});
+    return *this;
+}
+
+AnalysisPipeline& AnalysisPipeline::where(DataField field, double minValue, double maxValue) {
+    ranges.push_back({field, minValue, maxValue});
+    return *this;
+}
+
+AnalysisPipeline& AnalysisPipeline::where(std::function<bool(const MeasurementData&)> predicate) {
+    if (predicate) {
+        predicates.push_back(std::move(predicate));
+    }
+    return *this;
+}
+
+AnalysisPipeline& AnalysisPipeline::map(DataField field, std::function<double(double)> fn) {
+    if (fn) {
+        mappings.push_back({field, std::move(fn)});
+    }
+    return *this;
+}
+
+AnalysisPipeline& AnalysisPipeline::smooth(DataField field, SmoothingMethod method, int windowSize,
+                                           int polynomialOrder) {
+    smoothings.push_back({field, method, windowSize, polynomialOrder});
+    return *this;
+}
+
+bool AnalysisPipeline::run(const std::vector<DataField>& outputs,
+                           const std::function<void(const std::vector<const double*>&, size_t)>& sink) const {
+    // 输出列在前，其后是只用于筛选的字段；每个字段只提取一次
+    std::vector<DataField> inputs = outputs;
+    auto inputIndex = [&](DataField field) {
+        auto it = std::find(inputs.begin(), inputs.end(), field);
+        if (it != inputs.end()) {
+            return static_cast<size_t>(it - inputs.begin());
+        }
+        inputs.push_back(field);
+        return inputs.size() - 1;
+    };
+    std::vector<size_t> rangeInputs;
+    for (const auto& range : ranges) {
+        rangeInputs.push_back(inputIndex(range.field));
+    }
+    std::vector<std::vector<const Mapping*>> outputMappings(outputs.size());
+    for (const auto& mapping : mappings) {
+        auto it = std::find(outputs.begin(), outputs.end(), mapping.field);
+        if (it != outputs.end()) {
+            outputMappings[it - outputs.begin()].push_back(&mapping);
+        }
+    }
+
+    constexpr size_t blockSize = 1024;
+    std::vector<double> block(inputs.size() * blockSize);
+    std::vector<std::vector<double>> kept(outputs.size(), std::vector<double>(blockSize));
+    std::vector<const double*> keptPointers(outputs.size());
+    for (size_t o = 0; o < outputs.size(); ++o) {
+        keptPointers[o] = kept[o].data();
+    }
+    std::vector<unsigned char> keep(blockSize);
+
+    const CancellationToken& token = processor.getExecutionPolicy().cancellation;
+    bool cancelled = false;
+
+    bool complete = source.forEachChunk([&](const MeasurementData* rows, size_t count) {
+        if (token.isCancelled()) {
+            cancelled = true;
+            return false;
+        }
+
+        for (size_t begin = 0; begin < count; begin += blockSize) {
+            size_t len = std::min(blockSize, count - begin);
+            for (size_t f = 0; f < inputs.size(); ++f) {
+                gatherField(inputs[f], rows + begin, len, block.data() + f * blockSize);
+            }
+
+            std::fill(keep.begin(), keep.begin() + len, 1);
+            for (size_t r = 0; r < ranges.size(); ++r) {
+                const double* values = block.data() + rangeInputs[r] * blockSize;
+                const double lo = ranges[r].minValue;
+                const double hi = ranges[r].maxValue;
+                for (size_t i = 0; i < len; ++i) {
+                    keep[i] &= static_cast<unsigned char>(values[i] >= lo && values[i] <= hi);
+                }
+            }
+            if (!predicates.empty()) {
+                for (size_t i = 0; i < len; ++i) {
+                    for (const auto& predicate : predicates) {
+                        if (!keep[i]) break;
+                        keep[i] = predicate(rows[begin + i]) ? 1 : 0;
+                    }
+                }
+            }
+
+            size_t keptCount = 0;
+            for (size_t i = 0; i < len; ++i) {
+                if (keep[i]) {
+                    for (size_t o = 0; o < outputs.size(); ++o) {
+                        kept[o][keptCount] = block[o * blockSize + i];
+                    }
+                    ++keptCount;
+                }
+            }
+            if (keptCount == 0) {
+                continue;
+            }
+
+            for (size_t o = 0; o < outputs.size(); ++o) {
+                for (const Mapping* mapping : outputMappings[o]) {
+                    double* values = kept[o].data();
+                    for (size_t i = 0; i < keptCount; ++i) {
+                        values[i] = mapping->fn(values[i]);
+                    }
+                }
+            }
+
+            sink(keptPointers, keptCount);
+        }
+        return true;
+    });
+
+    if (cancelled) {
+        LOG_WARNING("Analysis pipeline cancelled");
+        return false;
+    }
+    if (!complete) {
+        // 只处理了部分记录，结果不可用
+        LOG_ERROR("Analysis pipeline: data source stopped before all records were read");
+        return false;
+    }
+    return true;
+}
+
+MeasurementColumns AnalysisPipeline::collect(std::vector<DataField> outputs) const {
+    // 去重，保持首次出现的顺序
+    std::vector<DataField> unique;
+    for (DataField field : outputs) {
+        if (std::find(unique.begin(), unique.end(), field) == unique.end()) {
+            unique.push_back(field);
+        }
+    }
+
+    MeasurementColumns columns;
+    columns.fields = unique;
+    columns.values.resize(unique.size());
+
+    bool completed = run(unique, [&](const std::vector<const double*>& values, size_t count) {
+        for (size_t f = 0; f < values.size(); ++f) {
+            columns.values[f].insert(columns.values[f].end(), values[f], values[f] + count);
+        }
+    });
+    if (!completed) {
+        return MeasurementColumns{};
+    }
+    columns.rows = columns.values.empty() ? 0 : columns.values[0].size();
+
+    for (const auto& smoothing : smoothings) {
+        auto it = std::find(unique.begin(), unique.end(), smoothing.field);
+        if (it != unique.end()) {
+            auto& values = columns.values[it - unique.begin()];
+            values = processor.smoothValues(values, smoothing.method, smoothing.windowSize,
+                                            smoothing.polynomialOrder);
+        }
+    }
+
+    return columns;
+}
+
+MeasurementColumns AnalysisPipeline::collect() const {
+    std::vector<DataField> outputs = selected;
+    for (const auto& mapping : mappings) {
+        outputs.push_back(mapping.field);
+    }
+    for (const auto& smoothing : smoothings) {
+        outputs.push_back(smoothing.field);
+    }
+    return collect(outputs);
+}
+
+LinearRegression AnalysisPipeline::regress(DataField xField, DataField yField) const {
+    // 只物化x、y两列
+    MeasurementColumns columns = collect({xField, yField});
+    if (columns.rows < 2) {
+        LOG_WARNING("Insufficient data for linear regression");
+        return LinearRegression{};
+    }
+    const auto& x = columns.values[0];
+    const auto& y = xField == yField ? columns.values[0] : columns.values[1];
+    return processor.linearRegression(x, y);
+}
+
+RunningMoments AnalysisPipeline::moments(const std::vector<DataField>& fields) const {
+    RunningMoments result(fields.size());
+
+    // 有平滑时需要完整的列；否则在遍历中直接累加，不物化任何列
+    if (needsSmoothing(fields)) {
+        MeasurementColumns columns = collect(fields);
+        std::vector<double> row(fields.size());
+        for (size_t i = 0; i < columns.rows; ++i) {
+            for (size_t f = 0; f < fields.size(); ++f) {
+                row[f] = (*columns.find(fields[f]))[i];
+            }
+            result.add(row.data());
+        }
+        return result;
+    }
+
+    std::vector<double> row(fields.size());
+    bool completed = run(fields, [&](const std::vector<const double*>& values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t f = 0; f < values.size(); ++f) {
+                row[f] = values[f][i];
+            }
+            result.add(row.data());
+        }
+    });
+    return completed ? result : RunningMoments(fields.size());
+}
+
+bool AnalysisPipeline::needsSmoothing(const std::vector<DataField>& fields) const {
+    for (const auto& smoothing : smoothings) {
+        if (std::find(fields.begin(), fields.end(), smoothing.field) != fields.end()) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,200 @@
+#include "../include/chunked_export.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+FileSink::~FileSink() {
+    close();
+}
+
+bool FileSink::open(const std::string& filename) {
+    close();
+    written = 0;
+    file.rdbuf()->pubsetbuf(nullptr, 0);
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    return file.is_open();
+}
+
+bool FileSink::write(const char* data, size_t size) {
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(data, static_cast<std::streamsize>(size));
+    if (!file) {
+        return false;
+    }
+    written += size;
+    return true;
+}
+
+bool FileSink::close() {
+    if (!file.is_open()) {
+        return true;
+    }
+    file.close();
+    return !file.fail();
+}
+
+struct ChunkedExport::Writer::Impl {
+    struct Batch {
+        size_t slot;
+        size_t firstChunk;
+        size_t count;
+    };
+
+    ByteSink& sink;
+    ChunkWrittenFn onChunkWritten;
+    CancellationToken cancellation;
+
+    std::vector<std::string> buffers[2];
+    size_t nextChunk = 0;
+    size_t nextSlot = 0;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Batch> queue;
+    bool slotBusy[2] = {false, false};
+    bool producerDone = false;
+    bool discard = false;
+    bool failed = false;
+    std::string failure;
+    std::thread writer;
+
+    Impl(ByteSink& sink, ChunkWrittenFn onChunkWritten, const CancellationToken& cancellation)
+        : sink(sink), onChunkWritten(std::move(onChunkWritten)), cancellation(cancellation) {}
+
+    void fail(const std::string& reason) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed) {
+            failed = true;
+            failure = reason;
+        }
+        changed.notify_all();
+    }
+
+    // 写线程：按提交顺序逐块写出，写完一批后释放该组缓冲区
+    void writeLoop() {
+        for (;;) {
+            Batch batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return !queue.empty() || producerDone; });
+                if (queue.empty() || discard) {
+                    return;
+                }
+                batch = queue.front();
+                queue.pop_front();
+            }
+
+            bool ok = true;
+            for (size_t k = 0; k < batch.count && ok; ++k) {
+                const std::string& chunk = buffers[batch.slot][k];
+                ok = sink.write(chunk.data(), chunk.size());
+                if (ok && onChunkWritten) {
+                    onChunkWritten(batch.firstChunk + k);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            slotBusy[batch.slot] = false;
+            if (!ok && !failed) {
+                failed = true;
+                failure = "Failed to write export data";
+            }
+            changed.notify_all();
+        }
+    }
+};
+
+ChunkedExport::Writer::Writer(ByteSink& sink, ChunkWrittenFn onChunkWritten, const Options& options)
+    : impl(std::make_unique<Impl>(sink, std::move(onChunkWritten), options.cancellation)),
+      batchSize(options.batchChunks > 0 ? options.batchChunks : ThreadPool::shared().size() + 1) {
+    impl->buffers[0].resize(batchSize);
+    impl->buffers[1].resize(batchSize);
+    impl->writer = std::thread([this]() { impl->writeLoop(); });
+}
+
+ChunkedExport::Writer::~Writer() {
+    if (impl->writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            impl->producerDone = true;
+            impl->discard = true;
+            impl->changed.notify_all();
+        }
+        impl->writer.join();
+    }
+}
+
+bool ChunkedExport::Writer::submit(size_t count, const FormatFn& format) {
+    Impl& state = *impl;
+    const size_t slot = state.nextSlot;
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.changed.wait(lock, [&] { return !state.slotBusy[slot] || state.failed; });
+        if (state.failed || state.producerDone) {
+            return false;
+        }
+    }
+    if (state.cancellation.isCancelled()) {
+        state.fail("Export cancelled");
+        return false;
+    }
+
+    count = std::min(count, batchSize);
+    std::vector<std::string>& slotBuffers = state.buffers[slot];
+    try {
+        ThreadPool::shared().parallelFor(count, [&](size_t k) {
+            std::string& out = slotBuffers[k];
+            out.clear();
+            format(k, out);
+        });
+    } catch (const std::exception& e) {
+        state.fail(std::string("Failed to format export data: ") + e.what());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.slotBusy[slot] = true;
+    state.queue.push_back({slot, state.nextChunk, count});
+    state.nextChunk += count;
+    state.nextSlot = 1 - slot;
+    state.changed.notify_all();
+    return true;
+}
+
+bool ChunkedExport::Writer::finish(std::string* error) {
+    Impl& state = *impl;
+    if (state.writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.producerDone = true;
+            state.changed.notify_all();
+        }
+        state.writer.join();
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.failed && error) {
+        *error = state.failure;
+    }
+    return !state.failed;
+}
+
+bool ChunkedExport::run(size_t chunkCount, const FormatFn& format, ByteSink& sink,
+                        const ChunkWrittenFn& onChunkWritten, const Options& options,
+                        std::string* error) {
+    Writer writer(sink, onChunkWritten, options);
+    const size_t batchChunks = writer.batchChunks();
+    for (size_t first = 0; first < chunkCount; first += batchChunks) {
+        bool submitted = writer.submit(std::min(batchChunks, chunkCount - first),
+                                       [&](size_t k, std::string& out) { format(first + k, out); });
+        if (!submitted) {
+            break;
+        }
+    }
+    return writer.finish(error);
+}
@@ -2,11 +2,182 @@
 #include "../../utils/include/logger.h"
 #include "../../models/include/physics_constants.h"
 #include "../../utils/include/statistics_utils.h"
+#include "../../utils/include/fft_plan.h"
+#include "../../utils/include/least_squares.h"
+#include "../../utils/include/cubic_spline.h"
+#include "../../utils/include/kd_tree.h"
+#include "../../utils/include/math_utils.h"
+#include "../../utils/include/sliding_median.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <stdexcept>
-#include <set>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief 计算Savitzky-Golay卷积系数
+ *
+ * 对窗口内每个求值位置r（0..window-1）求一行系数，使
+ * y[r] = sum_j c[r][j] * x[j] 等于对窗口做order阶最小二乘多项式拟合后在r处的值。
+ * 中心行用于内部样本，其余行用于序列两端，避免边缘截断带来的偏差。
+ * 返回按行存放的 window*window 系数。
+ */
+std::vector<double> computeSavitzkyGolayCoefficients(int window, int order) {
+    const int half = window / 2;
+    const int terms = order + 1;
+    const double scale = half > 0 ? static_cast<double>(half) : 1.0;
+
+    // 设计矩阵 A[j][k] = t_j^k，t缩放到[-1, 1]以改善条件数
+    std::vector<double> a(static_cast<size_t>(window) * terms);
+    for (int j = 0; j < window; ++j) {
+        double t = (j - half) / scale;
+        double p = 1.0;
+        for (int k = 0; k < terms; ++k) {
+            a[j * terms + k] = p;
+            p *= t;
+        }
+    }
+
+    // 法方程矩阵 A^T A 并用Gauss-Jordan求逆（terms很小）
+    std::vector<double> ata(terms * terms, 0.0);
+    for (int r = 0; r < terms; ++r) {
+        for (int c = 0; c < terms; ++c) {
+            double sum = 0.0;
+            for (int j = 0; j < window; ++j) {
+                sum += a[j * terms + r] * a[j * terms + c];
+            }
+            ata[r * terms + c] = sum;
+        }
+    }
+
+    std::vector<double> inv(terms * terms, 0.0);
+    for (int i = 0; i < terms; ++i) inv[i * terms + i] = 1.0;
+
+    for (int col = 0; col < terms; ++col) {
+        int pivot = col;
+        for (int r = col + 1; r < terms; ++r) {
+            if (std::abs(ata[r * terms + col]) > std::abs(ata[pivot * terms + col])) {
+                pivot = r;
+            }
+        }
+        if (pivot != col) {
+            for (int c = 0; c < terms; ++c) {
+                std::swap(ata[col * terms + c], ata[pivot * terms + c]);
+                std::swap(inv[col * terms + c], inv[pivot * terms + c]);
+            }
+        }
+
+        double diag = ata[col * terms + col];
+        for (int c = 0; c < terms; ++c) {
+            ata[col * terms + c] /= diag;
+            inv[col * terms + c] /= diag;
+        }
+
+        for (int r = 0; r < terms; ++r) {
+            if (r == col) continue;
+            double factor = ata[r * terms + col];
+            if (factor == 0.0) continue;
+            for (int c = 0; c < terms; ++c) {
+                ata[r * terms + c] -= factor * ata[col * terms + c];
+                inv[r * terms + c] -= factor * inv[col * terms + c];
+            }
+        }
+    }
+
+    // 系数行 c_r = a_r^T (A^T A)^-1 A^T
+    std::vector<double> coefficients(static_cast<size_t>(window) * window);
+    std::vector<double> g(terms);
+    for (int r = 0; r < window; ++r) {
+        for (int k = 0; k < terms; ++k) {
+            double sum = 0.0;
+            for (int m = 0; m < terms; ++m) {
+                sum += a[r * terms + m] * inv[m * terms + k];
+            }
+            g[k] = sum;
+        }
+        for (int j = 0; j < window; ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < terms; ++k) {
+                sum += g[k] * a[j * terms + k];
+            }
+            coefficients[static_cast<size_t>(r) * window + j] = sum;
+        }
+    }
+
+    return coefficients;
+}
+
+std::shared_ptr<const std::vector<double>> savitzkyGolayCoefficients(int window, int order) {
+    static std::mutex cacheMutex;
+    static std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double>>> cache;
+
+    auto key = std::make_pair(window, order);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    auto coefficients = std::make_shared<const std::vector<double>>(
+        computeSavitzkyGolayCoefficients(window, order));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache.emplace(key, coefficients).first->second;
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief 由两个零填充实数序列的单边频谱计算线性互相关
+ *
+ * 逆变换得到循环相关 c[k] = Σ x[t]·y[(t+k) mod m]；m ≥ 2n-1 时没有混叠，
+ * 非负时滞位于 c[0..n-1]，负时滞 -k 位于 c[m-k]。out按时滞 -(n-1)..(n-1) 存放2n-1个值。
+ */
+void correlateSpectra(const std::complex<double>* x, const std::complex<double>* y, const FFTPlan& plan,
+                      size_t n, std::vector<std::complex<double>>& work, double* out) {
+    const size_t m = plan.size();
+    const size_t half = m / 2;
+    work.resize(m);
+    for (size_t k = 0; k <= half; ++k) {
+        work[k] = std::conj(x[k]) * y[k];
+    }
+    for (size_t k = half + 1; k < m; ++k) {
+        work[k] = std::conj(work[m - k]);
+    }
+    plan.inverse(work.data());
+
+    for (size_t k = 0; k < n; ++k) {
+        out[n - 1 + k] = work[k].real();
+    }
+    for (size_t k = 1; k < n; ++k) {
+        out[n - 1 - k] = work[m - k].real();
+    }
+}
+
+std::vector<std::complex<double>> paddedSpectrum(const std::vector<double>& values, const FFTPlan& plan) {
+    std::vector<double> padded(plan.size(), 0.0);
+    std::copy(values.begin(), values.begin() + std::min(values.size(), plan.size()), padded.begin());
+    std::vector<std::complex<double>> spectrum(plan.size() / 2 + 1);
+    plan.forwardReal(padded.data(), spectrum.data());
+    return spectrum;
+}
+
+} // namespace
 
 DataProcessor::DataProcessor() {
     workBuffer.reserve(10000); 
@@ -15,6 +186,53 @@ DataProcessor::DataProcessor() {
 
 DataProcessor::~DataProcessor() = default;
 
+void DataProcessor::setExecutionPolicy(const ExecutionPolicy& policy) {
+    executionPolicy = policy;
+    if (executionPolicy.chunkSize == 0) {
+        executionPolicy.chunkSize = ExecutionPolicy().chunkSize;
+    }
+}
+
+size_t DataProcessor::chunkCountFor(size_t rows) const {
+    return (rows + executionPolicy.chunkSize - 1) / executionPolicy.chunkSize;
+}
+
+bool DataProcessor::forEachChunk(size_t chunkCount, const std::function<void(size_t)>& fn,
+                                 int maxThreads) const {
+    // 块划分由调用方决定、与线程数无关，保证结果可复现
+    const ExecutionPolicy& policy = executionPolicy;
+    std::atomic<size_t> completed{0};
+    std::mutex progressMutex;
+    size_t reported = 0;
+    
+    auto runChunk = [&](size_t chunk) {
+        if (policy.cancellation.isCancelled()) {
+            return;
+        }
+        fn(chunk);
+        ++completed;
+        if (policy.progress) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            policy.progress(++reported, chunkCount);
+        }
+    };
+    
+    int threads = maxThreads > 0 ? maxThreads : policy.maxThreads;
+    if (!policy.parallel || threads == 1 || chunkCount <= 1) {
+        for (size_t c = 0; c < chunkCount; ++c) {
+            runChunk(c);
+        }
+    } else {
+        ThreadPool::shared().parallelFor(chunkCount, runChunk, threads > 0 ? threads : 0);
+    }
+    
+    if (completed < chunkCount) {
+        LOG_WARNING("Data processing cancelled");
+        return false;
+    }
+    return true;
+}
+
 DataStatistics DataProcessor::calculateStatistics(const std::vector<MeasurementData>& data) {
     DataStatistics stats{};
     
@@ -22,67 +240,161 @@ DataStatistics DataProcessor::calculateStatistics(const std::vector<MeasurementD
         return stats;
     }
     
-    auto heights = extractFieldValues(data, DataField::HEIGHT);
-    auto angles = extractFieldValues(data, DataField::ANGLE);
-    auto capacitances = extractFieldValues(data, DataField::CAPACITANCE);
+    auto moments = computeMoments(data, statisticsFields());
+    if (moments.count() == 0) {
+        return stats;
+    }
+    
+    stats = statisticsFromMoments(moments);
+    stats.firstRecordTime = data.front().getTimestamp();
+    stats.lastRecordTime = data.back().getTimestamp();
+    stats.median = StatisticsUtils::median(extractFieldValues(data, DataField::HEIGHT));
 
-    stats.meanHeight = StatisticsUtils::mean(heights);
-    stats.meanAngle = StatisticsUtils::mean(angles);
-    stats.meanCapacitance = StatisticsUtils::mean(capacitances);
+    return stats;
+}
 
-    stats.stdDevHeight = StatisticsUtils::stdDev(heights, stats.meanHeight);
-    stats.stdDevAngle = StatisticsUtils::stdDev(angles, stats.meanAngle);
-    stats.stdDevCapacitance = StatisticsUtils::stdDev(capacitances, stats.meanCapacitance);
+const std::vector<DataField>& DataProcessor::statisticsFields() {
+    static const std::vector<DataField> fields = {
+        DataField::HEIGHT, DataField::ANGLE, DataField::CAPACITANCE, DataField::TEMPERATURE
+    };
+    return fields;
+}
 
-    auto [minH, maxH] = std::minmax_element(heights.begin(), heights.end());
-    stats.minHeight = *minH;
-    stats.maxHeight = *maxH;
+DataStatistics DataProcessor::statisticsFromMoments(const RunningMoments& moments) const {
+    DataStatistics stats{};
+    if (moments.count() == 0 || moments.dimensions() != statisticsFields().size()) {
+        return stats;
+    }
     
-    auto [minA, maxA] = std::minmax_element(angles.begin(), angles.end());
-    stats.minAngle = *minA;
-    stats.maxAngle = *maxA;
+    enum { H, A, C, T };
+    stats.dataCount = static_cast<int>(moments.count());
     
-    auto [minC, maxC] = std::minmax_element(capacitances.begin(), capacitances.end());
-    stats.minCapacitance = *minC;
-    stats.maxCapacitance = *maxC;
+    stats.meanHeight = moments.mean(H);
+    stats.stdDevHeight = moments.stdDev(H);
+    stats.minHeight = moments.min(H);
+    stats.maxHeight = moments.max(H);
+    
+    stats.meanAngle = moments.mean(A);
+    stats.stdDevAngle = moments.stdDev(A);
+    stats.minAngle = moments.min(A);
+    stats.maxAngle = moments.max(A);
+    
+    stats.meanCapacitance = moments.mean(C);
+    stats.stdDevCapacitance = moments.stdDev(C);
+    stats.minCapacitance = moments.min(C);
+    stats.maxCapacitance = moments.max(C);
+    
+    stats.meanTemperature = moments.mean(T);
+    stats.stdDevTemperature = moments.stdDev(T);
+    stats.minTemperature = moments.min(T);
+    stats.maxTemperature = moments.max(T);
+    
+    stats.variance = moments.variance(H);
+    stats.skewness = moments.skewness(H);
+    stats.kurtosis = moments.kurtosis(H);
     
-    stats.variance = StatisticsUtils::variance(heights, stats.meanHeight);
-    stats.skewness = StatisticsUtils::skewness(heights, stats.meanHeight, stats.stdDevHeight);
-    stats.kurtosis = StatisticsUtils::kurtosis(heights, stats.meanHeight, stats.stdDevHeight);
-
     return stats;
 }
 
+LinearRegression DataProcessor::regressionFromMoments(const RunningMoments& moments) const {
+    LinearRegression result{};
+    if (moments.count() < 2 || moments.dimensions() != 2) {
+        return result;
+    }
+    
+    double varianceX = moments.variance(0);
+    if (varianceX < 1e-10) {
+        LOG_WARNING("Near-zero denominator in linear regression");
+        return result;
+    }
+    
+    // 残差平方和由矩直接得到：SSR = Syy - Sxy²/Sxx
+    double n = static_cast<double>(moments.count());
+    double sxx = varianceX * (n - 1.0);
+    double syy = moments.variance(1) * (n - 1.0);
+    double sxy = moments.covariance(0, 1) * (n - 1.0);
+    double ssResidual = std::max(0.0, syy - sxy * sxy / sxx);
+    
+    result.slope = sxy / sxx;
+    result.intercept = moments.mean(1) - result.slope * moments.mean(0);
+    result.rSquared = syy > 0 ? 1.0 - ssResidual / syy : 0.0;
+    result.standardError = n > 2 ? std::sqrt(ssResidual / (n - 2)) : 0.0;
+    
+    return result;
+}
+
 double DataProcessor::calculateCorrelation(const std::vector<MeasurementData>& data,
                                          DataField field1, DataField field2) {
     if (data.size() < 2) {
         return 0.0;
     }
     
-    auto values1 = extractFieldValues(data, field1);
-    auto values2 = extractFieldValues(data, field2);
+    return computeMoments(data, {field1, field2}).correlation(0, 1);
+}
+
+CorrelationMatrix DataProcessor::calculateCorrelationMatrix(const std::vector<MeasurementData>& data,
+                                                            const std::vector<DataField>& fields) {
+    static const std::vector<DataField> numericFields = {
+        DataField::HEIGHT, DataField::ANGLE, DataField::CAPACITANCE, DataField::TEMPERATURE,
+        DataField::UPPER_SENSOR_1, DataField::UPPER_SENSOR_2,
+        DataField::LOWER_SENSOR_1, DataField::LOWER_SENSOR_2
+    };
     
-    double mean1 = calculateMean(values1);
-    double mean2 = calculateMean(values2);
+    CorrelationMatrix matrix;
+    matrix.fields = fields.empty() ? numericFields : fields;
+    
+    auto moments = computeMoments(data, matrix.fields);
+    const size_t d = matrix.fields.size();
+    matrix.sampleCount = moments.count();
+    matrix.covariance.resize(d * d);
+    matrix.correlation.resize(d * d);
+    for (size_t i = 0; i < d; ++i) {
+        for (size_t j = 0; j < d; ++j) {
+            matrix.covariance[i * d + j] = moments.covariance(i, j);
+            matrix.correlation[i * d + j] = moments.correlation(i, j);
+        }
+    }
     
-    double covariance = 0.0;
-    double variance1 = 0.0;
-    double variance2 = 0.0;
+    return matrix;
+}
+
+RunningMoments DataProcessor::computeMoments(const std::vector<MeasurementData>& data,
+                                             const std::vector<DataField>& fields) const {
+    // 单次遍历所有字段；数据分块统计后按块序合并，结果与线程数无关
+    const size_t chunkSize = executionPolicy.chunkSize;
+    const size_t dims = fields.size();
+    const size_t chunkCount = chunkCountFor(data.size());
+    
+    std::vector<RunningMoments> partials(chunkCount, RunningMoments(dims));
+    bool completed = forEachChunk(chunkCount, [&](size_t chunk) {
+        // 按行块逐字段提取（每块每字段分派一次），再逐行累加
+        constexpr size_t blockSize = 256;
+        RunningMoments& moments = partials[chunk];
+        std::vector<double> block(dims * blockSize);
+        std::vector<double> row(dims);
+        size_t end = std::min(data.size(), (chunk + 1) * chunkSize);
+        for (size_t begin = chunk * chunkSize; begin < end; begin += blockSize) {
+            size_t len = std::min(blockSize, end - begin);
+            for (size_t f = 0; f < dims; ++f) {
+                gatherField(fields[f], data.data() + begin, len, block.data() + f * blockSize);
+            }
+            for (size_t i = 0; i < len; ++i) {
+                for (size_t f = 0; f < dims; ++f) {
+                    row[f] = block[f * blockSize + i];
+                }
+                moments.add(row.data());
+            }
+        }
+    });
     
-    for (size_t i = 0; i < values1.size(); ++i) {
-        double diff1 = values1[i] - mean1;
-        double diff2 = values2[i] - mean2;
-        
-        covariance += diff1 * diff2;
-        variance1 += diff1 * diff1;
-        variance2 += diff2 * diff2;
+    RunningMoments total(dims);
+    if (!completed) {
+        return total;
     }
-    
-    if (variance1 * variance2 == 0) {
-        return 0.0;
+    for (const auto& partial : partials) {
+        total.merge(partial);
     }
-    
-    return covariance / std::sqrt(variance1 * variance2);
+    return total;
 }
 
 LinearRegression DataProcessor::performLinearRegression(const std::vector<MeasurementData>& data,
@@ -94,116 +406,173 @@ LinearRegression DataProcessor::performLinearRegression(const std::vector<Measur
         return result;
     }
     
-    auto xValues = extractFieldValues(data, xField);
-    auto yValues = extractFieldValues(data, yField);
-    
-    double n = static_cast<double>(data.size());
-    double sumX = 0.0, sumY = 0.0, sumXY = 0.0, sumX2 = 0.0;
-    
-    for (size_t i = 0; i < xValues.size(); ++i) {
-        sumX += xValues[i];
-        sumY += yValues[i];
-        sumXY += xValues[i] * yValues[i];
-        sumX2 += xValues[i] * xValues[i];
+    // 均值和协矩分块累加后合并，避免 n*Σx² - (Σx)² 的抵消误差
+    RunningMoments moments = computeMoments(data, {xField, yField});
+    if (moments.count() < 2) {
+        return result;
     }
     
-
-    double denominator = n * sumX2 - sumX * sumX;
-    if (std::abs(denominator) < 1e-10) {
-        LOG_WARNING("Near-zero denominator in linear regression");
+    double n = static_cast<double>(moments.count());
+    result = regressionFromMoments(moments);
+    if (moments.variance(0) < 1e-10) {
         return result;
     }
     
-    result.slope = (n * sumXY - sumX * sumY) / denominator;
-    result.intercept = (sumY - result.slope * sumX) / n;
+    // 残差同样分块计算，各块的残差平方和按块序累加
+    const size_t chunkSize = executionPolicy.chunkSize;
+    const size_t chunkCount = chunkCountFor(data.size());
+    std::vector<double> chunkResiduals(chunkCount, 0.0);
+    result.residuals.resize(data.size());
+    
+    bool completed = forEachChunk(chunkCount, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t len = std::min(data.size(), begin + chunkSize) - begin;
+        // 先把x、y写入残差数组和临时列，再在连续数组上计算
+        double* residuals = result.residuals.data() + begin;
+        std::vector<double> x(len);
+        gatherField(xField, data.data() + begin, len, x.data());
+        gatherField(yField, data.data() + begin, len, residuals);
+        double ss = 0.0;
+        for (size_t i = 0; i < len; ++i) {
+            double residual = residuals[i] - (result.slope * x[i] + result.intercept);
+            residuals[i] = residual;
+            ss += residual * residual;
+        }
+        chunkResiduals[chunk] = ss;
+    });
+    if (!completed) {
+        return LinearRegression{};
+    }
     
-
-    double ssTotal = 0.0, ssResidual = 0.0;
-    double meanY = sumY / n;
+    double ssResidual = std::accumulate(chunkResiduals.begin(), chunkResiduals.end(), 0.0);
+    double ssTotal = moments.variance(1) * (n - 1.0);
     
-    result.residuals.reserve(xValues.size());
+    result.rSquared = (ssTotal > 0) ? 1.0 - (ssResidual / ssTotal) : 0.0;
+    result.standardError = n > 2 ? std::sqrt(ssResidual / (n - 2)) : 0.0;
     
-    for (size_t i = 0; i < xValues.size(); ++i) {
-        double predicted = result.slope * xValues[i] + result.intercept;
-        double residual = yValues[i] - predicted;
-        
-        result.residuals.push_back(residual);
-        ssResidual += residual * residual;
-        ssTotal += (yValues[i] - meanY) * (yValues[i] - meanY);
+    return result;
+}
+
+LinearRegression DataProcessor::linearRegression(const std::vector<double>& x,
+                                                 const std::vector<double>& y) const {
+    if (x.size() != y.size() || x.size() < 2) {
+        LOG_WARNING("Insufficient data for linear regression");
+        return LinearRegression{};
     }
     
-    result.rSquared = (ssTotal > 0) ? 1.0 - (ssResidual / ssTotal) : 0.0;
-    result.standardError = std::sqrt(ssResidual / (n - 2));
+    RunningMoments moments(2);
+    for (size_t i = 0; i < x.size(); ++i) {
+        double row[2] = {x[i], y[i]};
+        moments.add(row);
+    }
+    
+    LinearRegression result = regressionFromMoments(moments);
+    if (moments.variance(0) < 1e-10) {
+        return result;
+    }
     
+    result.residuals.resize(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        result.residuals[i] = y[i] - (result.slope * x[i] + result.intercept);
+    }
     return result;
 }
 
 PolynomialFit DataProcessor::performPolynomialFitting(const std::vector<MeasurementData>& data,
     DataField xField, DataField yField, int degree) {
-    PolynomialFit result;
+    auto columns = extractColumns(data, {xField, yField});
+    return fitPolynomial(columns.values[0], columns.values[1], degree);
+}
+
+PolynomialFit DataProcessor::fitPolynomial(const std::vector<double>& x, const std::vector<double>& y,
+                                           int degree, const std::vector<double>& weights) const {
+    PolynomialFit result{};
     result.degree = degree;
 
-    if (data.size() < static_cast<size_t>(degree + 1)) {
-        LOG_WARNING("Insufficient data for polynomial fitting");
+    if (x.size() != y.size() || (!weights.empty() && weights.size() != x.size())) {
+        LOG_WARNING("Mismatched input sizes for polynomial fitting");
         return result;
     }
 
-    auto xValues = extractFieldValues(data, xField);
-    auto yValues = extractFieldValues(data, yField);
-
-    int n = data.size();
-    int m = degree + 1;
-
-    std::vector<std::vector<double>> vandermonde(n, std::vector<double>(m));
-    for (int i = 0; i < n; ++i) {
-        vandermonde[i][0] = 1.0;
-        for (int j = 1; j < m; ++j) {
-            vandermonde[i][j] = vandermonde[i][j-1] * xValues[i];
-        }
+    std::vector<double> coefficients;
+    if (!LeastSquaresSolver::fitPolynomial(x.data(), y.data(), weights.empty() ? nullptr : weights.data(),
+                                           x.size(), degree, coefficients)) {
+        LOG_WARNING("Insufficient data for polynomial fitting");
+        return result;
     }
 
+    return evaluateFit(std::move(coefficients), degree, x, y, weights);
+}
 
-    std::vector<std::vector<double>> ata(m, std::vector<double>(m, 0.0));
-    std::vector<double> atb(m, 0.0);
-
-
-    for (int i = 0; i < m; ++i) {
-        for (int j = 0; j < m; ++j) {
-            for (int k = 0; k < n; ++k) {
-                ata[i][j] += vandermonde[k][i] * vandermonde[k][j];
-            }
-        }
+std::vector<PolynomialFit> DataProcessor::fitPolynomialBatch(const std::vector<PolynomialSeries>& series,
+                                                             int degree) const {
+    // 各序列相互独立，每个序列作为一个块
+    std::vector<PolynomialFit> results(series.size());
+    if (!forEachChunk(series.size(), [&](size_t i) {
+            results[i] = fitPolynomial(series[i].x, series[i].y, degree, series[i].weights);
+        })) {
+        return {};
+    }
+    return results;
+}
 
-        for (int k = 0; k < n; ++k) {
-            atb[i] += vandermonde[k][i] * yValues[k];
-        }
+std::vector<PolynomialFit> DataProcessor::fitPolynomialBatch(const std::vector<double>& x,
+                                                             const std::vector<std::vector<double>>& ySeries,
+                                                             int degree) const {
+    // 所有序列共用自变量时只需分解一次Vandermonde矩阵
+    std::vector<std::vector<double>> coefficients;
+    if (!LeastSquaresSolver::fitPolynomials(x, ySeries, degree, coefficients)) {
+        LOG_WARNING("Invalid input for batched polynomial fitting");
+        std::vector<PolynomialFit> empty(ySeries.size(), PolynomialFit{});
+        for (auto& fit : empty) fit.degree = degree;
+        return empty;
     }
 
-    result.coefficients = gaussianElimination(ata, atb);
+    std::vector<PolynomialFit> results;
+    results.reserve(ySeries.size());
+    for (size_t s = 0; s < ySeries.size(); ++s) {
+        results.push_back(evaluateFit(std::move(coefficients[s]), degree, x, ySeries[s], {}));
+    }
+    return results;
+}
 
+PolynomialFit DataProcessor::evaluateFit(std::vector<double> coefficients, int degree,
+                                         const std::vector<double>& x, const std::vector<double>& y,
+                                         const std::vector<double>& weights) const {
+    PolynomialFit result{};
+    result.degree = degree;
+    result.coefficients = std::move(coefficients);
+
+    // 加权决定系数与均方根误差（等权时与普通定义一致）
+    double sumW = 0.0, sumWY = 0.0;
+    for (size_t i = 0; i < y.size(); ++i) {
+        double w = weights.empty() ? 1.0 : weights[i];
+        sumW += w;
+        sumWY += w * y[i];
+    }
+    if (sumW <= 0.0) {
+        return result;
+    }
+    double meanY = sumWY / sumW;
 
     double ssTotal = 0.0, ssResidual = 0.0;
-    double meanY = calculateMean(yValues);
-
-    for (size_t i = 0; i < xValues.size(); ++i) {
-    double predicted = predict(result, xValues[i]);
-    double residual = yValues[i] - predicted;
-
-    ssResidual += residual * residual;
-    ssTotal += (yValues[i] - meanY) * (yValues[i] - meanY);
+    for (size_t i = 0; i < x.size(); ++i) {
+        double w = weights.empty() ? 1.0 : weights[i];
+        double residual = y[i] - predict(result, x[i]);
+        ssResidual += w * residual * residual;
+        ssTotal += w * (y[i] - meanY) * (y[i] - meanY);
     }
 
     result.rSquared = (ssTotal > 0) ? 1.0 - (ssResidual / ssTotal) : 0.0;
-    result.rmse = std::sqrt(ssResidual / n);
-
+    result.rmse = std::sqrt(ssResidual / sumW);
     return result;
 }
 
-double DataProcessor::predict(const LinearRegression& model, double x) {
+double DataProcessor::predict(const LinearRegression& model, double x) const {
     return model.slope * x + model.intercept;
 }
 
-double DataProcessor::predict(const PolynomialFit& model, double x) {
+double DataProcessor::predict(const PolynomialFit& model, double x) const {
     double result = 0.0;
     double xPower = 1.0;
     
@@ -216,50 +585,122 @@ double DataProcessor::predict(const PolynomialFit& model, double x) {
 }
 
 std::vector<MeasurementData> DataProcessor::smoothData(const std::vector<MeasurementData>& data,
-                                                      SmoothingMethod method, int windowSize) {
+                                                      SmoothingMethod method, int windowSize,
+                                                      int polynomialOrder) {
     if (data.empty() || windowSize <= 0) {
         return data;
     }
     
+    auto columns = smoothColumns(data, method, windowSize, polynomialOrder);
+    if (columns.rows == 0) {
+        return {};
+    }
+    
     std::vector<MeasurementData> smoothed = data;
+    writeColumns(smoothed, columns);
     
+    return smoothed;
+}
 
-    std::vector<DataField> fieldsToSmooth = {
+MeasurementColumns DataProcessor::smoothColumns(const std::vector<MeasurementData>& data,
+                                                SmoothingMethod method, int windowSize,
+                                                int polynomialOrder,
+                                                const std::vector<DataField>& fields,
+                                                bool parallel) {
+    static const std::vector<DataField> defaultFields = {
         DataField::HEIGHT, DataField::ANGLE, DataField::CAPACITANCE,
         DataField::UPPER_SENSOR_1, DataField::UPPER_SENSOR_2,
         DataField::LOWER_SENSOR_1, DataField::LOWER_SENSOR_2
     };
     
-    for (auto field : fieldsToSmooth) {
-        auto values = extractFieldValues(data, field);
-        std::vector<double> smoothedValues;
-        
-        switch (method) {
-            case SmoothingMethod::MOVING_AVERAGE:
-                smoothedValues = movingAverage(values, windowSize);
-                break;
-                
-            case SmoothingMethod::GAUSSIAN:
-                smoothedValues = gaussianSmooth(values, windowSize, windowSize / 3.0);
-                break;
-                
-            case SmoothingMethod::MEDIAN:
-                smoothedValues = medianFilter(values, windowSize);
-                break;
-                
-            case SmoothingMethod::SAVITZKY_GOLAY:
-                // Savitzky-Golay需要更复杂的实现
-                smoothedValues = movingAverage(values, windowSize);
-                break;
+    MeasurementColumns columns = extractColumns(data, fields.empty() ? defaultFields : fields);
+    if (columns.rows == 0 || windowSize <= 0) {
+        return columns;
+    }
+    
+    // 各字段相互独立，可分配到不同线程；结果直接替换对应列
+    auto smoothColumn = [&](size_t f) {
+        columns.values[f] = smoothValues(columns.values[f], method, windowSize, polynomialOrder);
+    };
+    
+    if (!forEachChunk(columns.fields.size(), smoothColumn, parallel ? 0 : 1)) {
+        return MeasurementColumns{};
+    }
+    
+    return columns;
+}
+
+void DataProcessor::writeColumns(std::vector<MeasurementData>& data, const MeasurementColumns& columns,
+                                 bool physical) const {
+    // 单次遍历写回：每条记录只复制并更新一次SensorData
+    std::vector<double SensorData::*> members(columns.fields.size(), nullptr);
+    const std::vector<double>* heights = nullptr;
+    const std::vector<double>* angles = nullptr;
+    for (size_t f = 0; f < columns.fields.size(); ++f) {
+        switch (columns.fields[f]) {
+            case DataField::HEIGHT: heights = &columns.values[f]; break;
+            case DataField::ANGLE: angles = &columns.values[f]; break;
+            case DataField::CAPACITANCE: members[f] = &SensorData::capacitance; break;
+            case DataField::TEMPERATURE: members[f] = &SensorData::temperature; break;
+            case DataField::UPPER_SENSOR_1: members[f] = &SensorData::distanceUpper1; break;
+            case DataField::UPPER_SENSOR_2: members[f] = &SensorData::distanceUpper2; break;
+            case DataField::LOWER_SENSOR_1: members[f] = &SensorData::distanceLower1; break;
+            case DataField::LOWER_SENSOR_2: members[f] = &SensorData::distanceLower2; break;
+            case DataField::TIMESTAMP: break;
         }
-        
-        // 将平滑后的值写回
-        for (size_t i = 0; i < smoothed.size(); ++i) {
-            setFieldValue(smoothed[i], field, smoothedValues[i]);
+    }
+    
+    for (size_t i = 0; i < data.size() && i < columns.rows; ++i) {
+        MeasurementData& m = data[i];
+        SensorData sensor = m.getSensorData();
+        for (size_t f = 0; f < members.size(); ++f) {
+            if (members[f]) {
+                sensor.*members[f] = columns.values[f][i];
+            }
+        }
+        m.updateSensorData(sensor);
+        if (!physical) {
+            m.setRawPosition(heights ? (*heights)[i] : m.getSetHeight(),
+                             angles ? (*angles)[i] : m.getSetAngle());
+            continue;
+        }
+        if (heights) m.setHeight((*heights)[i]);
+        if (angles) m.setAngle((*angles)[i]);
+    }
+}
+
+MeasurementColumns DataProcessor::extractColumns(const std::vector<MeasurementData>& data,
+                                                 const std::vector<DataField>& fields) const {
+    MeasurementColumns columns;
+    columns.fields = fields;
+    columns.rows = data.size();
+    columns.values.assign(fields.size(), std::vector<double>(data.size()));
+    
+    // 按行块转置：每块内各字段依次写入，块内数据保持在缓存中
+    constexpr size_t blockSize = 1024;
+    for (size_t begin = 0; begin < data.size(); begin += blockSize) {
+        size_t len = std::min(blockSize, data.size() - begin);
+        for (size_t f = 0; f < fields.size(); ++f) {
+            gatherField(fields[f], data.data() + begin, len, columns.values[f].data() + begin);
         }
     }
     
-    return smoothed;
+    return columns;
+}
+
+std::vector<double> DataProcessor::smoothValues(const std::vector<double>& values, SmoothingMethod method,
+                                                int windowSize, int polynomialOrder) const {
+    switch (method) {
+        case SmoothingMethod::MOVING_AVERAGE:
+            return movingAverage(values, windowSize);
+        case SmoothingMethod::GAUSSIAN:
+            return gaussianSmooth(values, windowSize, windowSize / 3.0);
+        case SmoothingMethod::MEDIAN:
+            return medianFilter(values, windowSize);
+        case SmoothingMethod::SAVITZKY_GOLAY:
+            return savitzkyGolay(values, windowSize, polynomialOrder);
+    }
+    return values;
 }
 
 std::vector<size_t> DataProcessor::detectOutliers(const std::vector<MeasurementData>& data,
@@ -270,16 +711,35 @@ std::vector<size_t> DataProcessor::detectOutliers(const std::vector<MeasurementD
         return outliers;
     }
     
-    auto values = extractFieldValues(data, field);
-    double mean = calculateMean(values);
-    double stdDev = calculateStdDev(values, mean);
+    RunningMoments moments = computeMoments(data, {field});
+    double mean = moments.mean();
+    double stdDev = moments.stdDev();
+    if (moments.count() == 0 || stdDev <= 0.0) {
+        return outliers;
+    }
     
-    // Z-score方法检测异常值
-    for (size_t i = 0; i < values.size(); ++i) {
-        double zScore = std::abs((values[i] - mean) / stdDev);
-        if (zScore > threshold) {
-            outliers.push_back(i);
-        }
+    // Z-score方法检测异常值；各块收集自己的下标，按块序拼接后仍为升序
+    const size_t chunkSize = executionPolicy.chunkSize;
+    const size_t chunkCount = chunkCountFor(data.size());
+    std::vector<std::vector<size_t>> chunkOutliers(chunkCount);
+    
+    bool completed = dispatchField(field, [&](auto tag) {
+        return forEachChunk(chunkCount, [&](size_t chunk) {
+            size_t end = std::min(data.size(), (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; ++i) {
+                double zScore = std::abs((getField(data[i], tag) - mean) / stdDev);
+                if (zScore > threshold) {
+                    chunkOutliers[chunk].push_back(i);
+                }
+            }
+        });
+    });
+    if (!completed) {
+        return outliers;
+    }
+    
+    for (const auto& part : chunkOutliers) {
+        outliers.insert(outliers.end(), part.begin(), part.end());
     }
     
     return outliers;
@@ -295,46 +755,84 @@ std::vector<MeasurementData> DataProcessor::interpolateData(const std::vector<Me
         return data;
     }
     
-    auto xValues = extractFieldValues(data, xField);
-    auto yValues = extractFieldValues(data, yField);
-    
-    // 找到x的范围
-    auto [minX, maxX] = std::minmax_element(xValues.begin(), xValues.end());
-    double xMin = *minX;
-    double xMax = *maxX;
-    double xStep = (xMax - xMin) / (numPoints - 1);
-    
-    std::vector<MeasurementData> interpolated;
-    
+    auto columns = extractColumns(data, {xField, yField});
+    std::vector<double>& xValues = columns.values[0];
+    std::vector<double>& yValues = columns.values[1];
+    
+    // 节点按x排序，重复的x取y的平均值
+    if (!std::is_sorted(xValues.begin(), xValues.end())) {
+        std::vector<size_t> order(xValues.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&](size_t l, size_t r) { return xValues[l] < xValues[r]; });
+        std::vector<double> sortedX(order.size()), sortedY(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sortedX[i] = xValues[order[i]];
+            sortedY[i] = yValues[order[i]];
+        }
+        xValues.swap(sortedX);
+        yValues.swap(sortedY);
+    }
+    size_t unique = 0;
+    for (size_t i = 0; i < xValues.size();) {
+        size_t j = i;
+        double sum = 0.0;
+        while (j < xValues.size() && xValues[j] == xValues[i]) {
+            sum += yValues[j++];
+        }
+        xValues[unique] = xValues[i];
+        yValues[unique] = sum / (j - i);
+        ++unique;
+        i = j;
+    }
+    xValues.resize(unique);
+    yValues.resize(unique);
+    
+    // 均匀网格
+    const double xMin = xValues.front();
+    const double xMax = xValues.back();
+    const double xStep = numPoints > 1 ? (xMax - xMin) / (numPoints - 1) : 0.0;
+    
+    MeasurementColumns output;
+    output.fields = {xField, yField};
+    output.rows = numPoints;
+    output.values.assign(2, std::vector<double>(numPoints));
+    double* gridX = output.values[0].data();
+    double* gridY = output.values[1].data();
     for (int i = 0; i < numPoints; ++i) {
-        double x = xMin + i * xStep;
-        double y = 0.0;
-        
-        switch (method) {
-            case InterpolationMethod::LINEAR:
-                // 找到相邻的两个点
-                for (size_t j = 1; j < xValues.size(); ++j) {
-                    if (x >= xValues[j-1] && x <= xValues[j]) {
-                        y = linearInterpolate(xValues[j-1], yValues[j-1], 
-                                            xValues[j], yValues[j], x);
-                        break;
-                    }
-                }
-                break;
-                
-            case InterpolationMethod::CUBIC:
-            case InterpolationMethod::SPLINE:
-                y = cubicInterpolate(xValues, yValues, x);
-                break;
+        gridX[i] = xMin + i * xStep;
+    }
+    gridX[numPoints - 1] = numPoints > 1 ? xMax : xMin;
+    
+    if (unique < 2) {
+        std::fill(gridY, gridY + numPoints, yValues.front());
+    } else if (method == InterpolationMethod::SPLINE) {
+        CubicSpline spline;
+        spline.build(xValues, yValues);
+        spline.evaluate(gridX, numPoints, gridY);
+    } else {
+        // 网格递增，区间游标只向前移动
+        size_t interval = 0;
+        const size_t lastInterval = unique - 2;
+        for (int i = 0; i < numPoints; ++i) {
+            double x = gridX[i];
+            while (interval < lastInterval && x > xValues[interval + 1]) {
+                ++interval;
+            }
+            
+            if (method == InterpolationMethod::CUBIC) {
+                gridY[i] = cubicInterpolate(xValues, yValues, interval, x);
+            } else {
+                gridY[i] = linearInterpolate(xValues[interval], yValues[interval],
+                                             xValues[interval + 1], yValues[interval + 1], x);
+            }
         }
-        
-        // 创建新的测量数据点
-        MeasurementData newPoint = data[0]; // 复制模板
-        setFieldValue(newPoint, xField, x);
-        setFieldValue(newPoint, yField, y);
-        interpolated.push_back(newPoint);
     }
     
+    // 以第一条记录为模板生成结果
+    std::vector<MeasurementData> interpolated(numPoints, data[0]);
+    writeColumns(interpolated, output);
+    
     return interpolated;
 }
 
@@ -348,21 +846,12 @@ FFTResult DataProcessor::performFFT(const std::vector<MeasurementData>& data, Da
     auto values = extractFieldValues(data, field);
     
     // 计算采样率
-    auto timestamps = extractFieldValues(data, DataField::TIMESTAMP);
-    double totalTime = (timestamps.back() - timestamps.front()) / 1000.0; // 转换为秒
-    result.samplingRate = (data.size() - 1) / totalTime;
-    
-    // 准备FFT输入（扩展到2的幂）
-    size_t n = 1;
-    while (n < values.size()) n *= 2;
-    
-    std::vector<std::complex<double>> fftData(n);
-    for (size_t i = 0; i < values.size(); ++i) {
-        fftData[i] = std::complex<double>(values[i], 0.0);
-    }
+    result.samplingRate = estimateSamplingRate(data);
     
-    // 执行FFT
-    auto spectrum = fft(fftData);
+    // 按实际长度变换（非2的幂长度由Bluestein处理，无需补零）
+    size_t n = values.size();
+    auto plan = FFTPlan::get(n);
+    auto spectrum = plan->forwardReal(values);
     
     // 计算频率和幅度
     result.frequencies.resize(n/2);
@@ -407,45 +896,456 @@ std::vector<size_t> DataProcessor::findPeaks(const FFTResult& fft, double thresh
     return peaks;
 }
 
-TrendAnalysis DataProcessor::analyzeTrend(const std::vector<MeasurementData>& data, DataField field) {
-    TrendAnalysis result;
-    
-    if (data.size() < 3) {
-        result.direction = TrendDirection::STABLE;
-        result.strength = 0.0;
-        return result;
+PowerSpectrum DataProcessor::performWelchPSD(const std::vector<MeasurementData>& data,
+                                             DataField field, const WelchOptions& options) {
+    if (data.size() < 2) {
+        return PowerSpectrum();
     }
     
     auto values = extractFieldValues(data, field);
+    return welchPSD(values, estimateSamplingRate(data), options);
+}
+
+PowerSpectrum DataProcessor::welchPSD(const std::vector<double>& values, double samplingRate,
+                                      const WelchOptions& options) const {
+    PowerSpectrum result;
+    result.samplingRate = samplingRate;
     
-    // 执行线性回归
-    std::vector<double> indices(values.size());
-    std::iota(indices.begin(), indices.end(), 0.0);
+    if (values.size() < 2 || samplingRate <= 0.0) {
+        return result;
+    }
     
-    // 计算线性趋势
-    double n = values.size();
-    double sumX = n * (n - 1) / 2;
-    double sumX2 = n * (n - 1) * (2 * n - 1) / 6;
-    double sumY = std::accumulate(values.begin(), values.end(), 0.0);
-    double sumXY = 0.0;
+    // 段长不超过数据长度，步长至少为1
+    size_t segmentLength = std::min(std::max<size_t>(options.segmentLength, 2), values.size());
+    double overlap = MathUtils::clamp(options.overlap, 0.0, 0.95);
+    size_t step = std::max<size_t>(1, static_cast<size_t>(segmentLength * (1.0 - overlap)));
+    size_t segmentCount = 1 + (values.size() - segmentLength) / step;
+    size_t bins = segmentLength / 2 + 1;
+    
+    auto window = createWindow(options.window, segmentLength);
+    double windowPower = 0.0;
+    for (double w : window) {
+        windowPower += w * w;
+    }
     
-    for (size_t i = 0; i < values.size(); ++i) {
-        sumXY += i * values[i];
+    // 单边谱：除直流和奈奎斯特频点外能量加倍
+    std::vector<double> scale(bins, 2.0 / (samplingRate * windowPower));
+    scale[0] /= 2.0;
+    if (segmentLength % 2 == 0) {
+        scale[bins - 1] /= 2.0;
     }
     
-    double slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-    double intercept = (sumY - slope * sumX) / n;
+    auto plan = FFTPlan::get(segmentLength);
     
-    // 确定趋势方向
-    if (std::abs(slope) < 0.001) {
-        result.direction = TrendDirection::STABLE;
-    } else if (slope > 0) {
-        result.direction = TrendDirection::INCREASING;
-    } else {
-        result.direction = TrendDirection::DECREASING;
+    bool useMedian = options.averaging == SpectralAveraging::MEDIAN;
+    std::vector<double> periodograms;
+    if (useMedian) {
+        periodograms.resize(segmentCount * bins);
     }
     
-    // 计算趋势强度（R²）
+    // 各段的FFT相互独立：按段分块并行，每块累加自己的周期图，最后按块序求和
+    constexpr size_t segmentsPerChunk = 64;
+    const size_t chunkCount = (segmentCount + segmentsPerChunk - 1) / segmentsPerChunk;
+    std::vector<std::vector<double>> chunkSums(chunkCount);
+    
+    bool completed = forEachChunk(chunkCount, [&](size_t chunk) {
+        std::vector<double> segment(segmentLength);
+        std::vector<std::complex<double>> spectrum(bins);
+        std::vector<double>& accumulated = chunkSums[chunk];
+        accumulated.assign(useMedian ? 0 : bins, 0.0);
+        
+        size_t lastSegment = std::min(segmentCount, (chunk + 1) * segmentsPerChunk);
+        for (size_t s = chunk * segmentsPerChunk; s < lastSegment; ++s) {
+            const double* source = values.data() + s * step;
+            
+            double mean = 0.0;
+            if (options.removeMean) {
+                mean = std::accumulate(source, source + segmentLength, 0.0) / segmentLength;
+            }
+            for (size_t i = 0; i < segmentLength; ++i) {
+                segment[i] = (source[i] - mean) * window[i];
+            }
+            
+            plan->forwardReal(segment.data(), spectrum.data());
+            
+            for (size_t k = 0; k < bins; ++k) {
+                double power = std::norm(spectrum[k]) * scale[k];
+                if (useMedian) {
+                    periodograms[k * segmentCount + s] = power;
+                } else {
+                    accumulated[k] += power;
+                }
+            }
+        }
+    });
+    if (!completed) {
+        return PowerSpectrum{};
+    }
+    
+    std::vector<double> accumulated(bins, 0.0);
+    if (!useMedian) {
+        for (const auto& partial : chunkSums) {
+            for (size_t k = 0; k < bins; ++k) {
+                accumulated[k] += partial[k];
+            }
+        }
+    }
+    
+    result.frequencies.resize(bins);
+    result.density.resize(bins);
+    
+    // 中位数平均需按段数校正偏差（与 scipy.signal.welch 一致）
+    double medianBias = 1.0;
+    if (useMedian) {
+        for (size_t i = 1; i <= (segmentCount - 1) / 2; ++i) {
+            double ii = 2.0 * i;
+            medianBias += 1.0 / (ii + 1.0) - 1.0 / ii;
+        }
+    }
+    
+    for (size_t k = 0; k < bins; ++k) {
+        result.frequencies[k] = k * samplingRate / segmentLength;
+        
+        if (useMedian) {
+            auto first = periodograms.begin() + k * segmentCount;
+            auto last = first + segmentCount;
+            auto mid = first + segmentCount / 2;
+            std::nth_element(first, mid, last);
+            double median = *mid;
+            if (segmentCount % 2 == 0) {
+                median = (median + *std::max_element(first, mid)) / 2.0;
+            }
+            result.density[k] = median / medianBias;
+        } else {
+            result.density[k] = accumulated[k] / segmentCount;
+        }
+    }
+    
+    result.segmentCount = static_cast<int>(segmentCount);
+    
+    if (bins > 1) {
+        auto maxIt = std::max_element(result.density.begin() + 1, result.density.end());
+        result.dominantFrequency = result.frequencies[std::distance(result.density.begin(), maxIt)];
+    }
+    
+    return result;
+}
+
+std::vector<double> DataProcessor::crossCorrelation(const std::vector<double>& x,
+                                                    const std::vector<double>& y) const {
+    const size_t n = std::min(x.size(), y.size());
+    if (n == 0) {
+        return {};
+    }
+    
+    auto plan = FFTPlan::get(std::max<size_t>(4, nextPowerOfTwo(2 * n - 1)));
+    auto xSpectrum = paddedSpectrum(std::vector<double>(x.begin(), x.begin() + n), *plan);
+    auto ySpectrum = paddedSpectrum(std::vector<double>(y.begin(), y.begin() + n), *plan);
+    
+    std::vector<double> result(2 * n - 1);
+    std::vector<std::complex<double>> work;
+    correlateSpectra(xSpectrum.data(), ySpectrum.data(), *plan, n, work, result.data());
+    return result;
+}
+
+CrossCorrelationResult DataProcessor::analyzeChannelLags(const std::vector<MeasurementData>& data,
+                                                         const std::vector<DataField>& fields,
+                                                         const CrossCorrelationOptions& options) {
+    CrossCorrelationResult result;
+    result.fields = fields;
+    if (result.fields.empty()) {
+        // 默认：设定高度（指令）与各测量通道
+        result.fields = {DataField::HEIGHT,
+                         DataField::UPPER_SENSOR_1, DataField::UPPER_SENSOR_2,
+                         DataField::LOWER_SENSOR_1, DataField::LOWER_SENSOR_2,
+                         DataField::CAPACITANCE};
+    }
+    const size_t channelCount = result.fields.size();
+    
+    if (data.size() < 4 || channelCount < 2) {
+        LOG_WARNING("Insufficient data for cross-correlation");
+        return result;
+    }
+    
+    // 按时间排序（记录通常已有序，此时不做排序）
+    std::vector<size_t> order(data.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto earlier = [&](size_t a, size_t b) { return data[a].getTimestamp() < data[b].getTimestamp(); };
+    if (!std::is_sorted(order.begin(), order.end(), earlier)) {
+        std::stable_sort(order.begin(), order.end(), earlier);
+    }
+    
+    const size_t rawCount = data.size();
+    const int64_t origin = data[order.front()].getTimestamp();
+    std::vector<double> times(rawCount);
+    for (size_t i = 0; i < rawCount; ++i) {
+        times[i] = (data[order[i]].getTimestamp() - origin) / 1000.0;
+    }
+    const double duration = times.back();
+    const double fs = options.samplingRate > 0.0 ? options.samplingRate
+                                                 : (duration > 0.0 ? (rawCount - 1) / duration : 0.0);
+    if (duration <= 0.0 || fs <= 0.0) {
+        LOG_WARNING("Cross-correlation requires increasing timestamps");
+        return result;
+    }
+    
+    const size_t n = static_cast<size_t>(std::floor(duration * fs)) + 1;
+    if (n < 4) {
+        LOG_WARNING("Insufficient data for cross-correlation");
+        return result;
+    }
+    result.samplingRate = fs;
+    result.sampleCount = n;
+    
+    // 各通道线性插值到均匀时间网格
+    std::vector<std::vector<double>> series(channelCount, std::vector<double>(n));
+    std::vector<double> raw(rawCount);
+    std::vector<double> ordered(rawCount);
+    for (size_t f = 0; f < channelCount; ++f) {
+        gatherField(result.fields[f], data.data(), rawCount, raw.data());
+        for (size_t i = 0; i < rawCount; ++i) {
+            ordered[i] = raw[order[i]];
+        }
+        
+        std::vector<double>& out = series[f];
+        size_t j = 0;
+        for (size_t k = 0; k < n; ++k) {
+            double t = k / fs;
+            while (j + 2 < rawCount && times[j + 1] <= t) {
+                ++j;
+            }
+            double span = times[j + 1] - times[j];
+            double frac = span > 0.0 ? MathUtils::clamp((t - times[j]) / span, 0.0, 1.0) : 1.0;
+            out[k] = ordered[j] + frac * (ordered[j + 1] - ordered[j]);
+        }
+        
+        if (options.removeMean) {
+            double mean = std::accumulate(out.begin(), out.end(), 0.0) / n;
+            for (double& v : out) {
+                v -= mean;
+            }
+        }
+    }
+    
+    // 每个通道只做一次零填充FFT，各通道对复用频谱
+    auto plan = FFTPlan::get(nextPowerOfTwo(2 * n - 1));
+    std::vector<std::vector<std::complex<double>>> spectra(channelCount);
+    std::vector<double> energy(channelCount);
+    for (size_t f = 0; f < channelCount; ++f) {
+        spectra[f] = paddedSpectrum(series[f], *plan);
+        energy[f] = std::inner_product(series[f].begin(), series[f].end(), series[f].begin(), 0.0);
+    }
+    
+    std::vector<std::pair<size_t, size_t>> pairIndices;
+    for (size_t i = 0; i < channelCount; ++i) {
+        for (size_t j = i + 1; j < channelCount; ++j) {
+            pairIndices.emplace_back(i, j);
+        }
+    }
+    const size_t pairCount = pairIndices.size();
+    result.pairs.resize(pairCount);
+    
+    size_t maxLag = n - 1;
+    if (options.maxLagSeconds > 0.0) {
+        maxLag = std::min(maxLag, static_cast<size_t>(std::llround(options.maxLagSeconds * fs)));
+    }
+    
+    bool completed = forEachChunk(pairCount, [&](size_t p) {
+        const size_t a = pairIndices[p].first;
+        const size_t b = pairIndices[p].second;
+        ChannelLag& lag = result.pairs[p];
+        lag.reference = result.fields[a];
+        lag.response = result.fields[b];
+        
+        std::vector<double> correlation(2 * n - 1);
+        std::vector<std::complex<double>> work;
+        correlateSpectra(spectra[a].data(), spectra[b].data(), *plan, n, work, correlation.data());
+        
+        const size_t zero = n - 1;
+        size_t peak = zero;
+        for (size_t k = zero - maxLag; k <= zero + maxLag; ++k) {
+            if (std::abs(correlation[k]) > std::abs(correlation[peak])) {
+                peak = k;
+            }
+        }
+        
+        // 抛物线插值：用峰值及两侧相邻点拟合顶点位置
+        double offset = 0.0;
+        if (peak > zero - maxLag && peak < zero + maxLag) {
+            double sign = correlation[peak] < 0.0 ? -1.0 : 1.0;
+            double left = sign * correlation[peak - 1];
+            double centre = sign * correlation[peak];
+            double right = sign * correlation[peak + 1];
+            double curvature = left - 2.0 * centre + right;
+            if (curvature < 0.0) {
+                offset = MathUtils::clamp(0.5 * (left - right) / curvature, -0.5, 0.5);
+            }
+        }
+        
+        lag.lagSamples = static_cast<double>(peak) - static_cast<double>(zero) + offset;
+        lag.lagSeconds = lag.lagSamples / fs;
+        double norm = std::sqrt(energy[a] * energy[b]);
+        lag.peakCorrelation = norm > 0.0 ? correlation[peak] / norm : 0.0;
+    });
+    if (!completed) {
+        return CrossCorrelationResult{};
+    }
+    
+    // 幅值平方相干函数 |Sxy|²/(Sxx·Syy)，按Welch分段平均的谱估计
+    size_t segmentLength = std::min(std::max<size_t>(options.coherence.segmentLength, 2), n);
+    double overlap = MathUtils::clamp(options.coherence.overlap, 0.0, 0.95);
+    size_t step = std::max<size_t>(1, static_cast<size_t>(segmentLength * (1.0 - overlap)));
+    size_t segmentCount = 1 + (n - segmentLength) / step;
+    size_t bins = segmentLength / 2 + 1;
+    auto window = createWindow(options.coherence.window, segmentLength);
+    auto segmentPlan = FFTPlan::get(segmentLength);
+    
+    struct SpectralSums {
+        std::vector<double> power;                    // channelCount × bins
+        std::vector<std::complex<double>> cross;      // pairCount × bins
+    };
+    constexpr size_t segmentsPerChunk = 64;
+    const size_t chunkCount = (segmentCount + segmentsPerChunk - 1) / segmentsPerChunk;
+    std::vector<SpectralSums> chunkSums(chunkCount);
+    
+    completed = forEachChunk(chunkCount, [&](size_t chunk) {
+        SpectralSums& sums = chunkSums[chunk];
+        sums.power.assign(channelCount * bins, 0.0);
+        sums.cross.assign(pairCount * bins, std::complex<double>());
+        std::vector<double> segment(segmentLength);
+        std::vector<std::complex<double>> segmentSpectra(channelCount * bins);
+        
+        size_t lastSegment = std::min(segmentCount, (chunk + 1) * segmentsPerChunk);
+        for (size_t s = chunk * segmentsPerChunk; s < lastSegment; ++s) {
+            for (size_t f = 0; f < channelCount; ++f) {
+                const double* source = series[f].data() + s * step;
+                double mean = 0.0;
+                if (options.coherence.removeMean) {
+                    mean = std::accumulate(source, source + segmentLength, 0.0) / segmentLength;
+                }
+                for (size_t i = 0; i < segmentLength; ++i) {
+                    segment[i] = (source[i] - mean) * window[i];
+                }
+                std::complex<double>* spectrum = segmentSpectra.data() + f * bins;
+                segmentPlan->forwardReal(segment.data(), spectrum);
+                for (size_t k = 0; k < bins; ++k) {
+                    sums.power[f * bins + k] += std::norm(spectrum[k]);
+                }
+            }
+            for (size_t p = 0; p < pairCount; ++p) {
+                const std::complex<double>* x = segmentSpectra.data() + pairIndices[p].first * bins;
+                const std::complex<double>* y = segmentSpectra.data() + pairIndices[p].second * bins;
+                for (size_t k = 0; k < bins; ++k) {
+                    sums.cross[p * bins + k] += std::conj(x[k]) * y[k];
+                }
+            }
+        }
+    });
+    if (!completed) {
+        return CrossCorrelationResult{};
+    }
+    
+    std::vector<double> powerSum(channelCount * bins, 0.0);
+    std::vector<std::complex<double>> crossSum(pairCount * bins);
+    for (const auto& sums : chunkSums) {
+        for (size_t i = 0; i < powerSum.size(); ++i) powerSum[i] += sums.power[i];
+        for (size_t i = 0; i < crossSum.size(); ++i) crossSum[i] += sums.cross[i];
+    }
+    
+    result.frequencies.resize(bins);
+    for (size_t k = 0; k < bins; ++k) {
+        result.frequencies[k] = k * fs / segmentLength;
+    }
+    
+    for (size_t p = 0; p < pairCount; ++p) {
+        ChannelLag& lag = result.pairs[p];
+        lag.coherence.assign(bins, 0.0);
+        const double* sxx = powerSum.data() + pairIndices[p].first * bins;
+        const double* syy = powerSum.data() + pairIndices[p].second * bins;
+        double sum = 0.0;
+        for (size_t k = 0; k < bins; ++k) {
+            double denominator = sxx[k] * syy[k];
+            if (denominator > 0.0) {
+                lag.coherence[k] = std::min(1.0, std::norm(crossSum[p * bins + k]) / denominator);
+            }
+            if (k > 0) {
+                sum += lag.coherence[k];
+            }
+        }
+        // 直流分量已去除，平均值不计入0频点
+        lag.meanCoherence = bins > 1 ? sum / (bins - 1) : lag.coherence[0];
+    }
+    
+    return result;
+}
+
+std::vector<double> DataProcessor::createWindow(WindowFunction window, size_t length) {
+    std::vector<double> w(length, 1.0);
+    if (length < 2) {
+        return w;
+    }
+    
+    // 周期窗（分母为length），适合频谱分析
+    const double twoPi = 2.0 * PhysicsConstants::PI;
+    for (size_t i = 0; i < length; ++i) {
+        double phase = twoPi * static_cast<double>(i) / static_cast<double>(length);
+        switch (window) {
+            case WindowFunction::RECTANGULAR:
+                break;
+            case WindowFunction::HANN:
+                w[i] = 0.5 - 0.5 * std::cos(phase);
+                break;
+            case WindowFunction::HAMMING:
+                w[i] = 0.54 - 0.46 * std::cos(phase);
+                break;
+            case WindowFunction::BLACKMAN:
+                w[i] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+                break;
+        }
+    }
+    
+    return w;
+}
+
+TrendAnalysis DataProcessor::analyzeTrend(const std::vector<MeasurementData>& data, DataField field) {
+    TrendAnalysis result;
+    
+    if (data.size() < 3) {
+        result.direction = TrendDirection::STABLE;
+        result.strength = 0.0;
+        return result;
+    }
+    
+    auto values = extractFieldValues(data, field);
+    
+    // 执行线性回归
+    std::vector<double> indices(values.size());
+    std::iota(indices.begin(), indices.end(), 0.0);
+    
+    // 计算线性趋势
+    double n = values.size();
+    double sumX = n * (n - 1) / 2;
+    double sumX2 = n * (n - 1) * (2 * n - 1) / 6;
+    double sumY = std::accumulate(values.begin(), values.end(), 0.0);
+    double sumXY = 0.0;
+    
+    for (size_t i = 0; i < values.size(); ++i) {
+        sumXY += i * values[i];
+    }
+    
+    double slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
+    double intercept = (sumY - slope * sumX) / n;
+    
+    // 确定趋势方向
+    if (std::abs(slope) < 0.001) {
+        result.direction = TrendDirection::STABLE;
+    } else if (slope > 0) {
+        result.direction = TrendDirection::INCREASING;
+    } else {
+        result.direction = TrendDirection::DECREASING;
+    }
+    
+    // 计算趋势强度（R²）
     double ssTotal = 0.0, ssResidual = 0.0;
     double meanY = sumY / n;
     result.trendLine.resize(values.size());
@@ -492,40 +1392,145 @@ ChartData2D DataProcessor::prepareScatterPlotData(const std::vector<MeasurementD
 }
 
 ChartData3D DataProcessor::prepare3DSurfaceData(const std::vector<MeasurementData>& data,
-    DataField xField, DataField yField, DataField zField) {
+    DataField xField, DataField yField, DataField zField,
+    const SurfaceGridOptions& options) {
     ChartData3D chartData;
+    chartData.xLabel = getFieldName(xField) + " (" + getFieldUnit(xField) + ")";
+    chartData.yLabel = getFieldName(yField) + " (" + getFieldUnit(yField) + ")";
+    chartData.zLabel = getFieldName(zField) + " (" + getFieldUnit(zField) + ")";
+    chartData.title = "3D Surface Plot";
+
+    if (data.empty()) {
+        return chartData;
+    }
 
-    auto xValues = extractFieldValues(data, xField);
-    auto yValues = extractFieldValues(data, yField);
-    auto zValues = extractFieldValues(data, zField);
+    auto columns = extractColumns(data, {xField, yField, zField});
+    const auto& xValues = columns.values[0];
+    const auto& yValues = columns.values[1];
+    const auto& zValues = columns.values[2];
+
+    // 网格轴：不同坐标值不多时直接使用，否则按分辨率等分（单元中心）
+    struct Axis {
+        std::vector<double> grid;
+        bool exact = true;
+        double lower = 0.0;
+        double width = 1.0;
+
+        void build(const std::vector<double>& values, size_t resolution) {
+            std::vector<double> sorted(values);
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+            resolution = std::max<size_t>(resolution, 1);
+            if (sorted.size() <= resolution) {
+                grid.swap(sorted);
+                exact = true;
+                return;
+            }
 
-    // 创建网格
-    std::set<double> uniqueX(xValues.begin(), xValues.end());
-    std::set<double> uniqueY(yValues.begin(), yValues.end());
+            exact = false;
+            lower = sorted.front();
+            width = (sorted.back() - sorted.front()) / resolution;
+            grid.resize(resolution);
+            for (size_t i = 0; i < resolution; ++i) {
+                grid[i] = lower + (i + 0.5) * width;
+            }
+        }
+
+        size_t cell(double v) const {
+            if (exact) {
+                return std::lower_bound(grid.begin(), grid.end(), v) - grid.begin();
+            }
+            double position = std::floor((v - lower) / width);
+            if (!(position > 0.0)) return 0;
+            return std::min(static_cast<size_t>(position), grid.size() - 1);
+        }
+    };
 
-    chartData.xGrid.assign(uniqueX.begin(), uniqueX.end());
-    chartData.yGrid.assign(uniqueY.begin(), uniqueY.end());
+    Axis xAxis, yAxis;
+    xAxis.build(xValues, options.xResolution);
+    yAxis.build(yValues, options.yResolution);
 
-    // 初始化Z值矩阵
-    chartData.zValues.resize(chartData.yGrid.size(), 
-    std::vector<double>(chartData.xGrid.size(), 0.0));
+    const size_t nx = xAxis.grid.size();
+    const size_t ny = yAxis.grid.size();
 
-    // 填充Z值（这里使用最近邻插值）
+    // 分箱求平均
+    std::vector<double> sums(nx * ny, 0.0);
+    std::vector<size_t> counts(nx * ny, 0);
     for (size_t i = 0; i < data.size(); ++i) {
-        auto xIt = std::find(chartData.xGrid.begin(), chartData.xGrid.end(), xValues[i]);
-        auto yIt = std::find(chartData.yGrid.begin(), chartData.yGrid.end(), yValues[i]);
+        size_t cell = yAxis.cell(yValues[i]) * nx + xAxis.cell(xValues[i]);
+        sums[cell] += zValues[i];
+        counts[cell]++;
+    }
 
-        if (xIt != chartData.xGrid.end() && yIt != chartData.yGrid.end()) {
-            size_t xIdx = std::distance(chartData.xGrid.begin(), xIt);
-            size_t yIdx = std::distance(chartData.yGrid.begin(), yIt);
-            chartData.zValues[yIdx][xIdx] = zValues[i];
+    chartData.xGrid = xAxis.grid;
+    chartData.yGrid = yAxis.grid;
+    chartData.zValues.assign(ny, std::vector<double>(nx, 0.0));
+
+    std::vector<double> cellX, cellY, cellZ;
+    size_t missing = 0;
+    for (size_t row = 0; row < ny; ++row) {
+        for (size_t col = 0; col < nx; ++col) {
+            size_t cell = row * nx + col;
+            if (counts[cell] == 0) {
+                ++missing;
+                continue;
+            }
+            double value = sums[cell] / counts[cell];
+            chartData.zValues[row][col] = value;
+            cellX.push_back(xAxis.grid[col]);
+            cellY.push_back(yAxis.grid[row]);
+            cellZ.push_back(value);
         }
     }
 
-    chartData.xLabel = getFieldName(xField) + " (" + getFieldUnit(xField) + ")";
-    chartData.yLabel = getFieldName(yField) + " (" + getFieldUnit(yField) + ")";
-    chartData.zLabel = getFieldName(zField) + " (" + getFieldUnit(zField) + ")";
-    chartData.title = "3D Surface Plot";
+    if (options.fill == SurfaceFillMethod::NONE || missing == 0 || cellZ.empty()) {
+        return chartData;
+    }
+
+    // 空缺单元由有数据单元插值；两轴量纲不同，先按坐标范围归一化再计算距离
+    auto normalizer = [](const std::vector<double>& grid) {
+        double range = grid.back() - grid.front();
+        return range > 0.0 ? 1.0 / range : 0.0;
+    };
+    const double xScale = normalizer(xAxis.grid);
+    const double yScale = normalizer(yAxis.grid);
+    const double x0 = xAxis.grid.front();
+    const double y0 = yAxis.grid.front();
+
+    std::vector<double> treeX(cellX.size()), treeY(cellY.size());
+    for (size_t i = 0; i < cellX.size(); ++i) {
+        treeX[i] = (cellX[i] - x0) * xScale;
+        treeY[i] = (cellY[i] - y0) * yScale;
+    }
+    KdTree2D tree;
+    tree.build(treeX, treeY);
+
+    const size_t k = options.fill == SurfaceFillMethod::NEAREST ? 1 : std::max<size_t>(options.neighbours, 1);
+    std::vector<size_t> neighbours;
+    std::vector<double> distancesSq;
+    for (size_t row = 0; row < ny; ++row) {
+        for (size_t col = 0; col < nx; ++col) {
+            if (counts[row * nx + col] != 0) continue;
+
+            tree.nearest((xAxis.grid[col] - x0) * xScale, (yAxis.grid[row] - y0) * yScale,
+                         k, neighbours, distancesSq);
+
+            double weightSum = 0.0;
+            double valueSum = 0.0;
+            for (size_t n = 0; n < neighbours.size(); ++n) {
+                if (distancesSq[n] <= 0.0) {
+                    weightSum = 1.0;
+                    valueSum = cellZ[neighbours[n]];
+                    break;
+                }
+                double w = 1.0 / std::pow(distancesSq[n], options.power / 2.0);
+                weightSum += w;
+                valueSum += w * cellZ[neighbours[n]];
+            }
+            chartData.zValues[row][col] = weightSum > 0.0 ? valueSum / weightSum : 0.0;
+        }
+    }
 
     return chartData;
 }
@@ -573,31 +1578,23 @@ ErrorAnalysis DataProcessor::analyzeError(const std::vector<double>& theoretical
     return result;
 }
 
+ErrorAnalysis DataProcessor::analyzeCapacitanceError(const std::vector<MeasurementData>& data,
+                                                     const CapacitorParameters& parameters) {
+    MeasurementColumns columns = extractColumns(
+        data, {DataField::HEIGHT, DataField::ANGLE, DataField::CAPACITANCE});
+    const auto& heights = columns.values[0];
+    const auto& angles = columns.values[1];
+    
+    std::vector<double> theoretical(columns.rows);
+    CapacitanceCalibrator::predict(parameters, heights.data(), angles.data(), columns.rows, theoretical.data());
+    return analyzeError(theoretical, columns.values[2]);
+}
+
 // 私有辅助方法实现
 
 double DataProcessor::getFieldValue(const MeasurementData& data, DataField field) const {
-    switch (field) {
-        case DataField::HEIGHT:
-            return data.getSetHeight();
-        case DataField::ANGLE:
-            return data.getSetAngle();
-        case DataField::CAPACITANCE:
-            return data.getSensorData().capacitance;  // 直接访问公共成员
-        case DataField::TEMPERATURE:
-            return data.getSensorData().temperature;  // 直接访问公共成员
-        case DataField::UPPER_SENSOR_1:
-            return data.getSensorData().distanceUpper1;  // 直接访问公共成员
-        case DataField::UPPER_SENSOR_2:
-            return data.getSensorData().distanceUpper2;  // 直接访问公共成员
-        case DataField::LOWER_SENSOR_1:
-            return data.getSensorData().distanceLower1;  // 直接访问公共成员
-        case DataField::LOWER_SENSOR_2:
-            return data.getSensorData().distanceLower2;  // 直接访问公共成员
-        case DataField::TIMESTAMP:
-            return static_cast<double>(data.getTimestamp());
-        default:
-            return 0.0;
-    }
+    // 单条访问；批量处理请用 gatherField() 或以FieldTag实例化的核函数
+    return dispatchField(field, [&](auto tag) { return getField(data, tag); });
 }
 
 std::string DataProcessor::getFieldName(DataField field) const {
@@ -636,6 +1633,20 @@ std::string DataProcessor::getFieldUnit(DataField field) const {
     }
 }
 
+double DataProcessor::estimateSamplingRate(const std::vector<MeasurementData>& data) const {
+    if (data.size() < 2) {
+        return 0.0;
+    }
+    
+    double totalTime = (data.back().getTimestamp() - data.front().getTimestamp()) / 1000.0; // 转换为秒
+    if (totalTime <= 0.0) {
+        // 时间戳无效时按单位采样率处理（频率以 cycles/sample 表示）
+        return 1.0;
+    }
+    
+    return (data.size() - 1) / totalTime;
+}
+
 double DataProcessor::calculateMean(const std::vector<double>& values) const {
     if (values.empty()) return 0.0;
     return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
@@ -654,128 +1665,39 @@ double DataProcessor::calculateStdDev(const std::vector<double>& values, double
 
 std::vector<double> DataProcessor::movingAverage(const std::vector<double>& data, int windowSize) const {
     std::vector<double> result(data.size());
-    int halfWindow = windowSize / 2;
-    
-    for (size_t i = 0; i < data.size(); ++i) {
-        int start = std::max(0, static_cast<int>(i) - halfWindow);
-        int end = std::min(static_cast<int>(data.size()), static_cast<int>(i) + halfWindow + 1);
-        
-        double sum = 0.0;
-        for (int j = start; j < end; ++j) {
-            sum += data[j];
-        }
-        
-        result[i] = sum / (end - start);
+    if (data.empty()) return result;
+
+    const int n = static_cast<int>(data.size());
+    const int halfWindow = windowSize / 2;
+
+    // 前缀和：减去首个样本以降低累加值的量级，保持精度
+    const double offset = data[0];
+    std::vector<double> prefix(data.size() + 1, 0.0);
+    for (int i = 0; i < n; ++i) {
+        prefix[i + 1] = prefix[i] + (data[i] - offset);
     }
-    
+
+    for (int i = 0; i < n; ++i) {
+        int start = std::max(0, i - halfWindow);
+        int end = std::min(n, i + halfWindow + 1);
+        result[i] = offset + (prefix[end] - prefix[start]) / (end - start);
+    }
+
     return result;
 }
 
 // 添加缺失的辅助方法实现
 void DataProcessor::setFieldValue(MeasurementData& data, DataField field, double value) const {
-    switch (field) {
-        case DataField::HEIGHT:
-            data.setHeight(value);
-            break;
-        case DataField::ANGLE:
-            data.setAngle(value);
-            break;
-        case DataField::CAPACITANCE:
-        case DataField::TEMPERATURE:
-        case DataField::UPPER_SENSOR_1:
-        case DataField::UPPER_SENSOR_2:
-        case DataField::LOWER_SENSOR_1:
-        case DataField::LOWER_SENSOR_2:
-            {
-                // 由于getSensorData()返回const引用，我们需要创建一个新的SensorData对象
-                // 复制现有数据，修改需要的字段，然后设置回去
-                SensorData newSensorData = data.getSensorData();
-                switch(field) {
-                    case DataField::CAPACITANCE:
-                        newSensorData.capacitance = value;
-                        break;
-                    case DataField::TEMPERATURE:
-                        newSensorData.temperature = value;
-                        break;
-                    case DataField::UPPER_SENSOR_1:
-                        newSensorData.distanceUpper1 = value;
-                        break;
-                    case DataField::UPPER_SENSOR_2:
-                        newSensorData.distanceUpper2 = value;
-                        break;
-                    case DataField::LOWER_SENSOR_1:
-                        newSensorData.distanceLower1 = value;
-                        break;
-                    case DataField::LOWER_SENSOR_2:
-                        newSensorData.distanceLower2 = value;
-                        break;
-                    default:
-                        break;
-                }
-                // 假设有setSensorData方法，如果没有，需要查看MeasurementData的实际接口
-                data.updateSensorData(newSensorData);
-            }
-            break;
-        case DataField::TIMESTAMP:
-            // 时间戳通常不应该被修改
-            break;
-    }
+    dispatchField(field, [&](auto tag) { setField(data, value, tag); });
 }
 
 std::vector<double> DataProcessor::extractFieldValues(const std::vector<MeasurementData>& data,
                                                     DataField field) const {
-    std::vector<double> values;
-    values.reserve(data.size());
-    
-    for (const auto& measurement : data) {
-        values.push_back(getFieldValue(measurement, field));
-    }
-    
+    std::vector<double> values(data.size());
+    gatherField(field, data.data(), data.size(), values.data());
     return values;
 }
 
-// 添加高斯消元法实现
-std::vector<double> DataProcessor::gaussianElimination(std::vector<std::vector<double>>& a, 
-                                                      std::vector<double>& b) const {
-    int n = a.size();
-    std::vector<double> x(n);
-    
-    // 前向消元
-    for (int i = 0; i < n - 1; ++i) {
-        // 寻找主元
-        int maxRow = i;
-        for (int k = i + 1; k < n; ++k) {
-            if (std::abs(a[k][i]) > std::abs(a[maxRow][i])) {
-                maxRow = k;
-            }
-        }
-        
-        // 交换行
-        std::swap(a[i], a[maxRow]);
-        std::swap(b[i], b[maxRow]);
-        
-        // 消元
-        for (int k = i + 1; k < n; ++k) {
-            double factor = a[k][i] / a[i][i];
-            for (int j = i; j < n; ++j) {
-                a[k][j] -= factor * a[i][j];
-            }
-            b[k] -= factor * b[i];
-        }
-    }
-    
-    // 回代
-    for (int i = n - 1; i >= 0; --i) {
-        x[i] = b[i];
-        for (int j = i + 1; j < n; ++j) {
-            x[i] -= a[i][j] * x[j];
-        }
-        x[i] /= a[i][i];
-    }
-    
-    return x;
-}
-
 // 添加其他必要的辅助方法实现
 double DataProcessor::calculateVariance(const std::vector<double>& values, double mean) const {
     if (values.size() < 2) return 0.0;
@@ -852,56 +1774,78 @@ std::vector<double> DataProcessor::gaussianSmooth(const std::vector<double>& dat
 
 std::vector<double> DataProcessor::medianFilter(const std::vector<double>& data, int windowSize) const {
     std::vector<double> result(data.size());
-    int halfWindow = windowSize / 2;
-    
-    for (size_t i = 0; i < data.size(); ++i) {
-        std::vector<double> window;
-        
-        for (int j = -halfWindow; j <= halfWindow; ++j) {
-            int idx = i + j;
-            if (idx >= 0 && idx < static_cast<int>(data.size())) {
-                window.push_back(data[idx]);
-            }
+    const int n = static_cast<int>(data.size());
+    const int halfWindow = windowSize / 2;
+
+    // 窗口每次滑动只插入一个、删除一个样本
+    SlidingMedian window;
+    for (int j = 0; j < std::min(halfWindow, n); ++j) {
+        window.insert(data[j]);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int entering = i + halfWindow;
+        int leaving = i - halfWindow - 1;
+        if (entering < n) {
+            window.insert(data[entering]);
         }
-        
-        std::sort(window.begin(), window.end());
-        result[i] = window[window.size() / 2];
+        if (leaving >= 0) {
+            window.erase(data[leaving]);
+        }
+        result[i] = window.median();
     }
-    
+
     return result;
 }
 
-// 简单的FFT实现（实际应用中应使用专门的库如FFTW）
-std::vector<std::complex<double>> DataProcessor::fft(const std::vector<std::complex<double>>& data) const {
-    int n = data.size();
-    
-    if (n <= 1 || n > 65536) { 
-        return data;
-    }
+std::vector<double> DataProcessor::savitzkyGolay(const std::vector<double>& data,
+                                                 int windowSize, int order) const {
+    const int n = static_cast<int>(data.size());
 
-    if (n <= 32) {
-        return dft(data);
+    // 窗口取奇数，且不超过数据长度
+    int window = 2 * (windowSize / 2) + 1;
+    if (window > n) {
+        window = (n % 2 == 1) ? n : n - 1;
     }
-    
-    // 分成偶数和奇数部分
-    std::vector<std::complex<double>> even(n/2), odd(n/2);
-    for (int i = 0; i < n/2; ++i) {
-        even[i] = data[2*i];
-        odd[i] = data[2*i + 1];
+    order = std::max(order, 0);
+    if (window < 3 || order >= window - 1) {
+        return data;  // 多项式能精确通过所有点，平滑无意义
     }
-    
-    // 递归计算
-    auto evenFFT = fft(even);
-    auto oddFFT = fft(odd);
-    
-    // 合并结果
-    std::vector<std::complex<double>> result(n);
-    for (int k = 0; k < n/2; ++k) {
-        std::complex<double> t = std::polar(1.0, -2 * PhysicsConstants::PI * k / n) * oddFFT[k];
-        result[k] = evenFFT[k] + t;
-        result[k + n/2] = evenFFT[k] - t;
+
+    auto coefficientsPtr = savitzkyGolayCoefficients(window, order);
+    const double* coefficients = coefficientsPtr->data();
+    const int half = window / 2;
+
+    std::vector<double> result(data.size());
+    const double* x = data.data();
+
+    // 内部样本使用中心行系数
+    const double* center = coefficients + static_cast<size_t>(half) * window;
+    for (int i = half; i < n - half; ++i) {
+        const double* segment = x + (i - half);
+        double sum = 0.0;
+        for (int j = 0; j < window; ++j) {
+            sum += center[j] * segment[j];
+        }
+        result[i] = sum;
     }
-    
+
+    // 两端样本使用首/尾窗口的拟合多项式在对应位置求值
+    for (int r = 0; r < half; ++r) {
+        const double* headRow = coefficients + static_cast<size_t>(r) * window;
+        const double* tailRow = coefficients + static_cast<size_t>(window - 1 - r) * window;
+        const double* tailSegment = x + (n - window);
+
+        double head = 0.0;
+        double tail = 0.0;
+        for (int j = 0; j < window; ++j) {
+            head += headRow[j] * x[j];
+            tail += tailRow[j] * tailSegment[j];
+        }
+        result[r] = head;
+        result[n - 1 - r] = tail;
+    }
+
     return result;
 }
 
@@ -910,30 +1854,18 @@ double DataProcessor::linearInterpolate(double x0, double y0, double x1, double
     return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
 }
 
-double DataProcessor::cubicInterpolate(const std::vector<double>& x, 
-                                     const std::vector<double>& y, double xi) const {
-    // 简单的三次插值实现
-    // 实际应用中应使用更复杂的样条插值
+double DataProcessor::cubicInterpolate(const std::vector<double>& x, const std::vector<double>& y,
+                                       size_t interval, double xi) const {
+    // Catmull-Rom三次插值：使用区间两侧各一个相邻节点，区间由调用方定位
     size_t n = x.size();
     if (n < 4) {
-        // 退化为线性插值
-        for (size_t i = 1; i < n; ++i) {
-            if (xi >= x[i-1] && xi <= x[i]) {
-                return linearInterpolate(x[i-1], y[i-1], x[i], y[i], xi);
-            }
-        }
-        return 0.0;
+        return linearInterpolate(x[interval], y[interval], x[interval + 1], y[interval + 1], xi);
     }
     
-    // 找到包含xi的区间
-    size_t i = 0;
-    for (; i < n - 1 && x[i+1] < xi; ++i);
-    
-    // 使用周围的4个点进行三次插值
-    size_t i0 = (i > 0) ? i - 1 : i;
-    size_t i1 = i;
-    size_t i2 = (i < n - 1) ? i + 1 : i;
-    size_t i3 = (i < n - 2) ? i + 2 : i2;
+    size_t i0 = (interval > 0) ? interval - 1 : interval;
+    size_t i1 = interval;
+    size_t i2 = interval + 1;
+    size_t i3 = (i2 + 1 < n) ? i2 + 1 : i2;
     
     double t = (xi - x[i1]) / (x[i2] - x[i1]);
     double t2 = t * t;
@@ -949,18 +1881,507 @@ double DataProcessor::cubicInterpolate(const std::vector<double>& x,
            t3 * (-0.5 * p0 + 1.5 * p1 - 1.5 * p2 + 0.5 * p3);
 }
 
-std::vector<std::complex<double>> DataProcessor::dft(const std::vector<std::complex<double>>& data) const {
-    int n = data.size();
-    std::vector<std::complex<double>> result(n);
-    
-    for (int k = 0; k < n; ++k) {
-        std::complex<double> sum(0, 0);
-        for (int t = 0; t < n; ++t) {
-            double angle = -2 * PhysicsConstants::PI * t * k / n;
-            sum += data[t] * std::complex<double>(cos(angle), sin(angle));
+std::vector<std::vector<MeasurementData>> DataProcessor::performClustering(
+    const std::vector<MeasurementData>& data,
+    int numClusters,
+    const std::vector<DataField>& features,
+    NormalizationMethod normalization) {
+    ClusteringOptions options;
+    options.normalization = normalization;
+
+    auto result = performKMeans(data, numClusters, features, options);
+
+    std::vector<std::vector<MeasurementData>> clusters(result.centroids.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        clusters[c].reserve(result.clusterSizes[c]);
+    }
+    for (size_t i = 0; i < result.labels.size(); ++i) {
+        clusters[result.labels[i]].push_back(data[i]);
+    }
+    return clusters;
+}
+
+ClusteringResult DataProcessor::performKMeans(const std::vector<MeasurementData>& data,
+                                              int numClusters,
+                                              const std::vector<DataField>& features,
+                                              const ClusteringOptions& options) {
+    if (data.empty() || numClusters <= 0 || features.empty()) {
+        LOG_WARNING("Invalid parameters for clustering");
+        return ClusteringResult();
+    }
+
+    size_t k = std::min(static_cast<size_t>(numClusters), data.size());
+    auto columns = extractColumns(data, features);
+
+    size_t dims = features.size();
+    std::vector<double> offsets(dims, 0.0);
+    std::vector<double> scales(dims, 1.0);
+    if (options.normalize) {
+        for (size_t f = 0; f < dims; ++f) {
+            normalizeValues(columns.values[f], options.normalization, &offsets[f], &scales[f]);
         }
-        result[k] = sum;
     }
-    
+
+    auto result = kMeansClustering(columns.values, k, options);
+
+    // 质心换算回原始单位
+    for (auto& centroid : result.centroids) {
+        for (size_t f = 0; f < dims; ++f) {
+            centroid[f] = centroid[f] * scales[f] + offsets[f];
+        }
+    }
+
+    LOG_INFO_F("K-means: %zu records, %zu clusters, %d iterations, inertia %.4g",
+               data.size(), k, result.iterations, result.inertia);
     return result;
-}
\ No newline at end of file
+}
+
+void DataProcessor::normalizeValues(std::vector<double>& values, NormalizationMethod method,
+                                    double* offset, double* scale) const {
+    // 一次遍历同时得到极值、均值和方差（Welford），然后原位变换为 (x - offset) / scale
+    double minValue = values.empty() ? 0.0 : values[0];
+    double maxValue = minValue;
+    double mean = 0.0;
+    double m2 = 0.0;
+    size_t count = 0;
+    for (double v : values) {
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
+        ++count;
+        double delta = v - mean;
+        mean += delta / count;
+        m2 += delta * (v - mean);
+    }
+
+    double shift = 0.0;
+    double factor = 1.0;
+    if (count > 0) {
+        switch (method) {
+            case NormalizationMethod::MIN_MAX:
+                shift = minValue;
+                factor = maxValue - minValue;
+                break;
+            case NormalizationMethod::Z_SCORE:
+                shift = mean;
+                factor = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+                break;
+            case NormalizationMethod::DECIMAL_SCALING: {
+                double maxAbs = std::max(std::abs(minValue), std::abs(maxValue));
+                // 取最小的j使 max|x| / 10^j < 1
+                factor = maxAbs > 0.0 ? std::pow(10.0, std::floor(std::log10(maxAbs)) + 1.0) : 1.0;
+                break;
+            }
+        }
+    }
+
+    if (!(factor > 0.0) || !std::isfinite(factor)) {
+        factor = 1.0;  // 常数列只做平移
+    }
+
+    const double inverse = 1.0 / factor;
+    for (double& v : values) {
+        v = (v - shift) * inverse;
+    }
+
+    if (offset) *offset = shift;
+    if (scale) *scale = factor;
+}
+
+ClusteringResult DataProcessor::kMeansClustering(const std::vector<std::vector<double>>& columns,
+                                                 size_t k, const ClusteringOptions& options) const {
+    ClusteringResult result;
+    const size_t dims = columns.size();
+    const size_t n = dims > 0 ? columns[0].size() : 0;
+    if (n == 0 || k == 0) {
+        return result;
+    }
+    k = std::min(k, n);
+
+    // 质心按特征优先存放：centers[f * k + c]
+    std::vector<double> centers(dims * k);
+    std::mt19937_64 gen(options.seed);
+
+    auto distanceTo = [&](size_t i, const double* center, size_t stride) {
+        double d = 0.0;
+        for (size_t f = 0; f < dims; ++f) {
+            double diff = columns[f][i] - center[f * stride];
+            d += diff * diff;
+        }
+        return d;
+    };
+
+    // k-means++ 初始化；mini-batch模式下只在随机子集上选种子
+    std::vector<size_t> candidates;
+    size_t candidateCount = n;
+    if (options.miniBatchSize > 0) {
+        candidateCount = std::min(n, std::max<size_t>(100 * k, 10 * options.miniBatchSize));
+    }
+    if (candidateCount < n) {
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        candidates.resize(candidateCount);
+        for (auto& idx : candidates) idx = pick(gen);
+    } else {
+        candidates.resize(n);
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+
+    {
+        std::uniform_int_distribution<size_t> pick(0, candidates.size() - 1);
+        size_t first = candidates[pick(gen)];
+        for (size_t f = 0; f < dims; ++f) {
+            centers[f * k] = columns[f][first];
+        }
+
+        std::vector<double> minDist(candidates.size());
+        for (size_t j = 0; j < candidates.size(); ++j) {
+            minDist[j] = distanceTo(candidates[j], &centers[0], k);
+        }
+
+        for (size_t c = 1; c < k; ++c) {
+            double total = std::accumulate(minDist.begin(), minDist.end(), 0.0);
+            size_t chosen = 0;
+            if (total > 0.0) {
+                double r = std::uniform_real_distribution<double>(0.0, total)(gen);
+                double cumulative = 0.0;
+                chosen = candidates.size() - 1;
+                for (size_t j = 0; j < candidates.size(); ++j) {
+                    cumulative += minDist[j];
+                    if (cumulative >= r) {
+                        chosen = j;
+                        break;
+                    }
+                }
+            } else {
+                chosen = pick(gen);
+            }
+
+            for (size_t f = 0; f < dims; ++f) {
+                centers[f * k + c] = columns[f][candidates[chosen]];
+            }
+            for (size_t j = 0; j < candidates.size(); ++j) {
+                minDist[j] = std::min(minDist[j], distanceTo(candidates[j], &centers[c], k));
+            }
+        }
+    }
+
+    // 分配步骤：按块计算块内所有点到所有质心的距离，内层循环在连续数组上可被自动向量化
+    constexpr size_t blockSize = 256;
+    constexpr size_t chunkSize = 16384;
+    const size_t chunkCount = (n + chunkSize - 1) / chunkSize;
+
+    struct ChunkAccumulator {
+        std::vector<double> sums;   // sums[c * dims + f]
+        std::vector<size_t> counts;
+        double inertia = 0.0;
+    };
+    std::vector<ChunkAccumulator> accumulators(chunkCount);
+    result.labels.assign(n, 0);
+
+    auto assignChunk = [&](size_t chunk) {
+        ChunkAccumulator& acc = accumulators[chunk];
+        acc.sums.assign(k * dims, 0.0);
+        acc.counts.assign(k, 0);
+        acc.inertia = 0.0;
+
+        std::vector<double> dist(k * blockSize);
+        size_t chunkEnd = std::min(n, (chunk + 1) * chunkSize);
+        for (size_t begin = chunk * chunkSize; begin < chunkEnd; begin += blockSize) {
+            size_t len = std::min(blockSize, chunkEnd - begin);
+            std::fill(dist.begin(), dist.end(), 0.0);
+
+            for (size_t f = 0; f < dims; ++f) {
+                const double* x = columns[f].data() + begin;
+                for (size_t c = 0; c < k; ++c) {
+                    const double center = centers[f * k + c];
+                    double* d = dist.data() + c * blockSize;
+                    for (size_t i = 0; i < len; ++i) {
+                        double diff = x[i] - center;
+                        d[i] += diff * diff;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < len; ++i) {
+                size_t best = 0;
+                double bestDist = dist[i];
+                for (size_t c = 1; c < k; ++c) {
+                    double d = dist[c * blockSize + i];
+                    if (d < bestDist) {
+                        bestDist = d;
+                        best = c;
+                    }
+                }
+                result.labels[begin + i] = static_cast<int>(best);
+                acc.inertia += bestDist;
+                acc.counts[best]++;
+                for (size_t f = 0; f < dims; ++f) {
+                    acc.sums[best * dims + f] += columns[f][begin + i];
+                }
+            }
+        }
+    };
+
+    // 按块序合并，结果与线程数无关
+    auto assignAll = [&](std::vector<double>& sums, std::vector<size_t>& counts) {
+        if (!forEachChunk(chunkCount, assignChunk, options.numThreads)) {
+            return false;
+        }
+        sums.assign(k * dims, 0.0);
+        counts.assign(k, 0);
+        result.inertia = 0.0;
+        for (const auto& acc : accumulators) {
+            for (size_t j = 0; j < sums.size(); ++j) sums[j] += acc.sums[j];
+            for (size_t c = 0; c < k; ++c) counts[c] += acc.counts[c];
+            result.inertia += acc.inertia;
+        }
+        return true;
+    };
+
+    const double toleranceSq = options.tolerance * options.tolerance;
+    std::vector<double> sums;
+    std::vector<size_t> counts;
+
+    if (options.miniBatchSize > 0) {
+        // Mini-batch k-means：每次迭代只用一小批随机样本，按样本计数递减学习率更新质心
+        std::vector<size_t> seen(k, 0);
+        std::vector<size_t> batch(std::min(options.miniBatchSize, n));
+        std::vector<size_t> batchLabels(batch.size());
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+
+        for (int iter = 0; iter < options.maxIterations; ++iter) {
+            for (size_t b = 0; b < batch.size(); ++b) {
+                batch[b] = pick(gen);
+                size_t best = 0;
+                double bestDist = distanceTo(batch[b], &centers[0], k);
+                for (size_t c = 1; c < k; ++c) {
+                    double d = distanceTo(batch[b], &centers[c], k);
+                    if (d < bestDist) {
+                        bestDist = d;
+                        best = c;
+                    }
+                }
+                batchLabels[b] = best;
+            }
+
+            double maxShift = 0.0;
+            for (size_t b = 0; b < batch.size(); ++b) {
+                size_t c = batchLabels[b];
+                double eta = 1.0 / static_cast<double>(++seen[c]);
+                double shift = 0.0;
+                for (size_t f = 0; f < dims; ++f) {
+                    double& center = centers[f * k + c];
+                    double delta = eta * (columns[f][batch[b]] - center);
+                    center += delta;
+                    shift += delta * delta;
+                }
+                maxShift = std::max(maxShift, shift);
+            }
+
+            result.iterations = iter + 1;
+            if (maxShift <= toleranceSq) {
+                break;
+            }
+        }
+
+        if (!assignAll(sums, counts)) {
+            return ClusteringResult{};
+        }
+    } else {
+        for (int iter = 0; iter < options.maxIterations; ++iter) {
+            if (!assignAll(sums, counts)) {
+                return ClusteringResult{};
+            }
+
+            double maxShift = 0.0;
+            for (size_t c = 0; c < k; ++c) {
+                if (counts[c] == 0) continue;  // 空簇保留原质心
+                double shift = 0.0;
+                for (size_t f = 0; f < dims; ++f) {
+                    double updated = sums[c * dims + f] / counts[c];
+                    double delta = updated - centers[f * k + c];
+                    centers[f * k + c] = updated;
+                    shift += delta * delta;
+                }
+                maxShift = std::max(maxShift, shift);
+            }
+
+            result.iterations = iter + 1;
+            if (maxShift <= toleranceSq) {
+                break;
+            }
+        }
+    }
+
+    result.clusterSizes = counts;
+    result.centroids.assign(k, std::vector<double>(dims));
+    for (size_t c = 0; c < k; ++c) {
+        for (size_t f = 0; f < dims; ++f) {
+            result.centroids[c][f] = centers[f * k + c];
+        }
+    }
+
+    return result;
+}
+
+std::vector<MeasurementData> DataProcessor::normalizeData(const std::vector<MeasurementData>& data,
+                                                         NormalizationMethod method) {
+    static const std::vector<DataField> numericFields = {
+        DataField::HEIGHT, DataField::ANGLE, DataField::CAPACITANCE, DataField::TEMPERATURE,
+        DataField::UPPER_SENSOR_1, DataField::UPPER_SENSOR_2,
+        DataField::LOWER_SENSOR_1, DataField::LOWER_SENSOR_2
+    };
+
+    auto columns = extractColumns(data, numericFields);
+    for (auto& column : columns.values) {
+        normalizeValues(column, method);
+    }
+
+    // 归一化后的高度/角度不再是物理量：原值写入，理论电容和安全限位保持不变
+    std::vector<MeasurementData> normalized = data;
+    writeColumns(normalized, columns, false);
+
+    return normalized;
+}
+
+TimeSeriesAnalysis DataProcessor::analyzeTimeSeries(const std::vector<MeasurementData>& data) {
+    TimeSeriesAnalysis result{};
+    if (data.size() < 2) {
+        return result;
+    }
+
+    // 单次遍历：间隔（秒）及其极值、总和
+    result.intervals.resize(data.size() - 1);
+    double sum = 0.0;
+    double minInterval = std::numeric_limits<double>::max();
+    double maxInterval = std::numeric_limits<double>::lowest();
+    int64_t previous = data[0].getTimestamp();
+    for (size_t i = 1; i < data.size(); ++i) {
+        int64_t current = data[i].getTimestamp();
+        double interval = (current - previous) / 1000.0;
+        previous = current;
+
+        result.intervals[i - 1] = interval;
+        sum += interval;
+        minInterval = std::min(minInterval, interval);
+        maxInterval = std::max(maxInterval, interval);
+    }
+
+    result.totalDuration = sum;
+    result.meanInterval = sum / result.intervals.size();
+    result.minInterval = minInterval;
+    result.maxInterval = maxInterval;
+    result.samplingRate = result.meanInterval > 0.0 ? 1.0 / result.meanInterval : 0.0;
+
+    // 间隔抖动不超过平均间隔的5%（至少容许1ms的时间戳量化）视为均匀采样
+    double tolerance = std::max(0.05 * result.meanInterval, 0.001);
+    result.isUniform = result.meanInterval > 0.0 && (maxInterval - minInterval) <= tolerance;
+
+    return result;
+}
+
+std::vector<DerivativePoint> DataProcessor::calculateDerivative(const std::vector<MeasurementData>& data,
+                                                                DataField xField, DataField yField) {
+    std::vector<DerivativePoint> result;
+    const size_t n = data.size();
+    if (n < 2) {
+        return result;
+    }
+
+    auto columns = extractColumns(data, {xField, yField});
+    const double* x = columns.values[0].data();
+    const double* y = columns.values[1].data();
+    result.resize(n);
+
+    // 内部点：非均匀网格三点中心差分（一阶、二阶导数）
+    for (size_t i = 1; i + 1 < n; ++i) {
+        double h0 = x[i] - x[i - 1];
+        double h1 = x[i + 1] - x[i];
+        double denom = h0 * h1 * (h0 + h1);
+
+        result[i].x = x[i];
+        if (h0 != 0.0 && h1 != 0.0 && (h0 + h1) != 0.0) {
+            result[i].value = (h0 * h0 * y[i + 1] - h1 * h1 * y[i - 1] + (h1 * h1 - h0 * h0) * y[i]) / denom;
+            result[i].secondDerivative = 2.0 * (h0 * y[i + 1] - (h0 + h1) * y[i] + h1 * y[i - 1]) / denom;
+        } else if (h1 != 0.0) {
+            result[i].value = (y[i + 1] - y[i]) / h1;
+        } else if (h0 != 0.0) {
+            result[i].value = (y[i] - y[i - 1]) / h0;
+        }
+    }
+
+    // 端点：单侧差分，二阶导数取相邻内部点
+    double hFirst = x[1] - x[0];
+    double hLast = x[n - 1] - x[n - 2];
+    result[0].x = x[0];
+    result[0].value = hFirst != 0.0 ? (y[1] - y[0]) / hFirst : 0.0;
+    result[n - 1].x = x[n - 1];
+    result[n - 1].value = hLast != 0.0 ? (y[n - 1] - y[n - 2]) / hLast : 0.0;
+    if (n > 2) {
+        result[0].secondDerivative = result[1].secondDerivative;
+        result[n - 1].secondDerivative = result[n - 2].secondDerivative;
+    }
+
+    return result;
+}
+
+double DataProcessor::calculateIntegral(const std::vector<MeasurementData>& data,
+                                        DataField xField, DataField yField,
+                                        IntegrationMethod method) {
+    const size_t n = data.size();
+    if (n < 2) {
+        return 0.0;
+    }
+
+    auto columns = extractColumns(data, {xField, yField});
+    const double* x = columns.values[0].data();
+    const double* y = columns.values[1].data();
+
+    double integral = 0.0;
+    size_t i = 0;
+
+    if (method == IntegrationMethod::SIMPSON) {
+        // 非均匀网格的复合Simpson：每两个区间拟合一条抛物线
+        for (; i + 2 < n; i += 2) {
+            double h0 = x[i + 1] - x[i];
+            double h1 = x[i + 2] - x[i + 1];
+            if (h0 == 0.0 || h1 == 0.0) {
+                integral += 0.5 * h0 * (y[i] + y[i + 1]) + 0.5 * h1 * (y[i + 1] + y[i + 2]);
+                continue;
+            }
+            double h = h0 + h1;
+            integral += h / 6.0 * ((2.0 - h1 / h0) * y[i] +
+                                   h * h / (h0 * h1) * y[i + 1] +
+                                   (2.0 - h0 / h1) * y[i + 2]);
+        }
+    }
+
+    // 梯形法（Simpson剩余的奇数个区间也用梯形法补齐）
+    for (; i + 1 < n; ++i) {
+        integral += 0.5 * (x[i + 1] - x[i]) * (y[i] + y[i + 1]);
+    }
+
+    return integral;
+}
+
+std::map<std::string, std::vector<MeasurementData>> DataProcessor::groupData(
+    const std::vector<MeasurementData>& data,
+    std::function<std::string(const MeasurementData&)> groupingFunction) {
+    std::map<std::string, std::vector<MeasurementData>> groups;
+    if (!groupingFunction) {
+        return groups;
+    }
+
+    // 相邻记录常属同一组，缓存上一次的组避免重复查找
+    std::vector<MeasurementData>* current = nullptr;
+    std::string currentKey;
+    for (const auto& m : data) {
+        std::string key = groupingFunction(m);
+        if (!current || key != currentKey) {
+            current = &groups[key];
+            currentKey = std::move(key);
+        }
+        current->push_back(m);
+    }
+
+    return groups;
+}
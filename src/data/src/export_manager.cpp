@@ -1,6 +1,9 @@
 #include "../include/export_manager.h"
 #include "../../utils/include/logger.h"
 #include "../include/file_manager.h"
+#include "../include/chunked_export.h"
+#include "../include/record_writer.h"
+#include "../../utils/include/format_utils.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -10,9 +13,6 @@
 #include <ctime>
 
 ExportManager::ExportManager() {
-    // 初始化写缓冲区
-    writeBuffer = std::make_unique<char[]>(writeBufferSize);
-    
     ExportTemplate csvTemplate;
     csvTemplate.name = "Standard CSV";
     csvTemplate.description = "Standard CSV format with all fields";
@@ -22,77 +22,65 @@ ExportManager::ExportManager() {
     LOG_INFO("ExportManager initialized");
 }
 
-ExportManager::~ExportManager() = default;
+ExportManager::~ExportManager() {
+    // 取消未完成的后台任务；线程池析构时执行完队列中的任务（已取消的任务立即结束）
+    std::vector<std::weak_ptr<ExportJob>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(jobs);
+    }
+    for (auto& weak : pending) {
+        if (auto job = weak.lock()) {
+            job->cancel();
+        }
+    }
+    jobPool.reset();
+}
 
 bool ExportManager::exportData(const std::vector<MeasurementData>& data,
                               const std::string& filename,
                               const ExportOptions& options) {
-    if (data.empty()) {
-        setError("No data to export");
-        return false;
-    }
-    
-    auto startTime = std::chrono::steady_clock::now();
-    lastExportStats = ExportStatistics();
-    lastExportStats.totalRecords = data.size();
-    lastExportStats.filename = filename;
-    
-    bool success = false;
-    
+    return exportData(VectorMeasurementSource(data), filename, options);
+}
+
+bool ExportManager::exportData(const MeasurementSource& source,
+                              const std::string& filename,
+                              const ExportOptions& options) {
+    const size_t total = source.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastExportStats = ExportStatistics();
+        lastExportStats.totalRecords = static_cast<int>(total);
+        lastExportStats.filename = filename;
+    }
+    
+    ExportTarget target;
+    target.filename = filename;
+    target.options = options;
+    
+    // 多个目标时由各自的写线程回调
+    std::atomic<size_t> written{0};
+    auto progress = [&](size_t records, size_t) {
+        if (records == 0) return;
+        size_t done = written.fetch_add(records) + records;
+        notifyProgress(static_cast<int>(std::min(done, total)), static_cast<int>(total));
+    };
+    
+    std::vector<ExportStatistics> results;
+    std::string error;
     try {
-        switch (options.format) {
-            case ExportFormat::CSV:
-                success = exportCSV(data, filename, options);
-                break;
-                
-            case ExportFormat::JSON:
-                success = exportJSON(data, filename, options);
-                break;
-                
-            case ExportFormat::XML:
-                success = exportXML(data, filename, options);
-                break;
-                
-            case ExportFormat::TEXT:
-                success = exportText(data, filename, options);
-                break;
-                
-            case ExportFormat::MATLAB:
-                success = exportMATLAB(data, filename, options);
-                break;
-                
-            case ExportFormat::EXCEL:
-                // Excel格式可能需要外部库，这里使用CSV作为替代
-                LOG_WARNING("Excel format not fully supported, using CSV instead");
-                success = exportCSV(data, filename, options);
-                break;
-                
-            default:
-                setError("Unsupported export format");
-                return false;
-        }
-        
-        if (success && options.compress) {
-            success = compressFile(filename);
-        }
-        
-        if (success) {
-            lastExportStats.exportedRecords = data.size();
-            FileManager fm;
-            lastExportStats.fileSize = fm.getFileSize(filename);
-            lastExportStats.exportDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::steady_clock::now() - startTime).count();
-            
-            notifyCompletion(lastExportStats);
-            LOG_INFO_F("Exported %zu records to %s", data.size(), filename.c_str());
+        if (!runExport(source, {target}, CancellationToken(), progress, results, error)) {
+            setError(error);
+            return false;
         }
-        
     } catch (const std::exception& e) {
         setError(std::string("Export failed: ") + e.what());
         return false;
     }
     
-    return success;
+    std::lock_guard<std::mutex> lock(mutex);
+    lastExportStats = results.front();
+    return true;
 }
 
 bool ExportManager::exportFiltered(const std::vector<MeasurementData>& data,
@@ -116,16 +104,121 @@ bool ExportManager::batchExport(const std::vector<MeasurementData>& data,
         return false;
     }
     
-    bool allSuccess = true;
-    
+    std::vector<ExportTarget> targets(filenames.size());
     for (size_t i = 0; i < filenames.size(); ++i) {
-        if (!exportData(data, filenames[i], options[i])) {
-            LOG_ERROR_F("Batch export failed for file: %s", filenames[i].c_str());
-            allSuccess = false;
+        targets[i].filename = filenames[i];
+        targets[i].options = options[i];
+    }
+    
+    const size_t total = data.size() * targets.size();
+    // 多个目标时由各自的写线程回调
+    std::atomic<size_t> written{0};
+    auto progress = [&](size_t records, size_t) {
+        if (records == 0) return;
+        size_t done = written.fetch_add(records) + records;
+        notifyProgress(static_cast<int>(std::min(done, total)), static_cast<int>(total));
+    };
+    
+    std::vector<ExportStatistics> results;
+    std::string error;
+    try {
+        if (!runExport(VectorMeasurementSource(data), targets, CancellationToken(), progress, results, error)) {
+            setError("Batch export failed: " + error);
+            return false;
+        }
+    } catch (const std::exception& e) {
+        setError(std::string("Batch export failed: ") + e.what());
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    lastExportStats = results.back();
+    return true;
+}
+
+std::shared_ptr<ExportJob> ExportManager::submitExport(std::shared_ptr<const MeasurementSource> source,
+                                                       const std::vector<ExportTarget>& targets) {
+    std::shared_ptr<ExportJob> job(new ExportJob());
+    if (!source || targets.empty()) {
+        job->complete(ExportJobStatus::FAILED, "No export source or targets", {});
+        return job;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!jobPool) {
+            // 导出任务以磁盘写入为主，两个工作线程足够；格式化使用共享线程池
+            jobPool = std::make_unique<ThreadPool>(2);
         }
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                                  [](const std::weak_ptr<ExportJob>& weak) { return weak.expired(); }),
+                   jobs.end());
+        jobs.push_back(job);
+    }
+    
+    jobPool->post([this, job, source, targets]() {
+        runJob(*job, *source, targets);
+    });
+    return job;
+}
+
+std::shared_ptr<ExportJob> ExportManager::submitExport(std::vector<MeasurementData> data,
+                                                       const std::vector<ExportTarget>& targets) {
+    // 数据源持有数据本身，调用方不必保持vector有效
+    struct OwnedSource : VectorMeasurementSource {
+        explicit OwnedSource(std::shared_ptr<const std::vector<MeasurementData>> owned)
+            : VectorMeasurementSource(*owned), owned(std::move(owned)) {}
+        std::shared_ptr<const std::vector<MeasurementData>> owned;
+    };
+    auto owned = std::make_shared<const std::vector<MeasurementData>>(std::move(data));
+    return submitExport(std::make_shared<OwnedSource>(owned), targets);
+}
+
+void ExportManager::runJob(ExportJob& job, const MeasurementSource& source,
+                           const std::vector<ExportTarget>& targets) {
+    if (job.cancellation.isCancelled()) {
+        job.complete(ExportJobStatus::CANCELLED, "Export cancelled", {});
+        return;
+    }
+    job.setRunning();
+    
+    auto progress = [&](size_t records, size_t bytes) {
+        job.bytesWritten += bytes;
+        if (records == 0) return;
+        job.recordsWritten += records;
+        int percentage = job.getProgress();
+        int previous = job.reportedProgress.load();
+        while (percentage > previous) {
+            if (job.reportedProgress.compare_exchange_weak(previous, percentage)) {
+                notifyProgress(percentage, 100);
+                break;
+            }
+        }
+    };
+    
+    std::vector<ExportStatistics> results;
+    std::string error;
+    bool success = false;
+    try {
+        job.totalRecords = source.size() * targets.size();
+        success = runExport(source, targets, job.cancellation, progress, results, error);
+    } catch (const std::exception& e) {
+        error = std::string("Export failed: ") + e.what();
     }
     
-    return allSuccess;
+    if (success) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastExportStats = results.back();
+        }
+        job.complete(ExportJobStatus::COMPLETED, "", std::move(results));
+    } else if (job.cancellation.isCancelled()) {
+        LOG_INFO("Background export cancelled");
+        job.complete(ExportJobStatus::CANCELLED, error, {});
+    } else {
+        LOG_ERROR("Background export failed: " + error);
+        job.complete(ExportJobStatus::FAILED, error, {});
+    }
 }
 
 void ExportManager::addTemplate(const ExportTemplate& template_) {
@@ -153,15 +246,19 @@ std::vector<ExportTemplate> ExportManager::getTemplates() const {
 bool ExportManager::exportUsingTemplate(const std::vector<MeasurementData>& data,
                                        const std::string& filename,
                                        const std::string& templateName) {
-    std::lock_guard<std::mutex> lock(mutex);
-    
-    auto it = templates.find(templateName);
-    if (it == templates.end()) {
-        setError("Template not found: " + templateName);
-        return false;
+    ExportOptions options;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = templates.find(templateName);
+        if (it == templates.end()) {
+            lastError = "Template not found: " + templateName;
+            LOG_ERROR(lastError);
+            return false;
+        }
+        options = it->second.options;
     }
     
-    return exportData(data, filename, it->second.options);
+    return exportData(data, filename, options);
 }
 
 bool ExportManager::exportStatistics(const std::vector<MeasurementData>& data,
@@ -171,69 +268,12 @@ bool ExportManager::exportStatistics(const std::vector<MeasurementData>& data,
         return false;
     }
     
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        setError("Failed to open file: " + filename);
+    StatisticsRecordWriter writer(filename);
+    if (!writer.write(data.data(), data.size()) || !writer.finish()) {
+        setError(writer.getError());
         return false;
     }
     
-    // 计算统计信息
-    double sumHeight = 0.0, sumAngle = 0.0, sumCap = 0.0;
-    double minHeight = data[0].getSetHeight();
-    double maxHeight = minHeight;
-    double minAngle = data[0].getSetAngle();
-    double maxAngle = minAngle;
-    
-    for (const auto& m : data) {
-        double h = m.getSetHeight();
-        double a = m.getSetAngle();
-        double c = m.getTheoreticalCapacitance();
-        
-        sumHeight += h;
-        sumAngle += a;
-        sumCap += c;
-        
-        minHeight = std::min(minHeight, h);
-        maxHeight = std::max(maxHeight, h);
-        minAngle = std::min(minAngle, a);
-        maxAngle = std::max(maxAngle, a);
-    }
-    
-    double avgHeight = sumHeight / data.size();
-    double avgAngle = sumAngle / data.size();
-    double avgCap = sumCap / data.size();
-    
-    // 写入统计信息
-    file << "Measurement Data Statistics\n";
-    file << "==========================\n\n";
-    file << "Total Records: " << data.size() << "\n\n";
-    
-    file << "Height Statistics:\n";
-    file << "  Average Height: " << std::fixed << std::setprecision(2) << avgHeight << " mm\n";
-    file << "  Min Height: " << minHeight << " mm\n";
-    file << "  Max Height: " << maxHeight << " mm\n";
-    file << "  Range: " << (maxHeight - minHeight) << " mm\n\n";
-    
-    file << "Angle Statistics:\n";
-    file << "  Average Angle: " << avgAngle << "°\n";
-    file << "  Min Angle: " << minAngle << "°\n";
-    file << "  Max Angle: " << maxAngle << "°\n";
-    file << "  Range: " << (maxAngle - minAngle) << "°\n\n";
-    
-    file << "Capacitance Statistics:\n";
-    file << "  Average Capacitance: " << avgCap << " pF\n";
-    
-    // 时间范围
-    if (!data.empty()) {
-        auto firstTime = formatTimestamp(data.front().getTimestamp(), "%Y-%m-%d %H:%M:%S");
-        auto lastTime = formatTimestamp(data.back().getTimestamp(), "%Y-%m-%d %H:%M:%S");
-        
-        file << "\nTime Range:\n";
-        file << "  First Record: " << firstTime << "\n";
-        file << "  Last Record: " << lastTime << "\n";
-    }
-    
-    file.close();
     LOG_INFO_F("Statistics exported to %s", filename.c_str());
     return true;
 }
@@ -351,6 +391,7 @@ void ExportManager::clearError() {
 }
 
 ExportStatistics ExportManager::getLastExportStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
     return lastExportStats;
 }
 
@@ -364,174 +405,191 @@ ExportOptions ExportManager::getDefaultOptions() const {
 
 // 私有方法实现
 
-bool ExportManager::exportCSV(const std::vector<MeasurementData>& data,
-                             const std::string& filename,
-                             const ExportOptions& options) {
-    if (!writeBuffer) {
-        writeBuffer = std::make_unique<char[]>(writeBufferSize);
-    }
-    std::ofstream file;
+std::unique_ptr<RecordWriter> ExportManager::createWriter(const ExportTarget& target,
+                                                          const std::function<void(size_t, size_t)>& progress,
+                                                          const CancellationToken& cancellation,
+                                                          std::string& error) const {
+    const ExportOptions& options = target.options;
+    GzipOptions compression;
+    compression.level = options.compressionLevel;
+    compression.threads = options.compressionThreads;
     
-    if (options.useBuffering) {
-        file.rdbuf()->pubsetbuf(writeBuffer.get(), writeBufferSize);
+    if (target.statistics) {
+        return std::make_unique<StatisticsRecordWriter>(target.filename, progress,
+                                                        options.compress ? &compression : nullptr);
     }
     
-    file.open(filename);
-    if (!file.is_open()) {
-        setError("Failed to open file: " + filename);
-        return false;
-    }
+    std::string prefix;
+    std::string suffix;
+    ChunkedRecordWriter::ChunkFormatter formatter;
     
-    // 写入头部
-    if (options.includeHeader) {
-        file << generateCSVHeader(options) << options.lineEnding;
+    switch (options.format) {
+        case ExportFormat::EXCEL:
+            // Excel格式可能需要外部库，这里使用CSV作为替代
+            LOG_WARNING("Excel format not fully supported, using CSV instead");
+            [[fallthrough]];
+        case ExportFormat::CSV:
+            if (options.includeHeader) {
+                prefix = generateCSVHeader(options) + options.lineEnding;
+            }
+            formatter = [this, options](const MeasurementData* rows, size_t count, size_t, std::string& out) {
+                TimestampFormatter timestamps(options.dateFormat);
+                for (size_t i = 0; i < count; ++i) {
+                    appendCSVRecord(out, rows[i], options, timestamps);
+                    out += options.lineEnding;
+                }
+            };
+            break;
+            
+        case ExportFormat::JSON:
+            // 分隔符写在记录之前，不需要事先知道记录总数
+            prefix = "[";
+            suffix = options.prettyPrint ? "\n]" : "]";
+            formatter = [this, options](const MeasurementData* rows, size_t count, size_t firstIndex,
+                                        std::string& out) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (firstIndex + i > 0) out += ",";
+                    if (options.prettyPrint) out += "\n  ";
+                    appendJSONRecord(out, rows[i], options);
+                }
+            };
+            break;
+            
+        case ExportFormat::XML:
+            prefix = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<measurements>\n";
+            suffix = "</measurements>\n";
+            formatter = [options](const MeasurementData* rows, size_t count, size_t, std::string& out) {
+                for (size_t i = 0; i < count; ++i) {
+                    out += "  <measurement>\n";
+                    
+                    if (options.includeTimestamp) {
+                        out += "    <timestamp>";
+                        FormatUtils::appendInteger(out, rows[i].getTimestamp());
+                        out += "</timestamp>\n";
+                    }
+                    
+                    if (options.includeSetValues) {
+                        out += "    <set_height>";
+                        FormatUtils::appendFixed(out, rows[i].getSetHeight(), options.decimalPlaces);
+                        out += "</set_height>\n    <set_angle>";
+                        FormatUtils::appendFixed(out, rows[i].getSetAngle(), options.decimalPlaces);
+                        out += "</set_angle>\n";
+                    }
+                    
+                    // 添加其他字段...
+                    
+                    out += "  </measurement>\n";
+                }
+            };
+            break;
+            
+        case ExportFormat::TEXT:
+            prefix = "Measurement Data Export\n======================\n\n";
+            formatter = [](const MeasurementData* rows, size_t count, size_t firstIndex, std::string& out) {
+                for (size_t i = 0; i < count; ++i) {
+                    out += "Record ";
+                    FormatUtils::appendInteger(out, static_cast<int64_t>(firstIndex + i + 1));
+                    out += ":\n";
+                    out += rows[i].toLogString();
+                    out += "\n\n";
+                }
+            };
+            break;
+            
+        case ExportFormat::MATLAB:
+            // MATLAB格式需要专门的库支持
+            error = "MATLAB format not implemented";
+            return nullptr;
+            
+        default:
+            error = "Unsupported export format";
+            return nullptr;
     }
     
-    // 写入数据
-    int current = 0;
-    for (const auto& measurement : data) {
-        file << measurementToCSV(measurement, options) << options.lineEnding;
-        current++;
-        notifyProgress(current, data.size());
+    auto writer = std::make_unique<ChunkedRecordWriter>(formatter, options.chunkRecords, progress, cancellation);
+    if (!writer->open(target.filename, prefix, suffix, options.compress ? &compression : nullptr)) {
+        error = writer->getError();
+        return nullptr;
     }
-    
-    file.close();
-    return true;
+    return writer;
 }
 
-bool ExportManager::exportJSON(const std::vector<MeasurementData>& data,
-                              const std::string& filename,
-                              const ExportOptions& options) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        setError("Failed to open file: " + filename);
+bool ExportManager::runExport(const MeasurementSource& source, const std::vector<ExportTarget>& targets,
+                              const CancellationToken& cancellation,
+                              const std::function<void(size_t, size_t)>& progress,
+                              std::vector<ExportStatistics>& results, std::string& error) {
+    const size_t total = source.size();
+    if (total == 0) {
+        error = "No data to export";
         return false;
     }
     
-    file << "[";
-    if (options.prettyPrint) file << "\n";
+    auto startTime = std::chrono::steady_clock::now();
     
-    for (size_t i = 0; i < data.size(); ++i) {
-        if (options.prettyPrint) file << "  ";
-        file << measurementToJSON(data[i], options);
-        
-        if (i < data.size() - 1) {
-            file << ",";
+    std::vector<std::unique_ptr<RecordWriter>> writers;
+    std::vector<RecordWriter*> active;
+    for (const auto& target : targets) {
+        auto writer = createWriter(target, progress, cancellation, error);
+        if (!writer) {
+            // 已打开的目标随writers析构关闭
+            return false;
         }
-        
-        if (options.prettyPrint) file << "\n";
-        notifyProgress(i + 1, data.size());
+        active.push_back(writer.get());
+        writers.push_back(std::move(writer));
     }
     
-    file << "]";
-    file.close();
-    return true;
-}
-
-bool ExportManager::exportXML(const std::vector<MeasurementData>& data,
-                             const std::string& filename,
-                             const ExportOptions& options) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        setError("Failed to open file: " + filename);
+    if (!RecordWriter::drive(source, active, cancellation, &error)) {
         return false;
     }
     
-    file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    file << "<measurements>\n";
-    
-    for (size_t i = 0; i < data.size(); ++i) {
-        file << "  <measurement>\n";
-        
-        if (options.includeTimestamp) {
-            file << "    <timestamp>" << data[i].getTimestamp() << "</timestamp>\n";
-        }
-        
-        if (options.includeSetValues) {
-            file << "    <set_height>" << formatValue(data[i].getSetHeight(), options.decimalPlaces) << "</set_height>\n";
-            file << "    <set_angle>" << formatValue(data[i].getSetAngle(), options.decimalPlaces) << "</set_angle>\n";
-        }
+    results.clear();
+    for (size_t i = 0; i < targets.size(); ++i) {
+        ExportStatistics stats;
+        stats.totalRecords = static_cast<int>(total);
+        stats.exportedRecords = static_cast<int>(writers[i]->getRecordCount());
+        stats.filename = targets[i].filename;
+        FileManager fm;
+        stats.fileSize = fm.getFileSize(targets[i].filename);
+        stats.exportDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        results.push_back(stats);
         
-        // 添加其他字段...
-        
-        file << "  </measurement>\n";
-        notifyProgress(i + 1, data.size());
-    }
-    
-    file << "</measurements>\n";
-    file.close();
-    return true;
-}
-
-bool ExportManager::exportText(const std::vector<MeasurementData>& data,
-                              const std::string& filename,
-                              const ExportOptions& options) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        setError("Failed to open file: " + filename);
-        return false;
+        LOG_INFO_F("Exported %d records to %s", stats.exportedRecords, stats.filename.c_str());
     }
     
-    file << "Measurement Data Export\n";
-    file << "======================\n\n";
-    
-    for (size_t i = 0; i < data.size(); ++i) {
-        file << "Record " << (i + 1) << ":\n";
-        file << data[i].toLogString() << "\n\n";
-        notifyProgress(i + 1, data.size());
+    for (const auto& stats : results) {
+        notifyCompletion(stats);
     }
-    
-    file.close();
     return true;
 }
 
-bool ExportManager::exportMATLAB(const std::vector<MeasurementData>& data,
-                                const std::string& filename,
-                                const ExportOptions& options) {
-    // MATLAB格式需要专门的库支持
-    setError("MATLAB format not implemented");
-    return false;
-}
-
 std::string ExportManager::formatValue(double value, int decimalPlaces) const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(decimalPlaces) << value;
-    return oss.str();
+    return FormatUtils::formatFixed(value, decimalPlaces);
 }
 
 std::string ExportManager::formatTimestamp(int64_t timestamp, const std::string& format) const {
-    auto seconds = timestamp / 1000;
-    std::time_t time = static_cast<std::time_t>(seconds);
-    std::tm tm{};
-    #ifdef _WIN32
-    localtime_s(&tm, &time);
-    #else
-    localtime_r(&time, &tm);
-    #endif
-
-    std::ostringstream oss;
-    oss << std::put_time(&tm, format.c_str());
-    return oss.str();
+    return TimestampFormatter(format).format(timestamp);
 }
 
-std::string ExportManager::escapeCSV(const std::string& value, const ExportOptions& options) const {
-    if (value.find(options.delimiter) != std::string::npos ||
-        value.find(options.quoteChar) != std::string::npos ||
-        value.find('\n') != std::string::npos ||
-        value.find('\r') != std::string::npos) {
-        
-        std::string escaped = value;
-        // 替换引号
-        size_t pos = 0;
-        while ((pos = escaped.find(options.quoteChar, pos)) != std::string::npos) {
-            escaped.insert(pos, 1, options.quoteChar);
-            pos += 2;
+void ExportManager::escapeCSV(std::string& out, size_t fieldStart, const ExportOptions& options) const {
+    if (out.find(options.delimiter, fieldStart) == std::string::npos &&
+        out.find(options.quoteChar, fieldStart) == std::string::npos &&
+        out.find('\n', fieldStart) == std::string::npos &&
+        out.find('\r', fieldStart) == std::string::npos) {
+        return;
+    }
+
+    std::string field = out.substr(fieldStart);
+    out.resize(fieldStart);
+    out += options.quoteChar;
+    for (char c : field) {
+        // 引号加倍
+        if (c == options.quoteChar) {
+            out += c;
         }
-        
-        return std::string(1, options.quoteChar) + escaped + options.quoteChar;
+        out += c;
     }
-    
-    return value;
+    out += options.quoteChar;
 }
 
 std::string ExportManager::generateCSVHeader(const ExportOptions& options) const {
@@ -575,81 +633,84 @@ std::string ExportManager::generateCSVHeader(const ExportOptions& options) const
     return result;
 }
 
-std::string ExportManager::measurementToCSV(const MeasurementData& data, const ExportOptions& options) const {
-    std::vector<std::string> values;
+void ExportManager::appendCSVRecord(std::string& out, const MeasurementData& data,
+                                    const ExportOptions& options, TimestampFormatter& timestamps) const {
+    bool first = true;
+    auto appendField = [&](double value) {
+        if (!first) out += options.delimiter;
+        first = false;
+        size_t fieldStart = out.size();
+        FormatUtils::appendFixed(out, value, options.decimalPlaces);
+        escapeCSV(out, fieldStart, options);
+    };
     
     if (options.includeTimestamp) {
-        values.push_back(formatTimestamp(data.getTimestamp(), options.dateFormat));
+        first = false;
+        size_t fieldStart = out.size();
+        timestamps.append(out, data.getTimestamp());
+        escapeCSV(out, fieldStart, options);
     }
     
     if (options.includeSetValues) {
-        values.push_back(formatValue(data.getSetHeight(), options.decimalPlaces));
-        values.push_back(formatValue(data.getSetAngle(), options.decimalPlaces));
-        values.push_back(formatValue(data.getTheoreticalCapacitance(), options.decimalPlaces));
+        appendField(data.getSetHeight());
+        appendField(data.getSetAngle());
+        appendField(data.getTheoreticalCapacitance());
     }
     
     if (options.includeSensorData) {
         const auto& sensor = data.getSensorData();
         // 直接访问公共成员变量，而不是使用不存在的getter方法
-        values.push_back(formatValue(sensor.distanceUpper1, options.decimalPlaces));
-        values.push_back(formatValue(sensor.distanceUpper2, options.decimalPlaces));
-        values.push_back(formatValue(sensor.distanceLower1, options.decimalPlaces));
-        values.push_back(formatValue(sensor.distanceLower2, options.decimalPlaces));
-        values.push_back(formatValue(sensor.temperature, options.decimalPlaces));
-        values.push_back(formatValue(sensor.angle, options.decimalPlaces));
-        values.push_back(formatValue(sensor.capacitance, options.decimalPlaces));
+        appendField(sensor.distanceUpper1);
+        appendField(sensor.distanceUpper2);
+        appendField(sensor.distanceLower1);
+        appendField(sensor.distanceLower2);
+        appendField(sensor.temperature);
+        appendField(sensor.angle);
+        appendField(sensor.capacitance);
     }
     
     if (options.includeCalculatedValues) {
         const auto& sensor = data.getSensorData();
         // 这些方法在SensorData中是存在的
-        values.push_back(formatValue(sensor.getAverageHeight(), options.decimalPlaces));
-        values.push_back(formatValue(sensor.getCalculatedAngle(), options.decimalPlaces));
-        values.push_back(formatValue(data.getCapacitanceDifference(), options.decimalPlaces));
-    }
-    
-    // 组合值
-    std::string result;
-    for (size_t i = 0; i < values.size(); ++i) {
-        result += escapeCSV(values[i], options);
-        if (i < values.size() - 1) {
-            result += options.delimiter;
-        }
+        appendField(sensor.getAverageHeight());
+        appendField(sensor.getCalculatedAngle());
+        appendField(data.getCapacitanceDifference());
     }
-    
-    return result;
 }
 
-std::string ExportManager::measurementToJSON(const MeasurementData& data, const ExportOptions& options) const {
-    std::ostringstream json;
-    json << "{";
+void ExportManager::appendJSONRecord(std::string& out, const MeasurementData& data,
+                                     const ExportOptions& options) const {
+    out += '{';
     
     bool first = true;
     
     if (options.includeTimestamp) {
-        json << "\"timestamp\":" << data.getTimestamp();
+        out += "\"timestamp\":";
+        FormatUtils::appendInteger(out, data.getTimestamp());
         first = false;
     }
     
     if (options.includeSetValues) {
-        if (!first) json << ",";
-        json << "\"set_height\":" << formatValue(data.getSetHeight(), options.decimalPlaces);
-        json << ",\"set_angle\":" << formatValue(data.getSetAngle(), options.decimalPlaces);
-        json << ",\"theoretical_capacitance\":" << formatValue(data.getTheoreticalCapacitance(), options.decimalPlaces);
+        if (!first) out += ',';
+        out += "\"set_height\":";
+        FormatUtils::appendFixed(out, data.getSetHeight(), options.decimalPlaces);
+        out += ",\"set_angle\":";
+        FormatUtils::appendFixed(out, data.getSetAngle(), options.decimalPlaces);
+        out += ",\"theoretical_capacitance\":";
+        FormatUtils::appendFixed(out, data.getTheoreticalCapacitance(), options.decimalPlaces);
         first = false;
     }
     
     // 添加其他字段...
     
-    json << "}";
-    return json.str();
+    out += '}';
 }
 
 void ExportManager::notifyProgress(int current, int total) {
     if (total <= 0) return;
     ProgressCallback cb;
     { std::lock_guard<std::mutex> lock(mutex); cb = progressCallback; }
-    if (cb) cb((current * 100) / total);
+    if (cb) cb(static_cast<int>((static_cast<int64_t>(current) * 100) / total));
 }
 
 void ExportManager::notifyCompletion(const ExportStatistics& stats) {
@@ -664,8 +725,75 @@ void ExportManager::setError(const std::string& error) {
     LOG_ERROR(error);
 }
 
-bool ExportManager::compressFile(const std::string& filename) {
-    // 压缩功能需要zlib或类似库的支持
-    LOG_WARNING("File compression not implemented");
-    return true;
+// ExportJob
+
+ExportJobStatus ExportJob::getStatus() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return status;
+}
+
+bool ExportJob::isFinished() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return status == ExportJobStatus::COMPLETED || status == ExportJobStatus::FAILED ||
+           status == ExportJobStatus::CANCELLED;
+}
+
+int ExportJob::getProgress() const {
+    if (getStatus() == ExportJobStatus::COMPLETED) {
+        return 100;
+    }
+    size_t total = totalRecords.load();
+    if (total == 0) {
+        return 0;
+    }
+    return static_cast<int>(std::min<size_t>(recordsWritten.load() * 100 / total, 100));
+}
+
+size_t ExportJob::getBytesWritten() const {
+    return bytesWritten.load();
+}
+
+std::string ExportJob::getError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+std::vector<ExportStatistics> ExportJob::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+void ExportJob::cancel() {
+    cancellation.cancel();
+}
+
+ExportJobStatus ExportJob::wait() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    finishedCondition.wait(lock, [this] {
+        return status != ExportJobStatus::PENDING && status != ExportJobStatus::RUNNING;
+    });
+    return status;
+}
+
+bool ExportJob::waitFor(int timeoutMs) const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return finishedCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return status != ExportJobStatus::PENDING && status != ExportJobStatus::RUNNING;
+    });
+}
+
+void ExportJob::setRunning() {
+    std::lock_guard<std::mutex> lock(mutex);
+    status = ExportJobStatus::RUNNING;
+}
+
+void ExportJob::complete(ExportJobStatus finalStatus, const std::string& reason,
+                         std::vector<ExportStatistics> results) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        status = finalStatus;
+        error = reason;
+        statistics = std::move(results);
+    }
+    finishedCondition.notify_all();
 }
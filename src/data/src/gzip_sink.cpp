@@ -0,0 +1,208 @@
+#include "../include/gzip_sink.h"
+#include "../../utils/include/thread_pool.h"
+#include <zlib.h>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kWindowSize = 32768;          // deflate窗口，也是块间预置字典的长度
+constexpr size_t kStreamOutputSize = 256 * 1024;
+
+int normalizeLevel(int level) {
+    return (level < 0 || level > 9) ? Z_DEFAULT_COMPRESSION : level;
+}
+
+void appendLittleEndian32(std::string& out, unsigned long value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+// 以dictionary为预置字典压缩一块原始deflate数据，final时结束整个流，否则同步刷新到字节边界
+bool deflateBlock(const char* dictionary, size_t dictionaryLength,
+                  const char* data, size_t length, int level, bool final, std::string& out) {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    bool ok = true;
+    if (dictionaryLength > 0) {
+        ok = deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary),
+                                  static_cast<uInt>(dictionaryLength)) == Z_OK;
+    }
+
+    out.resize(deflateBound(&stream, static_cast<uLong>(length)) + 64);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(length);
+    size_t produced = 0;
+    const int flush = final ? Z_FINISH : Z_SYNC_FLUSH;
+    while (ok) {
+        stream.next_out = reinterpret_cast<Bytef*>(&out[produced]);
+        stream.avail_out = static_cast<uInt>(out.size() - produced);
+        int result = deflate(&stream, flush);
+        produced = out.size() - stream.avail_out;
+        if (result == Z_STREAM_ERROR) {
+            ok = false;
+        } else if (stream.avail_out == 0) {
+            out.resize(out.size() * 2);
+        } else {
+            break;
+        }
+    }
+    out.resize(produced);
+    deflateEnd(&stream);
+    return ok;
+}
+
+} // namespace
+
+GzipSink::GzipSink(std::unique_ptr<ByteSink> downstream, const GzipOptions& options)
+    : downstream(std::move(downstream)), options(options) {
+    this->options.level = normalizeLevel(options.level);
+    this->options.blockSize = std::max<size_t>(options.blockSize, kWindowSize);
+    threads = options.threads > 0 ? options.threads : ThreadPool::shared().size() + 1;
+    crc = crc32(0L, Z_NULL, 0);
+
+    if (threads <= 1) {
+        // windowBits加16：由zlib写gzip头部和尾部
+        stream = std::make_unique<z_stream_s>();
+        *stream = z_stream_s{};
+        if (deflateInit2(stream.get(), this->options.level, Z_DEFLATED, 15 + 16, 8,
+                         Z_DEFAULT_STRATEGY) != Z_OK) {
+            stream.reset();
+            failed = true;
+        }
+        output.resize(kStreamOutputSize);
+    }
+}
+
+GzipSink::~GzipSink() {
+    if (stream) {
+        deflateEnd(stream.get());
+    }
+}
+
+bool GzipSink::writeHeader() {
+    // ID1 ID2 CM=deflate FLG=0 MTIME=0 XFL=0 OS=unix
+    static const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3};
+    headerWritten = true;
+    return downstream->write(header, sizeof(header));
+}
+
+bool GzipSink::deflateStream(const char* data, size_t size, int flush) {
+    stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream->avail_in = static_cast<uInt>(size);
+    do {
+        stream->next_out = output.data();
+        stream->avail_out = static_cast<uInt>(output.size());
+        if (deflate(stream.get(), flush) == Z_STREAM_ERROR) {
+            return false;
+        }
+        size_t produced = output.size() - stream->avail_out;
+        if (produced > 0 && !downstream->write(reinterpret_cast<const char*>(output.data()), produced)) {
+            return false;
+        }
+    } while (stream->avail_out == 0);
+    return true;
+}
+
+bool GzipSink::compressBlocks(bool final) {
+    const size_t available = pending.size() - dictionarySize;
+    size_t blocks = final ? std::max<size_t>((available + options.blockSize - 1) / options.blockSize, 1)
+                          : std::min(threads, available / options.blockSize);
+    if (blocks == 0) {
+        return true;
+    }
+    const size_t processed = final ? available : blocks * options.blockSize;
+
+    blockOutputs.resize(blocks);
+    blockCrcs.resize(blocks);
+    std::vector<char> blockOk(blocks, 1);
+    const char* base = pending.data();
+
+    ThreadPool::shared().parallelFor(blocks, [&](size_t k) {
+        size_t begin = dictionarySize + k * options.blockSize;
+        size_t length = std::min(options.blockSize, dictionarySize + processed - begin);
+        size_t dictionaryStart = begin > kWindowSize ? begin - kWindowSize : 0;
+        blockCrcs[k] = crc32(0L, reinterpret_cast<const Bytef*>(base + begin), static_cast<uInt>(length));
+        blockOk[k] = deflateBlock(base + dictionaryStart, begin - dictionaryStart, base + begin, length,
+                                  options.level, final && k + 1 == blocks, blockOutputs[k]);
+    });
+
+    for (size_t k = 0; k < blocks; ++k) {
+        if (!blockOk[k] || !downstream->write(blockOutputs[k].data(), blockOutputs[k].size())) {
+            return false;
+        }
+        size_t begin = k * options.blockSize;
+        size_t length = std::min(options.blockSize, processed - begin);
+        crc = crc32_combine(crc, blockCrcs[k], static_cast<z_off_t>(length));
+    }
+
+    // 保留已压缩部分的最后32KB作为下一批的字典
+    size_t end = dictionarySize + processed;
+    size_t keep = std::min(kWindowSize, end);
+    pending.erase(0, end - keep);
+    dictionarySize = keep;
+    return true;
+}
+
+bool GzipSink::write(const char* data, size_t size) {
+    if (failed || closed) {
+        return false;
+    }
+    consumed += size;
+
+    if (stream) {
+        // avail_in是32位，超大写入分段送入
+        constexpr size_t kMaxInput = 1u << 30;
+        while (size > 0 && !failed) {
+            size_t part = std::min(size, kMaxInput);
+            failed = !deflateStream(data, part, Z_NO_FLUSH);
+            data += part;
+            size -= part;
+        }
+        return !failed;
+    }
+
+    if (!headerWritten && !writeHeader()) {
+        failed = true;
+        return false;
+    }
+    pending.append(data, size);
+    while (!failed && pending.size() - dictionarySize >= threads * options.blockSize) {
+        failed = !compressBlocks(false);
+    }
+    return !failed;
+}
+
+bool GzipSink::close() {
+    if (closed) {
+        return !failed;
+    }
+    closed = true;
+
+    if (!failed) {
+        if (stream) {
+            failed = !deflateStream(nullptr, 0, Z_FINISH);
+        } else {
+            failed = (!headerWritten && !writeHeader()) || !compressBlocks(true);
+            if (!failed) {
+                std::string trailer;
+                appendLittleEndian32(trailer, crc);
+                appendLittleEndian32(trailer, static_cast<unsigned long>(consumed & 0xffffffffu));
+                failed = !downstream->write(trailer.data(), trailer.size());
+            }
+        }
+    }
+
+    if (stream) {
+        deflateEnd(stream.get());
+        stream.reset();
+    }
+    pending.clear();
+    pending.shrink_to_fit();
+    blockOutputs.clear();
+
+    bool downstreamClosed = downstream->close();
+    return !failed && downstreamClosed;
+}
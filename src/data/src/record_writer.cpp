@@ -0,0 +1,292 @@
+#include "../include/record_writer.h"
+#include "../../utils/include/format_utils.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+bool RecordWriter::drive(const MeasurementSource& source, const std::vector<RecordWriter*>& writers,
+                         const CancellationToken& cancellation, std::string* error) {
+    std::string failure;
+    const size_t expected = source.size();
+    size_t visited = 0;
+    bool complete = source.forEachChunk([&](const MeasurementData* rows, size_t count) {
+        if (cancellation.isCancelled()) {
+            failure = "Export cancelled";
+            return false;
+        }
+        for (RecordWriter* writer : writers) {
+            if (!writer->write(rows, count)) {
+                failure = writer->getError();
+                return false;
+            }
+        }
+        visited += count;
+        return true;
+    });
+    // 数据源中途停止，或提供的记录少于开始时的记录数，导出结果都不完整
+    if (failure.empty() && (!complete || visited < expected)) {
+        failure = "Data source stopped after " + std::to_string(visited) + " of " +
+                  std::to_string(expected) + " records";
+    }
+
+    // 失败后也要finish，结束各目标的写线程并关闭文件
+    for (RecordWriter* writer : writers) {
+        if (!writer->finish() && failure.empty()) {
+            failure = writer->getError();
+        }
+    }
+    if (failure.empty() && cancellation.isCancelled()) {
+        failure = "Export cancelled";
+    }
+
+    if (!failure.empty()) {
+        if (error) {
+            *error = failure;
+        }
+        return false;
+    }
+    return true;
+}
+
+ChunkedRecordWriter::ChunkedRecordWriter(ChunkFormatter formatter, size_t chunkRecords,
+                                         ProgressFn progress, const CancellationToken& cancellation)
+    : formatter(std::move(formatter)),
+      chunkRecords(std::max<size_t>(chunkRecords, 1)),
+      progress(std::move(progress)),
+      cancellation(cancellation) {}
+
+ChunkedRecordWriter::~ChunkedRecordWriter() {
+    // 写线程引用sink，先于sink销毁
+    writer.reset();
+}
+
+bool ChunkedRecordWriter::open(const std::string& filename, const std::string& prefix,
+                               const std::string& suffix, const GzipOptions* compression) {
+    this->filename = filename;
+    this->suffix = suffix;
+
+    auto file = std::make_unique<FileSink>();
+    if (!file->open(filename)) {
+        error = "Failed to open file: " + filename;
+        failed = true;
+        return false;
+    }
+    if (compression) {
+        sink = std::make_unique<GzipSink>(std::move(file), *compression);
+    } else {
+        sink = std::move(file);
+    }
+    if (!sink->write(prefix.data(), prefix.size())) {
+        error = "Failed to write file: " + filename;
+        failed = true;
+        return false;
+    }
+
+    ChunkedExport::Options options;
+    options.cancellation = cancellation;
+    writer = std::make_unique<ChunkedExport::Writer>(
+        *sink, [this](size_t chunk) { chunkWritten(chunk); }, options);
+    batchRecords = writer->batchChunks() * chunkRecords;
+    return true;
+}
+
+void ChunkedRecordWriter::chunkWritten(size_t chunk) {
+    size_t end = 0;
+    {
+        std::lock_guard<std::mutex> lock(endsMutex);
+        end = chunkEnds[chunk];
+    }
+    size_t bytes = sink->bytesWritten();
+    if (progress) {
+        progress(end - reportedRecords, bytes - reportedBytes);
+    }
+    reportedRecords = end;
+    reportedBytes = bytes;
+}
+
+bool ChunkedRecordWriter::submit(const MeasurementData* rows, size_t count) {
+    const size_t chunks = (count + chunkRecords - 1) / chunkRecords;
+    {
+        std::lock_guard<std::mutex> lock(endsMutex);
+        for (size_t k = 0; k < chunks; ++k) {
+            chunkEnds.push_back(records + std::min((k + 1) * chunkRecords, count));
+        }
+    }
+    const size_t firstIndex = records;
+    records += count;
+    if (!writer->submit(chunks, [&](size_t k, std::string& out) {
+            size_t begin = k * chunkRecords;
+            formatter(rows + begin, std::min(chunkRecords, count - begin), firstIndex + begin, out);
+        })) {
+        // 取出写出管线记录的失败原因（写入失败、取消或格式化异常）
+        std::string failure;
+        writer->finish(&failure);
+        error = failure.empty() ? "Failed to write file: " + filename : failure;
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedRecordWriter::write(const MeasurementData* rows, size_t count) {
+    if (failed || !writer) {
+        return false;
+    }
+
+    // 数据源的块通常小于一批：凑满一批再提交；足够大的块直接格式化，不复制
+    while (count > 0) {
+        if (pending.empty() && count >= batchRecords) {
+            if (!submit(rows, batchRecords)) {
+                return false;
+            }
+            rows += batchRecords;
+            count -= batchRecords;
+            continue;
+        }
+        size_t take = std::min(batchRecords - pending.size(), count);
+        pending.insert(pending.end(), rows, rows + take);
+        rows += take;
+        count -= take;
+        if (pending.size() == batchRecords) {
+            bool ok = submit(pending.data(), pending.size());
+            pending.clear();
+            if (!ok) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ChunkedRecordWriter::finish() {
+    if (!writer) {
+        return false;
+    }
+
+    bool ok = !failed;
+    if (ok && !pending.empty()) {
+        ok = submit(pending.data(), pending.size());
+    }
+    pending.clear();
+    pending.shrink_to_fit();
+
+    std::string failure;
+    ok = writer->finish(&failure) && ok;
+    writer.reset();
+
+    ok = ok && sink->write(suffix.data(), suffix.size());
+    ok = sink->close() && ok;
+    if (ok && progress) {
+        progress(0, sink->bytesWritten() - reportedBytes);
+    }
+    reportedBytes = sink->bytesWritten();
+
+    if (!ok) {
+        failed = true;
+        if (error.empty()) {
+            error = failure.empty() ? "Failed to write file: " + filename : failure;
+        }
+    }
+    return ok;
+}
+
+size_t ChunkedRecordWriter::getBytesWritten() const {
+    return sink ? sink->bytesWritten() : 0;
+}
+
+StatisticsRecordWriter::StatisticsRecordWriter(const std::string& filename, ProgressFn progress,
+                                               const GzipOptions* compression)
+    : progress(std::move(progress)), compress(compression != nullptr) {
+    this->filename = filename;
+    if (compression) {
+        this->compression = *compression;
+    }
+}
+
+bool StatisticsRecordWriter::write(const MeasurementData* rows, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double h = rows[i].getSetHeight();
+        double a = rows[i].getSetAngle();
+        double c = rows[i].getTheoreticalCapacitance();
+
+        if (records == 0) {
+            minHeight = maxHeight = h;
+            minAngle = maxAngle = a;
+            firstTimestamp = rows[i].getTimestamp();
+        }
+        sumHeight += h;
+        sumAngle += a;
+        sumCapacitance += c;
+
+        minHeight = std::min(minHeight, h);
+        maxHeight = std::max(maxHeight, h);
+        minAngle = std::min(minAngle, a);
+        maxAngle = std::max(maxAngle, a);
+        lastTimestamp = rows[i].getTimestamp();
+        ++records;
+    }
+    if (progress) {
+        progress(count, 0);
+    }
+    return true;
+}
+
+bool StatisticsRecordWriter::finish() {
+    if (records == 0) {
+        error = "No data for statistics";
+        return false;
+    }
+
+    const double count = static_cast<double>(records);
+    TimestampFormatter timestamps;
+
+    std::ostringstream file;
+    file << "Measurement Data Statistics\n";
+    file << "==========================\n\n";
+    file << "Total Records: " << records << "\n\n";
+
+    file << "Height Statistics:\n";
+    file << "  Average Height: " << std::fixed << std::setprecision(2) << sumHeight / count << " mm\n";
+    file << "  Min Height: " << minHeight << " mm\n";
+    file << "  Max Height: " << maxHeight << " mm\n";
+    file << "  Range: " << (maxHeight - minHeight) << " mm\n\n";
+
+    file << "Angle Statistics:\n";
+    file << "  Average Angle: " << sumAngle / count << "°\n";
+    file << "  Min Angle: " << minAngle << "°\n";
+    file << "  Max Angle: " << maxAngle << "°\n";
+    file << "  Range: " << (maxAngle - minAngle) << "°\n\n";
+
+    file << "Capacitance Statistics:\n";
+    file << "  Average Capacitance: " << sumCapacitance / count << " pF\n";
+
+    // 时间范围
+    file << "\nTime Range:\n";
+    file << "  First Record: " << timestamps.format(firstTimestamp) << "\n";
+    file << "  Last Record: " << timestamps.format(lastTimestamp) << "\n";
+
+    const std::string text = file.str();
+    auto out = std::make_unique<FileSink>();
+    if (!out->open(filename)) {
+        error = "Failed to open file: " + filename;
+        return false;
+    }
+    std::unique_ptr<ByteSink> sink;
+    if (compress) {
+        sink = std::make_unique<GzipSink>(std::move(out), compression);
+    } else {
+        sink = std::move(out);
+    }
+    bool written = sink->write(text.data(), text.size());
+    if (!sink->close() || !written) {
+        error = "Failed to write file: " + filename;
+        return false;
+    }
+
+    bytes = sink->bytesWritten();
+    if (progress) {
+        progress(0, bytes);
+    }
+    return true;
+}
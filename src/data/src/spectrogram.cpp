@@ -0,0 +1,228 @@
+#include "../include/spectrogram.h"
+#include "../../utils/include/fft_plan.h"
+#include "../../utils/include/math_utils.h"
+#include "../../utils/include/logger.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+StreamingSpectrogram::StreamingSpectrogram(double rate, size_t length, size_t hop,
+                                           WindowFunction windowFunction)
+    : samplingRate(rate),
+      frameLength(std::max<size_t>(length, 2)),
+      hopLength(std::max<size_t>(std::min(hop, std::max<size_t>(length, 2)), 1)) {
+    if (samplingRate <= 0.0) {
+        throw std::invalid_argument("Sampling rate must be positive");
+    }
+
+    ring.assign(frameLength, 0.0);
+    segment.resize(frameLength);
+    window = DataProcessor::createWindow(windowFunction, frameLength);
+
+    size_t bins = frameLength / 2 + 1;
+    spectrum.resize(bins);
+
+    double windowPower = 0.0;
+    for (double w : window) {
+        windowPower += w * w;
+    }
+    scale.assign(bins, 2.0 / (samplingRate * windowPower));
+    scale[0] /= 2.0;
+    if (frameLength % 2 == 0) {
+        scale[bins - 1] /= 2.0;
+    }
+
+    plan = FFTPlan::get(frameLength);
+
+    LOG_INFO_F("StreamingSpectrogram initialized: %zu-point frames, hop %zu, %.1f Hz",
+               frameLength, hopLength, samplingRate);
+}
+
+StreamingSpectrogram::~StreamingSpectrogram() = default;
+
+void StreamingSpectrogram::pushSample(double value) {
+    pushSamples(&value, 1);
+}
+
+void StreamingSpectrogram::pushSamples(const std::vector<double>& values) {
+    pushSamples(values.data(), values.size());
+}
+
+void StreamingSpectrogram::pushSamples(const double* values, size_t count) {
+    std::vector<SpectrogramFrame> frames;
+    FrameCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        appendSamples(values, count, frames);
+        cb = frameCallback;
+    }
+
+    if (cb) {
+        for (const auto& frame : frames) {
+            cb(frame);
+        }
+    }
+}
+
+void StreamingSpectrogram::pushSensorData(const SensorData& data) {
+    std::vector<SpectrogramFrame> frames;
+    FrameCallback cb;
+    {
+        // 字段在锁内读取，与setField()互斥
+        std::lock_guard<std::mutex> lock(mutex);
+        double value = 0.0;
+        if (!sensorValue(data, field, value)) {
+            return;
+        }
+        appendSamples(&value, 1, frames);
+        cb = frameCallback;
+    }
+
+    if (cb) {
+        for (const auto& frame : frames) {
+            cb(frame);
+        }
+    }
+}
+
+void StreamingSpectrogram::appendSamples(const double* values, size_t count,
+                                         std::vector<SpectrogramFrame>& frames) {
+    for (size_t i = 0; i < count; ++i) {
+        ring[writePos] = values[i];
+        writePos = (writePos + 1) % frameLength;
+        ++totalSamples;
+        ++samplesSinceFrame;
+
+        bool firstFrame = frameCount == 0 && totalSamples >= frameLength;
+        if (firstFrame || (frameCount > 0 && samplesSinceFrame >= hopLength)) {
+            frames.emplace_back();
+            computeFrame(frames.back());
+            samplesSinceFrame = 0;
+        }
+    }
+}
+
+void StreamingSpectrogram::setFrameCallback(FrameCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    frameCallback = std::move(callback);
+}
+
+void StreamingSpectrogram::setField(DataField newField) {
+    std::lock_guard<std::mutex> lock(mutex);
+    field = newField;
+}
+
+DataField StreamingSpectrogram::getField() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return field;
+}
+
+void StreamingSpectrogram::setAveragingFactor(double alpha) {
+    std::lock_guard<std::mutex> lock(mutex);
+    averagingFactor = MathUtils::clamp(alpha, 0.0, 1.0);
+}
+
+std::vector<double> StreamingSpectrogram::getFrequencies() const {
+    std::vector<double> frequencies(frameLength / 2 + 1);
+    for (size_t k = 0; k < frequencies.size(); ++k) {
+        frequencies[k] = k * samplingRate / frameLength;
+    }
+    return frequencies;
+}
+
+std::vector<double> StreamingSpectrogram::getAveragedDensity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return averaged;
+}
+
+double StreamingSpectrogram::getPeakFrequency() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (averaged.size() < 2) {
+        return 0.0;
+    }
+
+    auto maxIt = std::max_element(averaged.begin() + 1, averaged.end());
+    return std::distance(averaged.begin(), maxIt) * samplingRate / frameLength;
+}
+
+size_t StreamingSpectrogram::getFrameCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return frameCount;
+}
+
+void StreamingSpectrogram::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fill(ring.begin(), ring.end(), 0.0);
+    writePos = 0;
+    totalSamples = 0;
+    samplesSinceFrame = 0;
+    averaged.clear();
+    frameCount = 0;
+}
+
+bool StreamingSpectrogram::sensorValue(const SensorData& data, DataField field, double& value) {
+    switch (field) {
+        case DataField::HEIGHT:
+            value = data.getAverageHeight();
+            return true;
+        case DataField::ANGLE:
+            value = data.angle;
+            return true;
+        case DataField::CAPACITANCE:
+            value = data.capacitance;
+            return true;
+        case DataField::TEMPERATURE:
+            value = data.temperature;
+            return true;
+        case DataField::UPPER_SENSOR_1:
+            value = data.distanceUpper1;
+            return true;
+        case DataField::UPPER_SENSOR_2:
+            value = data.distanceUpper2;
+            return true;
+        case DataField::LOWER_SENSOR_1:
+            value = data.distanceLower1;
+            return true;
+        case DataField::LOWER_SENSOR_2:
+            value = data.distanceLower2;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void StreamingSpectrogram::computeFrame(SpectrogramFrame& frame) {
+    // 环形缓冲区中writePos处为最旧样本
+    double mean = std::accumulate(ring.begin(), ring.end(), 0.0) / frameLength;
+    for (size_t i = 0; i < frameLength; ++i) {
+        size_t idx = writePos + i;
+        if (idx >= frameLength) idx -= frameLength;
+        segment[i] = (ring[idx] - mean) * window[i];
+    }
+
+    plan->forwardReal(segment.data(), spectrum.data());
+
+    size_t bins = spectrum.size();
+    frame.index = frameCount;
+    frame.time = (static_cast<double>(totalSamples) - frameLength / 2.0) / samplingRate;
+    frame.density.resize(bins);
+
+    size_t peak = bins > 1 ? 1 : 0;
+    for (size_t k = 0; k < bins; ++k) {
+        frame.density[k] = std::norm(spectrum[k]) * scale[k];
+        if (k > 0 && frame.density[k] > frame.density[peak]) {
+            peak = k;
+        }
+    }
+    frame.peakFrequency = peak * samplingRate / frameLength;
+
+    if (averaged.empty()) {
+        averaged = frame.density;
+    } else {
+        for (size_t k = 0; k < bins; ++k) {
+            averaged[k] += averagingFactor * (frame.density[k] - averaged[k]);
+        }
+    }
+
+    ++frameCount;
+}
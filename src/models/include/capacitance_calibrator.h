@@ -0,0 +1,112 @@
+#ifndef CAPACITANCE_CALIBRATOR_H
+#define CAPACITANCE_CALIBRATOR_H
+
+#include <cstddef>
+#include <vector>
+#include "measurement_data.h"
+#include "system_config.h"
+
+class FringingCapacitanceModel;
+
+/**
+ * @brief 电容模型参数
+ *
+ * C = ε0·ε_r·A·cos(θ) / (d + d0) · f(d + d0, θ) + C_p，A单位mm²，d与d0单位mm，C与C_p单位pF。
+ * f为PhysicsCalculator当前的边缘场修正系数（按面积A相似换算，未设置模型时为1）。
+ */
+struct CapacitorParameters {
+    double plateArea = 2500.0;          // mm²
+    double dielectricConstant = 1.0;
+    double parasiticCapacitance = 0.0;  // pF
+    double distanceOffset = 0.0;        // mm
+
+    static CapacitorParameters fromConfig(const SystemConfig& config);
+};
+
+/**
+ * @brief 校准选项
+ *
+ * 面积与介电常数在模型中只以乘积出现，不能同时拟合；同时选择时保持介电常数不变。
+ */
+struct CalibrationOptions {
+    bool fitPlateArea = true;
+    bool fitDielectricConstant = false;
+    bool fitParasiticCapacitance = true;
+    bool fitDistanceOffset = true;
+    int maxIterations = 50;
+    double tolerance = 1e-10;           // 相对参数步长或相对代价下降低于该值视为收敛
+    double initialDamping = 1e-3;
+};
+
+/**
+ * @brief 校准结果
+ */
+struct CalibrationResult {
+    CapacitorParameters parameters;
+    bool converged = false;
+    int iterations = 0;
+    size_t pointCount = 0;
+    double initialRmse = 0.0;           // pF
+    double rmse = 0.0;                  // pF
+};
+
+/**
+ * @brief 平行板电容模型的Levenberg–Marquardt校准器
+ *
+ * 扫描数据按列存放（距离、k·cos(θ)、实测电容），每次迭代单次遍历所有点，
+ * 用解析雅可比直接累加 JᵀJ 与 Jᵀr（4×4），不保存雅可比矩阵；
+ * 大数据量按块在共享线程池上并行累加，按块序合并，结果与线程数无关。
+ * 迭代前先在固定距离偏差下对 (ε_r·A, C_p) 做线性最小二乘，作为初值。
+ */
+class CapacitanceCalibrator {
+public:
+    explicit CapacitanceCalibrator(const CalibrationOptions& options = CalibrationOptions());
+
+    void setOptions(const CalibrationOptions& options) { this->options = options; }
+    const CalibrationOptions& getOptions() const { return options; }
+
+    /**
+     * @brief 设置扫描数据：设定高度作为板间距离，实测电容为目标值
+     */
+    void setSweep(const std::vector<MeasurementData>& sweep);
+    bool setSweep(const std::vector<double>& distances, const std::vector<double>& angles,
+                  const std::vector<double>& capacitances);
+    size_t size() const { return distances.size(); }
+
+    /**
+     * @brief 从initial出发拟合；未拟合的参数保持initial中的值
+     */
+    CalibrationResult calibrate(const CapacitorParameters& initial) const;
+    CalibrationResult calibrate(SystemConfig& config, bool writeBack = true) const;
+
+    /**
+     * @brief 用给定参数计算模型电容(pF)
+     */
+    static double model(const CapacitorParameters& parameters, double distance, double angle);
+    
+    /**
+     * @brief 批量计算模型电容(pF)，逐点结果与model()一致；angles可为nullptr（0°）
+     */
+    static void predict(const CapacitorParameters& parameters, const double* distances,
+                        const double* angles, size_t count, double* out);
+
+private:
+    struct NormalEquations {
+        double jtj[4][4] = {};
+        double jtr[4] = {};
+        double cost = 0.0;   // Σr²
+        bool valid = true;   // 所有点的 d + d0 > 0
+    };
+
+    NormalEquations evaluate(const double p[4], bool withJacobian, const FringingCapacitanceModel* fringing) const;
+    void initialEstimate(double p[4], const bool free[4], const FringingCapacitanceModel* fringing) const;
+
+    CalibrationOptions options;
+    std::vector<double> distances;      // mm
+    std::vector<double> angles;         // °
+    std::vector<double> scaledCosines;  // k·cos(θ)，k = ε0·10⁹ pF/mm
+    std::vector<double> capacitances;   // pF
+    double minDistance = 0.0;
+};
+
+#endif // CAPACITANCE_CALIBRATOR_H
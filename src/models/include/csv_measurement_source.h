@@ -0,0 +1,38 @@
+#ifndef CSV_MEASUREMENT_SOURCE_H
+#define CSV_MEASUREMENT_SOURCE_H
+
+#include <atomic>
+#include <string>
+#include "measurement_source.h"
+
+/**
+ * @brief 以测量CSV文件（MeasurementData::toCSV格式，首行为表头）为数据源
+ *
+ * 每次遍历重新顺序读取文件，一次只解析一块记录，内存占用与文件大小无关。
+ * 理论电容按当前系统配置重新计算；无法解析的行被跳过。
+ */
+class CsvMeasurementSource : public MeasurementSource {
+public:
+    explicit CsvMeasurementSource(const std::string& filename, size_t chunkSize = 4096);
+
+    bool isOpen() const { return readable; }
+
+    // 数据行数（含无法解析的行），首次调用时扫描一遍文件并缓存
+    size_t size() const override;
+    // 文件无法打开或读取出错时返回false
+    bool forEachChunk(const ChunkVisitor& visitor) const override;
+
+    // 最近一次遍历中跳过的行数
+    size_t getSkippedRows() const { return skippedRows.load(); }
+
+private:
+    std::string filename;
+    size_t chunkSize;
+    bool readable = false;
+
+    mutable std::atomic<size_t> cachedSize{0};
+    mutable std::atomic<bool> sizeKnown{false};
+    mutable std::atomic<size_t> skippedRows{0};
+};
+
+#endif // CSV_MEASUREMENT_SOURCE_H
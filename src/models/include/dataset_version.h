@@ -0,0 +1,46 @@
+#ifndef DATASET_VERSION_H
+#define DATASET_VERSION_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 数据集版本
+ *
+ * 同一数据集在同一epoch内只会在末尾追加记录、从首部淘汰记录，记录按追加顺序有绝对序号：
+ * 当前记录为 [evicted, evicted + size)，因此 (datasetId, epoch, evicted, size) 唯一确定内容；
+ * 清空、压缩、导入等其他修改会使epoch递增。
+ * 分析结果可以按版本缓存，追加和淘汰后只需处理变化的记录。
+ */
+struct DatasetVersion {
+    uint64_t datasetId = 0;   // 0表示未知数据集
+    uint64_t epoch = 0;
+    size_t evicted = 0;       // 本epoch内已从首部淘汰的记录数
+    size_t size = 0;          // 当前保留的记录数
+
+    // 本epoch内追加过的记录总数（下一条记录的绝对序号）
+    size_t appended() const { return evicted + size; }
+
+    /**
+     * @brief 本版本的记录是否为later的前缀（later只在本版本之后追加过记录）
+     */
+    bool isPrefixOf(const DatasetVersion& later) const {
+        return precedes(later) && evicted == later.evicted && size <= later.size;
+    }
+
+    /**
+     * @brief later是否可由本版本经末尾追加和首部淘汰得到
+     */
+    bool precedes(const DatasetVersion& later) const {
+        return datasetId != 0 && datasetId == later.datasetId && epoch == later.epoch &&
+               evicted <= later.evicted && appended() <= later.appended();
+    }
+
+    bool operator==(const DatasetVersion& other) const {
+        return datasetId == other.datasetId && epoch == other.epoch &&
+               evicted == other.evicted && size == other.size;
+    }
+    bool operator!=(const DatasetVersion& other) const { return !(*this == other); }
+};
+
+#endif // DATASET_VERSION_H
@@ -0,0 +1,142 @@
+#ifndef FRINGING_CAPACITANCE_H
+#define FRINGING_CAPACITANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "system_config.h"
+
+/**
+ * @brief 边缘场模型的表格与求解选项
+ */
+struct FringingModelOptions {
+    size_t gapCount = 16;        // 间距轴节点数（对数等距）
+    size_t angleCount = 10;      // 角度轴节点数（|θ|，等距）
+    double maxAngle = 80.0;      // 表格角度上限(°)，超出时取边界值
+    size_t maxCells = 1024;      // 截面网格最长边的最大单元数
+    double tolerance = 1e-7;     // 多重网格的相对残差
+};
+
+/**
+ * @brief 考虑边缘场与倾斜的正方形平行板电容修正
+ *
+ * 修正系数 f = C / C_pp，C_pp 为 PhysicsCalculator 的平行板公式 ε·A·cos(θ)/d。
+ *
+ * 二维截面：下板水平，上板绕中心倾斜θ，中心间距为d；在截面上用多重网格求解拉普拉斯方程，
+ * 由电极电荷得到单位长度电容 C'，f2 = C' / (W·cos(θ)/d)。
+ * 三维近似：倾斜轴方向的两条侧边按θ=0时的二维边缘电容计入，
+ * f3 = f2(d, θ) + (f2(d, 0) − 1) / cos(θ)，忽略四角的附加电容（小间距时可忽略）。
+ *
+ * 最小间距小于网格能分辨的尺度时改用解析近似（窄条平行板积分加Palmer边缘项），
+ * 并按网格刚好能分辨的参考截面上的数值解缩放，使两种算法在分界处连续。
+ *
+ * 表格在对数间距 × |θ| 上预先计算（各节点在共享线程池上并行求解），查询为双线性插值，O(1)。
+ * 两板接触的节点在几何上不可达，取同一间距下最后一个可解角度的值，表格中不含NaN。
+ */
+class FringingCapacitanceModel {
+public:
+    /**
+     * @brief 二维截面的单位长度电容 C'/ε（宽度与间距单位相同）；两板接触时返回NaN
+     */
+    static double crossSectionCapacitance(double width, double gap, double angleDeg,
+                                          size_t maxCells = 1024, double tolerance = 1e-7);
+
+    /**
+     * @brief 为边长sqrt(plateArea)的正方形极板构建表格，间距范围 [minGap, maxGap]，角度 [0, maxAngle]
+     */
+    static std::shared_ptr<const FringingCapacitanceModel> build(
+        double plateArea, double minGap, double maxGap, double maxAngle,
+        const FringingModelOptions& options = FringingModelOptions());
+
+    /**
+     * @brief 按 SystemConfig 的极板面积、高度和角度限位构建表格
+     */
+    static std::shared_ptr<const FringingCapacitanceModel> build(
+        const SystemConfig& config, const FringingModelOptions& options = FringingModelOptions());
+
+    /**
+     * @brief 在cacheDir中查找与当前几何一致的缓存表格，不存在或校验失败时构建并写入缓存
+     */
+    static std::shared_ptr<const FringingCapacitanceModel> loadOrBuild(
+        const SystemConfig& config, const std::string& cacheDir,
+        const FringingModelOptions& options = FringingModelOptions());
+
+    /**
+     * @brief 确保PhysicsCalculator当前的表格与config的几何一致，不一致时用loadOrBuild重新加载或构建并安装
+     *
+     * 极板面积、高度或角度限位变化（如校准写回面积）后调用。构建期间几何再次变化时不安装过期的表格。
+     * @return 调用结束时已安装与当前几何一致的表格
+     */
+    static bool ensureInstalled(const SystemConfig& config, const std::string& cacheDir,
+                                const FringingModelOptions& options = FringingModelOptions());
+
+    static std::shared_ptr<const FringingCapacitanceModel> load(const std::string& filePath);
+    bool save(const std::string& filePath) const;
+
+    /**
+     * @brief 由几何与选项决定的缓存文件名（不含目录）
+     */
+    std::string cacheFileName() const;
+
+    /**
+     * @brief 表格是否按config当前的几何与options构建
+     */
+    bool matches(const SystemConfig& config, const FringingModelOptions& options = FringingModelOptions()) const;
+
+    /**
+     * @brief 修正系数（|θ|查表，间距与角度超出表格范围时取边界值）
+     */
+    double factor(double gap, double angleDeg) const;
+
+    /**
+     * @brief 极板面积为plateArea时的修正系数
+     *
+     * 修正系数只依赖 d/√A 与θ，按相似性把间距换算到表格的极板尺寸后查表；
+     * plateArea等于表格面积时与factor()一致。gapSlope非空时返回 ∂f/∂d（间距超出表格范围时为0）。
+     */
+    double scaledFactor(double plateArea, double gap, double angleDeg, double* gapSlope = nullptr) const;
+
+    double getPlateArea() const { return key.plateArea; }
+    double getMinGap() const { return key.minGap; }
+    double getMaxGap() const { return key.maxGap; }
+    double getMaxAngle() const { return key.maxAngle; }
+    size_t getGapCount() const { return gapCount; }
+    size_t getAngleCount() const { return angleCount; }
+    bool isLoadedFromCache() const { return loadedFromCache; }
+
+private:
+    // 在网格上求解截面电容（θ为弧度）；最小间距在网格上无法分辨时返回NaN
+    static double solveSection(double width, double gap, double theta, size_t maxCells, double tolerance);
+
+    // 决定表格内容的全部参数，写入缓存文件头
+    struct Key {
+        double plateArea = 0.0;
+        double minGap = 0.0;
+        double maxGap = 0.0;
+        double maxAngle = 0.0;
+        double tolerance = 0.0;
+        uint64_t gapCount = 0;
+        uint64_t angleCount = 0;
+        uint64_t maxCells = 0;
+    };
+
+    FringingCapacitanceModel() = default;
+    static Key makeKey(double plateArea, double minGap, double maxGap, double maxAngle,
+                       const FringingModelOptions& options);
+    static Key makeKey(const SystemConfig& config, const FringingModelOptions& options);
+    static std::string cacheFileName(const Key& key);
+    void computeTable();
+    double gapAt(size_t index) const;
+    double angleAt(size_t index) const;
+    double interpolate(double gap, double angleDeg, double* gapSlope) const;
+
+    Key key;
+    size_t gapCount = 0;
+    size_t angleCount = 0;
+    std::vector<double> table;   // table[gap * angleCount + angle]
+    bool loadedFromCache = false;
+};
+
+#endif // FRINGING_CAPACITANCE_H
@@ -4,6 +4,7 @@
 #include "sensor_data.h"
 #include "physics_calculator.h"
 #include <string>
+#include <vector>
 #include <cstdint>
 #include <sstream>
 #include <iomanip>
@@ -20,6 +21,13 @@ public:
     
     MeasurementData& operator=(const MeasurementData& other);
     
+    // 批量构造：理论电容通过批量接口一次算出，结果与逐条构造一致
+    static std::vector<MeasurementData> createBatch(const std::vector<double>& heights,
+                                                    const std::vector<double>& angles,
+                                                    const std::vector<SensorData>& sensorData,
+                                                    double plateArea = 2500.0,
+                                                    double dielectricConstant = 1.0);
+    
     // Getter方法
     int64_t getTimestamp() const { return timestamp; }
     double getSetHeight() const { return m_setHeight; }
@@ -34,6 +42,8 @@ public:
     void setTimestamp(int64_t ts) { timestamp = ts; }
     bool setHeight(double height);
     bool setAngle(double angle);
+    // 直接写入高度和角度：不检查安全范围，也不重算理论电容（用于归一化等非物理值）
+    void setRawPosition(double height, double angle);
     void updateSensorData(const SensorData& data);
     
     // 电容板参数设置
@@ -78,6 +88,10 @@ private:
     double maxAngle = 90.0;
     
     bool isInSafetyRange(double height, double angle) const;
+
+    // 批量构造使用：理论电容由调用者给出，不再逐条计算
+    MeasurementData(int64_t timestamp, double height, double angle, const SensorData& sensorData,
+                    double plateArea, double dielectricConstant, double theoreticalCapacitance);
 };
 
 #endif // MEASUREMENT_DATA_H
\ No newline at end of file
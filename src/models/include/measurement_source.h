@@ -0,0 +1,52 @@
+#ifndef MEASUREMENT_SOURCE_H
+#define MEASUREMENT_SOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "measurement_data.h"
+
+/**
+ * @brief 测量记录的分块数据源
+ *
+ * 按顺序以连续块的形式提供记录，调用方不需要一次性复制全部数据。
+ * 块的大小由数据源决定；visitor返回false时提前结束遍历。
+ * forEachChunk返回false表示数据源自身未能提供全部记录（遍历期间数据被修改、读取失败等），
+ * 调用方应把已处理的结果视为不完整；全部提供或由visitor提前结束时返回true。
+ */
+class MeasurementSource {
+public:
+    using ChunkVisitor = std::function<bool(const MeasurementData* rows, size_t count)>;
+
+    virtual ~MeasurementSource() = default;
+
+    virtual size_t size() const = 0;
+    virtual bool forEachChunk(const ChunkVisitor& visitor) const = 0;
+};
+
+/**
+ * @brief 以已有vector为数据源（不复制，vector须在使用期间保持有效）
+ */
+class VectorMeasurementSource : public MeasurementSource {
+public:
+    explicit VectorMeasurementSource(const std::vector<MeasurementData>& data, size_t chunkSize = 65536)
+        : data(data), chunkSize(std::max<size_t>(chunkSize, 1)) {}
+
+    size_t size() const override { return data.size(); }
+
+    bool forEachChunk(const ChunkVisitor& visitor) const override {
+        for (size_t begin = 0; begin < data.size(); begin += chunkSize) {
+            if (!visitor(data.data() + begin, std::min(chunkSize, data.size() - begin))) {
+                break;
+            }
+        }
+        return true;
+    }
+
+private:
+    const std::vector<MeasurementData>& data;
+    size_t chunkSize;
+};
+
+#endif // MEASUREMENT_SOURCE_H
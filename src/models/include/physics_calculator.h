@@ -1,6 +1,11 @@
 #ifndef PHYSICS_CALCULATOR_H
 #define PHYSICS_CALCULATOR_H
 
+#include <cstddef>
+#include <memory>
+
+class FringingCapacitanceModel;
+
 class PhysicsCalculator {
 public:
     // 计算平行板电容（返回pF）
@@ -15,6 +20,51 @@ public:
         double distance1,
         double distance2,
         double sensorSpacing);
+    
+    // 批量计算：out[i] 与对应标量函数的结果逐位一致。
+    // 三角函数之外的运算在无分支的独立循环中完成，便于编译器向量化；
+    // 相邻样本角度相同时复用上一次的余弦值（扫描数据中角度通常成段重复）。
+    // angles_degrees 为nullptr时按0°计算；out可以与输入数组重叠为同一数组
+    static void calculateParallelPlateCapacitance(
+        const double* distances_mm,
+        const double* angles_degrees,
+        size_t count,
+        double* out,
+        double plateArea_mm2,
+        double dielectricConstant = 1.0);
+    
+    // 理论电容：C = 平行板公式(d + d0) × 边缘场修正系数(d + d0, θ) + C_p。
+    // d0、C_p为校准得到的距离偏差和寄生电容（见setCapacitanceOffsets），默认为0；
+    // 未设置模型或模型的极板面积与plateArea_mm2不一致时修正系数为1
+    static double calculateTheoreticalCapacitance(
+        double plateArea_mm2,
+        double distance_mm,
+        double angle_degrees = 0.0,
+        double dielectricConstant = 1.0);
+    
+    static void calculateTheoreticalCapacitance(
+        const double* distances_mm,
+        const double* angles_degrees,
+        size_t count,
+        double* out,
+        double plateArea_mm2,
+        double dielectricConstant = 1.0);
+    
+    // 设置进程内使用的边缘场模型（nullptr表示只用平行板公式），可在其他线程计算时替换
+    static void setFringingModel(std::shared_ptr<const FringingCapacitanceModel> model);
+    static std::shared_ptr<const FringingCapacitanceModel> getFringingModel();
+    
+    // 设置理论电容使用的寄生电容(pF)和距离偏差(mm)，由SystemConfig在校准参数变化时同步
+    static void setCapacitanceOffsets(double parasitic_pF, double distanceOffset_mm);
+    static double getParasiticCapacitance();
+    static double getDistanceOffset();
+    
+    static void calculateAngleFromSensors(
+        const double* distances1,
+        const double* distances2,
+        size_t count,
+        double sensorSpacing,
+        double* out);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -6,6 +6,20 @@
 #include <chrono>
 #include <cstdint>
 
+/**
+ * @brief 传感器通道，用于按通道维护统计量（如分位数草图）
+ */
+enum class SensorChannel {
+    DISTANCE_UPPER_1,
+    DISTANCE_UPPER_2,
+    DISTANCE_LOWER_1,
+    DISTANCE_LOWER_2,
+    TEMPERATURE,
+    ANGLE,
+    CAPACITANCE,
+    COUNT
+};
+
 class SensorData {
 public:
 SensorData();
@@ -48,6 +62,11 @@ SensorData();
     bool isAllValid() const;
     bool hasValidData() const;
     
+    // 按通道访问
+    double getChannelValue(SensorChannel channel) const;
+    bool isChannelValid(SensorChannel channel) const;
+    void setChannelValue(SensorChannel channel, double value);   // 不改变有效标志
+    
     bool parseFromString(const std::string& dataString);
     std::string toString() const;
     std::string toCSV() const;
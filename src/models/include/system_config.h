@@ -44,6 +44,14 @@ public:
     double getPlateArea() const { return plateArea; }
     double getDielectricConstant() const { return dielectricConstant; }
     
+    // 校准偏置：寄生电容(pF)叠加在理论值上，距离偏差(mm)叠加在设定高度上
+    void setCapacitanceOffsets(double parasitic, double offset);
+    double getParasiticCapacitance() const { return parasiticCapacitance; }
+    double getDistanceOffset() const { return distanceOffset; }
+    
+    // 一次写入全部电容模型参数（只通知一次），参数无效时不做任何修改
+    bool setCapacitorCalibration(double area, double epsilon, double parasitic, double offset);
+    
     // ===== 系统尺寸 =====
     void setSystemDimensions(double totalHeight, double middlePlateHeight, double sensorSpacing);
     double getTotalHeight() const { return totalHeight; }
@@ -114,6 +122,8 @@ private:
     // 电容板参数
     double plateArea = 2500.0;   // mmm² (50mm x 50mm)
     double dielectricConstant = 1.0;
+    double parasiticCapacitance = 0.0;   // pF
+    double distanceOffset = 0.0;         // mm
     
     // 系统尺寸
     double totalHeight = 150.0;      // mm
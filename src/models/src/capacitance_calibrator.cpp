@@ -0,0 +1,402 @@
+#include "../include/capacitance_calibrator.h"
+#include "../include/physics_calculator.h"
+#include "../include/fringing_capacitance.h"
+#include "../include/physics_constants.h"
+#include "../../utils/include/logger.h"
+#include "../../utils/include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+enum Parameter { AREA = 0, EPSILON = 1, PARASITIC = 2, OFFSET = 3 };
+
+constexpr size_t kChunkSize = 65536;
+
+/**
+ * @brief 对称正定小矩阵的Cholesky求解，a按行存放n×n，失败（非正定）时返回false
+ */
+bool choleskySolve(std::vector<double> a, std::vector<double> b, size_t n, std::vector<double>& x) {
+    for (size_t j = 0; j < n; ++j) {
+        double diagonal = a[j * n + j];
+        for (size_t k = 0; k < j; ++k) {
+            diagonal -= a[j * n + k] * a[j * n + k];
+        }
+        if (!(diagonal > 0.0)) {
+            return false;
+        }
+        a[j * n + j] = std::sqrt(diagonal);
+        for (size_t i = j + 1; i < n; ++i) {
+            double sum = a[i * n + j];
+            for (size_t k = 0; k < j; ++k) {
+                sum -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = sum / a[j * n + j];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = 0; k < i; ++k) {
+            b[i] -= a[i * n + k] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    for (size_t i = n; i-- > 0;) {
+        for (size_t k = i + 1; k < n; ++k) {
+            b[i] -= a[k * n + i] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    x = b;
+    return true;
+}
+
+} // namespace
+
+CapacitorParameters CapacitorParameters::fromConfig(const SystemConfig& config) {
+    CapacitorParameters parameters;
+    parameters.plateArea = config.getPlateArea();
+    parameters.dielectricConstant = config.getDielectricConstant();
+    parameters.parasiticCapacitance = config.getParasiticCapacitance();
+    parameters.distanceOffset = config.getDistanceOffset();
+    return parameters;
+}
+
+CapacitanceCalibrator::CapacitanceCalibrator(const CalibrationOptions& options)
+    : options(options) {
+}
+
+void CapacitanceCalibrator::setSweep(const std::vector<MeasurementData>& sweep) {
+    std::vector<double> distanceValues;
+    std::vector<double> angles;
+    std::vector<double> capacitanceValues;
+    distanceValues.reserve(sweep.size());
+    angles.reserve(sweep.size());
+    capacitanceValues.reserve(sweep.size());
+
+    for (const auto& m : sweep) {
+        double capacitance = m.getSensorData().capacitance;
+        if (!std::isfinite(capacitance) || m.getSetHeight() <= 0.0) {
+            continue;
+        }
+        distanceValues.push_back(m.getSetHeight());
+        angles.push_back(m.getSetAngle());
+        capacitanceValues.push_back(capacitance);
+    }
+    setSweep(distanceValues, angles, capacitanceValues);
+}
+
+bool CapacitanceCalibrator::setSweep(const std::vector<double>& distanceValues,
+                                     const std::vector<double>& angles,
+                                     const std::vector<double>& capacitanceValues) {
+    if (distanceValues.size() != angles.size() || distanceValues.size() != capacitanceValues.size()) {
+        LOG_ERROR("Calibration sweep columns have different lengths");
+        return false;
+    }
+
+    distances = distanceValues;
+    this->angles = angles;
+    capacitances = capacitanceValues;
+
+    // 单位面积、单位距离下的电容即 k·cos(θ)
+    std::vector<double> unitDistances(angles.size(), 1.0);
+    scaledCosines.resize(angles.size());
+    PhysicsCalculator::calculateParallelPlateCapacitance(unitDistances.data(), angles.data(), angles.size(),
+                                                         scaledCosines.data(), 1.0, 1.0);
+    minDistance = distances.empty() ? 0.0 : *std::min_element(distances.begin(), distances.end());
+    return true;
+}
+
+double CapacitanceCalibrator::model(const CapacitorParameters& parameters, double distance, double angle) {
+    const double gap = distance + parameters.distanceOffset;
+    double capacitance = PhysicsCalculator::calculateParallelPlateCapacitance(
+        parameters.plateArea, gap, angle, parameters.dielectricConstant);
+    auto fringing = PhysicsCalculator::getFringingModel();
+    if (fringing) {
+        capacitance *= fringing->scaledFactor(parameters.plateArea, gap, angle);
+    }
+    return capacitance + parameters.parasiticCapacitance;
+}
+
+void CapacitanceCalibrator::predict(const CapacitorParameters& parameters, const double* distanceValues,
+                                    const double* angles, size_t count, double* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = distanceValues[i] + parameters.distanceOffset;
+    }
+    auto fringing = PhysicsCalculator::getFringingModel();
+    std::vector<double> factors;
+    if (fringing) {
+        factors.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            factors[i] = fringing->scaledFactor(parameters.plateArea, out[i], angles ? angles[i] : 0.0);
+        }
+    }
+    PhysicsCalculator::calculateParallelPlateCapacitance(out, angles, count, out, parameters.plateArea,
+                                                         parameters.dielectricConstant);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = (fringing ? out[i] * factors[i] : out[i]) + parameters.parasiticCapacitance;
+    }
+}
+
+CapacitanceCalibrator::NormalEquations CapacitanceCalibrator::evaluate(
+    const double p[4], bool withJacobian, const FringingCapacitanceModel* fringing) const {
+    NormalEquations total;
+    if (minDistance + p[OFFSET] <= 0.0) {
+        total.valid = false;
+        return total;
+    }
+
+    const size_t count = distances.size();
+    const size_t chunkCount = (count + kChunkSize - 1) / kChunkSize;
+    std::vector<NormalEquations> partial(chunkCount);
+
+    const double area = p[AREA];
+    const double epsilon = p[EPSILON];
+    const double product = area * epsilon;
+
+    auto accumulate = [&](size_t chunk) {
+        const size_t begin = chunk * kChunkSize;
+        const size_t end = std::min(count, begin + kChunkSize);
+        const double* d = distances.data();
+        const double* kc = scaledCosines.data();
+        const double* c = capacitances.data();
+        const double* angle = angles.data();
+
+        // 只有 ∂/∂A、∂/∂ε_r、∂/∂d0 随点变化（∂/∂C_p ≡ 1），展开为标量累加器便于编译器向量化。
+        // 有边缘场模型时 C = base·ε_r·A·f + C_p，f只依赖 (d+d0)/√A 与θ：
+        // ∂f/∂A = −f'·(d+d0)/(2A)，∂f/∂d0 = f'
+        double sAA = 0, sAE = 0, sAP = 0, sAO = 0, sEE = 0, sEP = 0, sEO = 0, sPP = 0, sPO = 0, sOO = 0;
+        double rA = 0, rE = 0, rP = 0, rO = 0, cost = 0;
+        for (size_t i = begin; i < end; ++i) {
+            double gap = d[i] + p[OFFSET];
+            double inverse = 1.0 / gap;
+            double slope = 0.0;
+            double f = fringing ? fringing->scaledFactor(area, gap, angle[i], &slope) : 1.0;
+            double base = kc[i] * inverse;
+            double r = base * product * f + p[PARASITIC] - c[i];
+            cost += r * r;
+            if (withJacobian) {
+                double jA = base * epsilon * (f - 0.5 * slope * gap);
+                double jE = base * area * f;
+                double jO = base * product * (slope - f * inverse);
+                sAA += jA * jA; sAE += jA * jE; sAP += jA; sAO += jA * jO;
+                sEE += jE * jE; sEP += jE;     sEO += jE * jO;
+                sPP += 1.0;     sPO += jO;
+                sOO += jO * jO;
+                rA += jA * r; rE += jE * r; rP += r; rO += jO * r;
+            }
+        }
+
+        NormalEquations& out = partial[chunk];
+        out.cost = cost;
+        double values[4][4] = {{sAA, sAE, sAP, sAO}, {sAE, sEE, sEP, sEO},
+                               {sAP, sEP, sPP, sPO}, {sAO, sEO, sPO, sOO}};
+        std::copy(&values[0][0], &values[0][0] + 16, &out.jtj[0][0]);
+        out.jtr[AREA] = rA;
+        out.jtr[EPSILON] = rE;
+        out.jtr[PARASITIC] = rP;
+        out.jtr[OFFSET] = rO;
+    };
+
+    if (chunkCount > 1) {
+        ThreadPool::shared().parallelFor(chunkCount, accumulate);
+    } else if (chunkCount == 1) {
+        accumulate(0);
+    }
+
+    for (const auto& part : partial) {
+        total.cost += part.cost;
+        for (int i = 0; i < 4; ++i) {
+            total.jtr[i] += part.jtr[i];
+            for (int j = 0; j < 4; ++j) {
+                total.jtj[i][j] += part.jtj[i][j];
+            }
+        }
+    }
+    return total;
+}
+
+void CapacitanceCalibrator::initialEstimate(double p[4], const bool free[4],
+                                            const FringingCapacitanceModel* fringing) const {
+    // 固定d0时模型对 s = ε_r·A 与 C_p 是线性的：C = s·x + C_p，x = k·cos(θ)·f/(d + d0)
+    // （f按初始面积取值，只用于初值）
+    if (!free[AREA] && !free[EPSILON] && !free[PARASITIC]) {
+        return;
+    }
+    if (minDistance + p[OFFSET] <= 0.0) {
+        return;
+    }
+
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < distances.size(); ++i) {
+        double gap = distances[i] + p[OFFSET];
+        double x = scaledCosines[i] / gap;
+        if (fringing) {
+            x *= fringing->scaledFactor(p[AREA], gap, angles[i]);
+        }
+        n += 1.0;
+        sx += x;
+        sy += capacitances[i];
+        sxx += x * x;
+        sxy += x * capacitances[i];
+    }
+
+    double product = p[AREA] * p[EPSILON];
+    double parasitic = p[PARASITIC];
+    bool scaleFree = free[AREA] || free[EPSILON];
+    if (scaleFree && free[PARASITIC]) {
+        double denominator = n * sxx - sx * sx;
+        if (std::abs(denominator) <= 1e-12 * n * sxx) {
+            return;
+        }
+        product = (n * sxy - sx * sy) / denominator;
+        parasitic = (sy - product * sx) / n;
+    } else if (scaleFree) {
+        if (sxx <= 0.0) return;
+        product = (sxy - parasitic * sx) / sxx;
+    } else {
+        parasitic = (sy - product * sx) / n;
+    }
+
+    if (scaleFree && product <= 0.0) {
+        return;   // 线性估计不合理时保持初值
+    }
+    if (free[AREA]) {
+        p[AREA] = product / p[EPSILON];
+    } else if (free[EPSILON]) {
+        p[EPSILON] = product / p[AREA];
+    }
+    if (free[PARASITIC]) {
+        p[PARASITIC] = parasitic;
+    }
+}
+
+CalibrationResult CapacitanceCalibrator::calibrate(const CapacitorParameters& initial) const {
+    CalibrationResult result;
+    result.parameters = initial;
+    result.pointCount = distances.size();
+
+    bool free[4] = {options.fitPlateArea, options.fitDielectricConstant,
+                    options.fitParasiticCapacitance, options.fitDistanceOffset};
+    if (free[AREA] && free[EPSILON]) {
+        LOG_WARNING("Plate area and dielectric constant are not separately identifiable; "
+                    "keeping dielectric constant fixed");
+        free[EPSILON] = false;
+    }
+    std::vector<int> active;
+    for (int i = 0; i < 4; ++i) {
+        if (free[i]) active.push_back(i);
+    }
+    const size_t m = active.size();
+
+    if (distances.size() < std::max<size_t>(m, 1) + 1) {
+        LOG_WARNING("Insufficient data for capacitance calibration");
+        return result;
+    }
+
+    double p[4] = {initial.plateArea, initial.dielectricConstant,
+                   initial.parasiticCapacitance, initial.distanceOffset};
+    if (p[AREA] <= 0.0 || p[EPSILON] <= 0.0) {
+        LOG_ERROR("Invalid initial capacitor parameters");
+        return result;
+    }
+
+    // 拟合与理论电容使用同一个边缘场模型，校准参数不会再吸收一次边缘场
+    const auto fringing = PhysicsCalculator::getFringingModel();
+    const double n = static_cast<double>(distances.size());
+    NormalEquations current = evaluate(p, true, fringing.get());
+    if (!current.valid) {
+        LOG_ERROR("Distance offset makes plate distance non-positive");
+        return result;
+    }
+    result.initialRmse = std::sqrt(current.cost / n);
+
+    initialEstimate(p, free, fringing.get());
+    current = evaluate(p, true, fringing.get());
+
+    double lambda = options.initialDamping;
+    std::vector<double> a(m * m), g(m), step;
+    for (int iteration = 1; iteration <= options.maxIterations && m > 0; ++iteration) {
+        result.iterations = iteration;
+
+        // Marquardt缩放：阻尼与JᵀJ对角元成比例，与参数单位无关
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < m; ++j) {
+                a[i * m + j] = current.jtj[active[i]][active[j]];
+            }
+            double diagonal = std::max(current.jtj[active[i]][active[i]], 1e-300);
+            a[i * m + i] += lambda * diagonal;
+            g[i] = -current.jtr[active[i]];
+        }
+
+        bool accepted = false;
+        if (choleskySolve(a, g, m, step)) {
+            double trial[4] = {p[0], p[1], p[2], p[3]};
+            for (size_t i = 0; i < m; ++i) {
+                trial[active[i]] += step[i];
+            }
+            if (trial[AREA] > 0.0 && trial[EPSILON] > 0.0) {
+                NormalEquations candidate = evaluate(trial, true, fringing.get());
+                if (candidate.valid && candidate.cost <= current.cost) {
+                    bool smallStep = true;
+                    for (size_t i = 0; i < m; ++i) {
+                        int k = active[i];
+                        if (std::abs(step[i]) > options.tolerance * (std::abs(p[k]) + options.tolerance)) {
+                            smallStep = false;
+                        }
+                    }
+                    bool smallGain = current.cost - candidate.cost <=
+                                     options.tolerance * std::max(current.cost, std::numeric_limits<double>::min());
+
+                    std::copy(trial, trial + 4, p);
+                    current = candidate;
+                    lambda = std::max(lambda * 0.1, 1e-15);
+                    accepted = true;
+
+                    if (smallStep || smallGain) {
+                        result.converged = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!accepted) {
+            lambda *= 10.0;
+            if (lambda > 1e15) {
+                // 任何方向都不能再降低代价：已在极小点
+                result.converged = true;
+                break;
+            }
+        }
+    }
+    if (m == 0) {
+        result.converged = true;
+    }
+
+    result.parameters.plateArea = p[AREA];
+    result.parameters.dielectricConstant = p[EPSILON];
+    result.parameters.parasiticCapacitance = p[PARASITIC];
+    result.parameters.distanceOffset = p[OFFSET];
+    result.rmse = std::sqrt(current.cost / n);
+
+    if (!result.converged) {
+        LOG_WARNING("Capacitance calibration did not converge");
+    }
+    return result;
+}
+
+CalibrationResult CapacitanceCalibrator::calibrate(SystemConfig& config, bool writeBack) const {
+    CalibrationResult result = calibrate(CapacitorParameters::fromConfig(config));
+    if (writeBack && result.converged) {
+        const auto& p = result.parameters;
+        if (!config.setCapacitorCalibration(p.plateArea, p.dielectricConstant,
+                                            p.parasiticCapacitance, p.distanceOffset)) {
+            LOG_ERROR("Calibrated capacitor parameters rejected by configuration");
+            result.converged = false;
+        } else {
+            LOG_INFO("Capacitor calibration written to configuration");
+        }
+    }
+    return result;
+}
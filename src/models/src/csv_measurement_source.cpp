@@ -0,0 +1,134 @@
+#include "../include/csv_measurement_source.h"
+#include "../include/system_config.h"
+#include "../../utils/include/time_utils.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace {
+constexpr size_t kCsvColumns = 11;   // 时间戳、设定高度/角度、理论电容、七个传感器通道
+}
+
+CsvMeasurementSource::CsvMeasurementSource(const std::string& filename, size_t chunkSize)
+    : filename(filename), chunkSize(std::max<size_t>(chunkSize, 1)) {
+    std::ifstream file(filename);
+    readable = file.is_open();
+}
+
+size_t CsvMeasurementSource::size() const {
+    if (sizeKnown.load()) {
+        return cachedSize.load();
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    size_t rows = 0;
+    bool header = true;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (header) {
+            header = false;
+            continue;
+        }
+        if (!line.empty() && line != "\r") {
+            ++rows;
+        }
+    }
+
+    cachedSize = rows;
+    sizeKnown = true;
+    return rows;
+}
+
+bool CsvMeasurementSource::forEachChunk(const ChunkVisitor& visitor) const {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    std::getline(file, line);
+
+    const SystemConfig& config = SystemConfig::getInstance();
+    const double plateArea = config.getPlateArea();
+    const double dielectricConstant = config.getDielectricConstant();
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> heights;
+    std::vector<double> angles;
+    std::vector<SensorData> sensors;
+    size_t skipped = 0;
+
+    // 先按列收集一块，理论电容批量计算
+    auto flush = [&]() {
+        auto batch = MeasurementData::createBatch(heights, angles, sensors, plateArea, dielectricConstant);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (timestamps[i] >= 0) {
+                batch[i].setTimestamp(timestamps[i]);
+            }
+        }
+        timestamps.clear();
+        heights.clear();
+        angles.clear();
+        sensors.clear();
+        return visitor(batch.data(), batch.size());
+    };
+
+    std::vector<std::string> cells;
+    double values[kCsvColumns];
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        cells.clear();
+        size_t begin = 0;
+        for (;;) {
+            size_t comma = line.find(',', begin);
+            cells.push_back(line.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin));
+            if (comma == std::string::npos) break;
+            begin = comma + 1;
+        }
+        if (cells.size() < kCsvColumns) {
+            ++skipped;
+            continue;
+        }
+
+        bool parsed = true;
+        for (size_t i = 1; i < kCsvColumns && parsed; ++i) {
+            char* end = nullptr;
+            values[i] = std::strtod(cells[i].c_str(), &end);
+            parsed = end != cells[i].c_str();
+        }
+        if (!parsed) {
+            ++skipped;
+            continue;
+        }
+
+        SensorData sensorData;
+        sensorData.setUpperSensors(values[4], values[5]);
+        sensorData.setLowerSensors(values[6], values[7]);
+        sensorData.setTemperature(values[8]);
+        sensorData.setAngle(values[9]);
+        sensorData.setCapacitance(values[10]);
+
+        timestamps.push_back(TimeUtils::parseTimestamp(cells[0]));
+        heights.push_back(values[1]);
+        angles.push_back(values[2]);
+        sensors.push_back(sensorData);
+
+        if (heights.size() == chunkSize && !flush()) {
+            skippedRows = skipped;
+            return true;
+        }
+    }
+    if (file.bad()) {
+        skippedRows = skipped;
+        return false;
+    }
+
+    if (!heights.empty()) {
+        flush();
+    }
+    skippedRows = skipped;
+    return true;
+}
@@ -0,0 +1,473 @@
+#include "../include/fringing_capacitance.h"
+#include "../include/physics_calculator.h"
+#include "../include/physics_constants.h"
+#include "../../utils/include/laplace_solver.h"
+#include "../../utils/include/logger.h"
+#include "../../utils/include/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'D', 'C', 'F', 'R', 'I', 'N', 'G'};
+constexpr uint32_t kFormatVersion = 2;
+constexpr int kMaxCycles = 200;
+
+enum Electrode { BOTTOM_PLATE = 1, TOP_PLATE = 2 };
+
+// FNV-1a
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 1469598103934665603ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// 轴上的插值位置：返回下标index与权重weight（count为1时始终为0）
+void locate(double position, size_t count, size_t& index, double& weight) {
+    if (count < 2) {
+        index = 0;
+        weight = 0.0;
+        return;
+    }
+    double maxPosition = static_cast<double>(count - 1);
+    position = std::max(0.0, std::min(position, maxPosition));
+    index = std::min(static_cast<size_t>(position), count - 2);
+    weight = position - static_cast<double>(index);
+}
+
+// 外边界为镜像条件，留出足够的边距使其对结果的影响可以忽略
+double sectionMargin(double width, double top) {
+    return std::max(width, 2.0 * top);
+}
+
+// 网格能取到的最小单元（最长边不超过maxCells个单元）
+double minimumSpacing(double width, double top, size_t maxCells) {
+    double margin = sectionMargin(width, top);
+    double extent = std::max(width + 2.0 * margin, top + 2.0 * margin);
+    return extent / static_cast<double>(maxCells);
+}
+
+// 解析近似：板间按局部间距的平行板窄条积分，两端各加Palmer边缘项 (1 + ln(2πW/d)) / 2π
+double analyticSection(double width, double gap, double theta) {
+    const double pi = 3.14159265358979323846;
+    const double half = 0.5 * width;
+    const double lowest = gap - half * std::sin(theta);
+    const double top = gap + half * std::sin(theta);
+    double body = theta > 1e-9 ? std::log(top / lowest) / std::tan(theta) : width / gap;
+    double edges = (2.0 + std::log(2.0 * pi * width / lowest) + std::log(2.0 * pi * width / top)) / (2.0 * pi);
+    return body + edges;
+}
+
+} // namespace
+
+double FringingCapacitanceModel::crossSectionCapacitance(double width, double gap, double angleDeg,
+                                                         size_t maxCells, double tolerance) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (!(width > 0.0) || !(gap > 0.0) || maxCells < 16) {
+        return nan;
+    }
+
+    const double theta = std::abs(angleDeg) * PhysicsConstants::DEG_TO_RAD;
+    const double half = 0.5 * width;
+    const double lowest = gap - half * std::sin(theta);
+    if (!(lowest > 0.0)) {
+        return nan;   // 两板接触
+    }
+
+    double capacitance = solveSection(width, gap, theta, maxCells, tolerance);
+    if (std::isfinite(capacitance)) {
+        return capacitance;
+    }
+
+    // 最小间距小于网格能分辨的尺度：改用解析近似，并按网格刚好能分辨的参考截面上
+    // 数值解与解析近似之比缩放，使两种算法在分界处连续
+    const double resolvable = 2.02 * minimumSpacing(width, gap + half * std::sin(theta), maxCells);
+    double referenceGap = gap;
+    double referenceTheta = 0.0;
+    if (gap > resolvable) {
+        referenceTheta = std::asin((gap - resolvable) / half);
+    } else {
+        referenceGap = resolvable;
+    }
+    double reference = solveSection(width, referenceGap, referenceTheta, maxCells, tolerance);
+    double scale = std::isfinite(reference) ? reference / analyticSection(width, referenceGap, referenceTheta) : 1.0;
+    return analyticSection(width, gap, theta) * scale;
+}
+
+double FringingCapacitanceModel::solveSection(double width, double gap, double theta,
+                                              size_t maxCells, double tolerance) {
+    const double half = 0.5 * width;
+    const double lowest = gap - half * std::sin(theta);
+    const double top = gap + half * std::sin(theta);
+
+    const double margin = sectionMargin(width, top);
+    const double extentX = width + 2.0 * margin;
+    const double extentY = top + 2.0 * margin;
+
+    double h = std::min({gap / 4.0, width / 16.0, lowest / 2.0});
+    h = std::max(h, minimumSpacing(width, top, maxCells));
+    if (lowest < 2.0 * h) {
+        return std::numeric_limits<double>::quiet_NaN();   // 最小间距在网格上无法分辨
+    }
+    h = gap / std::floor(gap / h);   // 中心间距恰为整数个单元
+
+    // 单元数取2^k的倍数，使粗网格层数足够
+    double cellsX = extentX / h;
+    double cellsY = extentY / h;
+    int k = static_cast<int>(std::floor(std::log2(std::min(cellsX, cellsY) / 4.0)));
+    size_t block = static_cast<size_t>(1) << std::max(k, 0);
+    size_t nx = static_cast<size_t>(std::ceil(cellsX / block)) * block;
+    size_t ny = static_cast<size_t>(std::ceil(cellsY / block)) * block;
+
+    LaplaceSolver2D solver(nx, ny);
+    const double x0 = -0.5 * static_cast<double>(nx) * h;
+    const double y0 = -h * std::round(margin / h);
+    auto column = [&](double x) { return static_cast<long>(std::lround((x - x0) / h)); };
+    auto row = [&](double y) { return static_cast<long>(std::lround((y - y0) / h)); };
+
+    // 每个极板节点代表宽度为h的一段，端点节点向内收半个单元使离散极板宽度接近W
+    const double inner = half - 0.5 * h;
+
+    // 下板：y = 0，电位0
+    const long bottomRow = row(0.0);
+    for (long i = column(-inner); i <= column(inner); ++i) {
+        solver.setFixed(static_cast<size_t>(i), static_cast<size_t>(bottomRow), 0.0, BOTTOM_PLATE);
+    }
+
+    // 上板：绕 (0, gap) 倾斜，电位1；台阶形状保持四连通，避免电场从对角缝隙穿过
+    const double c = std::cos(theta);
+    const double s = std::sin(theta);
+    long lastI = column(-inner * c);
+    long lastJ = row(gap - inner * s);
+    const size_t steps = static_cast<size_t>(std::ceil(8.0 * inner / h));
+    for (size_t step = 0; step <= steps; ++step) {
+        double t = -inner + 2.0 * inner * static_cast<double>(step) / static_cast<double>(steps);
+        long i = column(t * c);
+        long j = row(gap + t * s);
+        if (i != lastI && j != lastJ) {
+            solver.setFixed(static_cast<size_t>(lastI), static_cast<size_t>(j), 1.0, TOP_PLATE);
+        }
+        solver.setFixed(static_cast<size_t>(i), static_cast<size_t>(j), 1.0, TOP_PLATE);
+        lastI = i;
+        lastJ = j;
+    }
+
+    if (solver.solve(tolerance, kMaxCycles) < 0) {
+        LOG_WARNING("Fringing field solver did not reach the requested tolerance");
+    }
+
+    // 两板电荷等量异号，取平均以抵消截断误差
+    return 0.5 * (solver.charge(TOP_PLATE) - solver.charge(BOTTOM_PLATE));
+}
+
+FringingCapacitanceModel::Key FringingCapacitanceModel::makeKey(double plateArea, double minGap,
+                                                                double maxGap, double maxAngle,
+                                                                const FringingModelOptions& options) {
+    Key key;
+    key.plateArea = plateArea;
+    key.minGap = minGap;
+    key.maxGap = std::max(maxGap, minGap);
+    key.maxAngle = std::max(0.0, std::min(std::abs(maxAngle), options.maxAngle));
+    key.tolerance = options.tolerance;
+    key.gapCount = key.maxGap > key.minGap ? std::max<size_t>(options.gapCount, 2) : 1;
+    key.angleCount = key.maxAngle > 0.0 ? std::max<size_t>(options.angleCount, 2) : 1;
+    key.maxCells = options.maxCells;
+    return key;
+}
+
+FringingCapacitanceModel::Key FringingCapacitanceModel::makeKey(const SystemConfig& config,
+                                                                const FringingModelOptions& options) {
+    // 高度下限为0时从边长的1%开始，更小的间距修正系数已趋近于1
+    double side = std::sqrt(config.getPlateArea());
+    double minGap = std::max(config.getMinHeight(), 0.01 * side);
+    double maxGap = std::max(config.getMaxHeight(), 2.0 * minGap);
+    double maxAngle = std::max(std::abs(config.getMinAngle()), std::abs(config.getMaxAngle()));
+    return makeKey(config.getPlateArea(), minGap, maxGap, maxAngle, options);
+}
+
+std::shared_ptr<const FringingCapacitanceModel> FringingCapacitanceModel::build(
+    double plateArea, double minGap, double maxGap, double maxAngle, const FringingModelOptions& options) {
+    if (!(plateArea > 0.0) || !(minGap > 0.0) || !(maxGap > 0.0)) {
+        LOG_ERROR("Invalid geometry for fringing capacitance model");
+        return nullptr;
+    }
+
+    std::shared_ptr<FringingCapacitanceModel> model(new FringingCapacitanceModel());
+    model->key = makeKey(plateArea, minGap, maxGap, maxAngle, options);
+    model->computeTable();
+    return model;
+}
+
+std::shared_ptr<const FringingCapacitanceModel> FringingCapacitanceModel::build(
+    const SystemConfig& config, const FringingModelOptions& options) {
+    Key key = makeKey(config, options);
+    return build(key.plateArea, key.minGap, key.maxGap, key.maxAngle, options);
+}
+
+std::shared_ptr<const FringingCapacitanceModel> FringingCapacitanceModel::loadOrBuild(
+    const SystemConfig& config, const std::string& cacheDir, const FringingModelOptions& options) {
+    Key key = makeKey(config, options);
+    fs::path path = fs::path(cacheDir) / cacheFileName(key);
+
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        auto cached = load(path.string());
+        if (cached && std::memcmp(&cached->key, &key, sizeof(Key)) == 0) {
+            return cached;
+        }
+        LOG_WARNING("Fringing capacitance cache does not match current geometry, rebuilding");
+    }
+
+    auto model = build(key.plateArea, key.minGap, key.maxGap, key.maxAngle, options);
+    if (model) {
+        fs::create_directories(cacheDir, ec);
+        model->save(path.string());
+    }
+    return model;
+}
+
+bool FringingCapacitanceModel::ensureInstalled(const SystemConfig& config, const std::string& cacheDir,
+                                               const FringingModelOptions& options) {
+    auto current = PhysicsCalculator::getFringingModel();
+    if (current && current->matches(config, options)) {
+        return true;
+    }
+
+    auto model = loadOrBuild(config, cacheDir, options);
+    if (!model) {
+        LOG_WARNING("Fringing capacitance model unavailable, using parallel-plate formula");
+        return false;
+    }
+    if (!model->matches(config, options)) {
+        // 构建期间几何又发生了变化，由下一次调用按新几何处理
+        LOG_INFO("Geometry changed while building fringing capacitance model, discarding it");
+        return false;
+    }
+    PhysicsCalculator::setFringingModel(model);
+    LOG_INFO(std::string(model->isLoadedFromCache() ? "Fringing capacitance model loaded from cache: "
+                                                    : "Fringing capacitance model built: ") +
+             model->cacheFileName());
+    return true;
+}
+
+std::shared_ptr<const FringingCapacitanceModel> FringingCapacitanceModel::load(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot open fringing capacitance table: " + filePath);
+        return nullptr;
+    }
+
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    std::shared_ptr<FringingCapacitanceModel> model(new FringingCapacitanceModel());
+    Key& key = model->key;
+    uint64_t tableSize = 0;
+    bool ok = static_cast<bool>(file.read(magic, sizeof(magic))) &&
+              std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+              readValue(file, version) && version == kFormatVersion &&
+              readValue(file, key.plateArea) && readValue(file, key.minGap) &&
+              readValue(file, key.maxGap) && readValue(file, key.maxAngle) &&
+              readValue(file, key.tolerance) && readValue(file, key.gapCount) &&
+              readValue(file, key.angleCount) && readValue(file, key.maxCells) &&
+              readValue(file, tableSize) &&
+              key.gapCount > 0 && key.angleCount > 0 && tableSize == key.gapCount * key.angleCount;
+    if (ok) {
+        model->gapCount = static_cast<size_t>(key.gapCount);
+        model->angleCount = static_cast<size_t>(key.angleCount);
+        model->table.resize(static_cast<size_t>(tableSize));
+        ok = static_cast<bool>(file.read(reinterpret_cast<char*>(model->table.data()),
+                                         static_cast<std::streamsize>(tableSize * sizeof(double)))) &&
+             std::all_of(model->table.begin(), model->table.end(), [](double v) { return std::isfinite(v); });
+    }
+    if (!ok) {
+        LOG_ERROR("Invalid fringing capacitance table: " + filePath);
+        return nullptr;
+    }
+
+    model->loadedFromCache = true;
+    return model;
+}
+
+bool FringingCapacitanceModel::save(const std::string& filePath) const {
+    // 先写临时文件再改名，其他进程不会读到写了一半的表格
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Cannot write fringing capacitance table: " + filePath);
+            return false;
+        }
+        file.write(kMagic, sizeof(kMagic));
+        writeValue(file, kFormatVersion);
+        writeValue(file, key.plateArea);
+        writeValue(file, key.minGap);
+        writeValue(file, key.maxGap);
+        writeValue(file, key.maxAngle);
+        writeValue(file, key.tolerance);
+        writeValue(file, key.gapCount);
+        writeValue(file, key.angleCount);
+        writeValue(file, key.maxCells);
+        writeValue(file, static_cast<uint64_t>(table.size()));
+        file.write(reinterpret_cast<const char*>(table.data()),
+                   static_cast<std::streamsize>(table.size() * sizeof(double)));
+        if (!file) {
+            LOG_ERROR("Failed to write fringing capacitance table: " + filePath);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, filePath, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        LOG_ERROR("Failed to store fringing capacitance table: " + filePath);
+        return false;
+    }
+    return true;
+}
+
+std::string FringingCapacitanceModel::cacheFileName() const {
+    return cacheFileName(key);
+}
+
+bool FringingCapacitanceModel::matches(const SystemConfig& config, const FringingModelOptions& options) const {
+    Key expected = makeKey(config, options);
+    return std::memcmp(&key, &expected, sizeof(Key)) == 0;
+}
+
+std::string FringingCapacitanceModel::cacheFileName(const Key& key) {
+    uint64_t hash = hashBytes(&kFormatVersion, sizeof(kFormatVersion));
+    hash = hashBytes(&key.plateArea, sizeof(key.plateArea), hash);
+    hash = hashBytes(&key.minGap, sizeof(key.minGap), hash);
+    hash = hashBytes(&key.maxGap, sizeof(key.maxGap), hash);
+    hash = hashBytes(&key.maxAngle, sizeof(key.maxAngle), hash);
+    hash = hashBytes(&key.tolerance, sizeof(key.tolerance), hash);
+    hash = hashBytes(&key.gapCount, sizeof(key.gapCount), hash);
+    hash = hashBytes(&key.angleCount, sizeof(key.angleCount), hash);
+    hash = hashBytes(&key.maxCells, sizeof(key.maxCells), hash);
+
+    char name[40];
+    std::snprintf(name, sizeof(name), "fringing_%016llx.bin", static_cast<unsigned long long>(hash));
+    return name;
+}
+
+double FringingCapacitanceModel::gapAt(size_t index) const {
+    if (gapCount < 2) {
+        return key.minGap;
+    }
+    double t = static_cast<double>(index) / static_cast<double>(gapCount - 1);
+    return key.minGap * std::pow(key.maxGap / key.minGap, t);
+}
+
+double FringingCapacitanceModel::angleAt(size_t index) const {
+    if (angleCount < 2) {
+        return 0.0;
+    }
+    return key.maxAngle * static_cast<double>(index) / static_cast<double>(angleCount - 1);
+}
+
+void FringingCapacitanceModel::computeTable() {
+    gapCount = static_cast<size_t>(key.gapCount);
+    angleCount = static_cast<size_t>(key.angleCount);
+    table.assign(gapCount * angleCount, 0.0);
+
+    // 先求二维系数 f2；每个节点是独立的求解，在线程池上并行
+    const double width = std::sqrt(key.plateArea);
+    ThreadPool::shared().parallelFor(table.size(), [&](size_t entry) {
+        double gap = gapAt(entry / angleCount);
+        double angle = angleAt(entry % angleCount);
+        double capacitance = crossSectionCapacitance(width, gap, angle,
+                                                     static_cast<size_t>(key.maxCells), key.tolerance);
+        double parallelPlate = width * std::cos(angle * PhysicsConstants::DEG_TO_RAD) / gap;
+        table[entry] = capacitance / parallelPlate;
+    });
+
+    // 再加上两条侧边的边缘电容得到三维系数；θ=0 时两板不会接触，sideFringe 总是有限值
+    for (size_t g = 0; g < gapCount; ++g) {
+        double sideFringe = table[g * angleCount] - 1.0;
+        for (size_t a = 0; a < angleCount; ++a) {
+            double cosine = std::cos(angleAt(a) * PhysicsConstants::DEG_TO_RAD);
+            table[g * angleCount + a] += sideFringe / cosine;
+        }
+        // 两板接触的节点在几何上不可达，沿用同一间距下最后一个可解角度的值，
+        // 使插值在接触边界附近保持连续
+        for (size_t a = 1; a < angleCount; ++a) {
+            if (!std::isfinite(table[g * angleCount + a])) {
+                table[g * angleCount + a] = table[g * angleCount + a - 1];
+            }
+        }
+    }
+}
+
+double FringingCapacitanceModel::factor(double gap, double angleDeg) const {
+    return interpolate(gap, angleDeg, nullptr);
+}
+
+double FringingCapacitanceModel::scaledFactor(double plateArea, double gap, double angleDeg,
+                                              double* gapSlope) const {
+    if (!(plateArea > 0.0)) {
+        if (gapSlope) *gapSlope = 0.0;
+        return 1.0;
+    }
+    const double scale = std::sqrt(key.plateArea / plateArea);
+    double value = interpolate(gap * scale, angleDeg, gapSlope);
+    if (gapSlope) {
+        *gapSlope *= scale;
+    }
+    return value;
+}
+
+double FringingCapacitanceModel::interpolate(double gap, double angleDeg, double* gapSlope) const {
+    if (gapSlope) {
+        *gapSlope = 0.0;
+    }
+    if (table.empty() || !(gap > 0.0)) {
+        return 1.0;
+    }
+
+    size_t g = 0;
+    size_t a = 0;
+    double wg = 0.0;
+    double wa = 0.0;
+    double position = 0.0;
+    if (gapCount > 1) {
+        position = std::log(gap / key.minGap) / std::log(key.maxGap / key.minGap) *
+                   static_cast<double>(gapCount - 1);
+        locate(position, gapCount, g, wg);
+    }
+    if (angleCount > 1) {
+        locate(std::abs(angleDeg) / key.maxAngle * static_cast<double>(angleCount - 1), angleCount, a, wa);
+    }
+
+    size_t g1 = std::min(g + 1, gapCount - 1);
+    size_t a1 = std::min(a + 1, angleCount - 1);
+    double near = (1.0 - wa) * table[g * angleCount + a] + wa * table[g * angleCount + a1];
+    double far = (1.0 - wa) * table[g1 * angleCount + a] + wa * table[g1 * angleCount + a1];
+
+    // 对数间距轴：d(position)/d(gap) = (gapCount − 1) / (gap · ln(maxGap/minGap))
+    if (gapSlope && gapCount > 1 && position > 0.0 && position < static_cast<double>(gapCount - 1)) {
+        *gapSlope = (far - near) * static_cast<double>(gapCount - 1) /
+                    (gap * std::log(key.maxGap / key.minGap));
+    }
+    return (1.0 - wg) * near + wg * far;
+}
@@ -1,6 +1,8 @@
 #include "../include/measurement_data.h"
 #include "../../utils/include/time_utils.h"
+#include "../../utils/include/format_utils.h"
 #include "../include/physics_calculator.h"
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
@@ -12,7 +14,7 @@ MeasurementData::MeasurementData()
       m_setHeight(0.0),
       m_setAngle(0.0),
       theoreticalCapacitance(0.0) {
-    theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(plateArea, m_setHeight, m_setAngle, dielectricConstant);
+    theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(plateArea, m_setHeight, m_setAngle, dielectricConstant);
 }
 
 MeasurementData::MeasurementData(double height, double angle, const SensorData& sensorData)
@@ -20,7 +22,18 @@ MeasurementData::MeasurementData(double height, double angle, const SensorData&
       m_setHeight(height),
       m_setAngle(angle),
       sensorData(sensorData) {
-    theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(plateArea, m_setHeight, m_setAngle, dielectricConstant);
+    theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(plateArea, m_setHeight, m_setAngle, dielectricConstant);
+}
+
+MeasurementData::MeasurementData(int64_t timestamp, double height, double angle, const SensorData& sensorData,
+                                 double plateArea, double dielectricConstant, double theoreticalCapacitance)
+    : timestamp(timestamp),
+      m_setHeight(height),
+      m_setAngle(angle),
+      sensorData(sensorData),
+      theoreticalCapacitance(theoreticalCapacitance),
+      plateArea(plateArea),
+      dielectricConstant(dielectricConstant) {
 }
 
 MeasurementData::MeasurementData(const MeasurementData& other) {
@@ -44,6 +57,27 @@ MeasurementData& MeasurementData::operator=(const MeasurementData& other) {
     return *this;
 }
 
+std::vector<MeasurementData> MeasurementData::createBatch(const std::vector<double>& heights,
+                                                          const std::vector<double>& angles,
+                                                          const std::vector<SensorData>& sensorData,
+                                                          double plateArea,
+                                                          double dielectricConstant) {
+    const size_t count = std::min(heights.size(), std::min(angles.size(), sensorData.size()));
+    std::vector<double> capacitances(count);
+    PhysicsCalculator::calculateTheoreticalCapacitance(heights.data(), angles.data(), count,
+                                                       capacitances.data(), plateArea, dielectricConstant);
+    
+    // 不经过默认构造，避免逐条重复计算理论电容
+    const int64_t timestamp = TimeUtils::getCurrentTimestamp();
+    std::vector<MeasurementData> batch;
+    batch.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        batch.push_back(MeasurementData(timestamp, heights[i], angles[i], sensorData[i],
+                                        plateArea, dielectricConstant, capacitances[i]));
+    }
+    return batch;
+}
+
 double MeasurementData::getCapacitanceDifference() const {
     return sensorData.capacitance - theoreticalCapacitance;
 }
@@ -51,7 +85,7 @@ double MeasurementData::getCapacitanceDifference() const {
 bool MeasurementData::setHeight(double height) {
     if (isInSafetyRange(height, m_setAngle)) {
         m_setHeight = height;
-        theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(
+        theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(
     plateArea, height, m_setAngle, dielectricConstant);
         return true;
     }
@@ -61,22 +95,27 @@ bool MeasurementData::setHeight(double height) {
 bool MeasurementData::setAngle(double angle) {
     if (isInSafetyRange(m_setHeight, angle)) {
         m_setAngle = angle;
-        theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(
+        theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(
     plateArea, m_setHeight, angle, dielectricConstant);
         return true;
     }
     return false;
 }
 
+void MeasurementData::setRawPosition(double height, double angle) {
+    m_setHeight = height;
+    m_setAngle = angle;
+}
+
 void MeasurementData::setPlateArea(double area) {
     plateArea = area; 
-    theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(
+    theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(
         plateArea, m_setHeight, m_setAngle, dielectricConstant);
 }
 
 void MeasurementData::setDielectricConstant(double epsilon) { 
     dielectricConstant = epsilon; 
-    theoreticalCapacitance = PhysicsCalculator::calculateParallelPlateCapacitance(
+    theoreticalCapacitance = PhysicsCalculator::calculateTheoreticalCapacitance(
         plateArea, m_setHeight, m_setAngle, dielectricConstant);
 }
 
@@ -102,34 +141,27 @@ std::string MeasurementData::getFormattedTime() const {
 }
 
 std::string MeasurementData::toCSV() const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2);
-    
-    // 时间戳
-    oss << TimeUtils::formatTimestamp(timestamp) << ",";
-
-    // 设定值
-    oss << m_setHeight << ",";
-    oss << m_setAngle << ",";
-    oss << theoreticalCapacitance << ",";
-    
-    // 传感器原始数据
-    oss << sensorData.distanceUpper1 << ",";
-    oss << sensorData.distanceUpper2 << ",";
-    oss << sensorData.distanceLower1 << ",";
-    oss << sensorData.distanceLower2 << ",";
-    oss << sensorData.temperature << ",";
-    oss << sensorData.angle << ",";
-    oss << sensorData.capacitance << ",";
-    
-    // 计算值
-    oss << sensorData.getAverageHeight() << ",";
-    oss << sensorData.getCalculatedAngle() << ",";
-    oss << sensorData.getAverageGroundDistance() << ",";
-    oss << sensorData.getCalculatedUpperDistance() << ",";
-    oss << getCapacitanceDifference();
-    
-    return oss.str();
+    const double values[] = {
+        // 设定值
+        m_setHeight, m_setAngle, theoreticalCapacitance,
+        // 传感器原始数据
+        sensorData.distanceUpper1, sensorData.distanceUpper2,
+        sensorData.distanceLower1, sensorData.distanceLower2,
+        sensorData.temperature, sensorData.angle, sensorData.capacitance,
+        // 计算值
+        sensorData.getAverageHeight(), sensorData.getCalculatedAngle(),
+        sensorData.getAverageGroundDistance(), sensorData.getCalculatedUpperDistance(),
+        getCapacitanceDifference()
+    };
+
+    std::string result;
+    result.reserve(256);
+    result += TimeUtils::formatTimestamp(timestamp);
+    for (double value : values) {
+        result += ',';
+        FormatUtils::appendFixed(result, value, 2);
+    }
+    return result;
 }
 
 std::string MeasurementData::getCSVHeader() {
@@ -1,6 +1,35 @@
 #include "../include/physics_calculator.h"
 #include "../include/physics_constants.h"
+#include "../include/fringing_capacitance.h"
+#include "../../utils/include/logger.h"
+#include <atomic>
 #include <cmath>
+#include <string>
+
+namespace {
+
+std::shared_ptr<const FringingCapacitanceModel> activeFringingModel;
+std::atomic<bool> fringingMismatchLogged{false};
+std::atomic<double> parasiticCapacitance{0.0};   // pF
+std::atomic<double> distanceOffset{0.0};         // mm
+
+// 模型只对构建它时的极板面积有效；面积不一致时退回平行板公式，每个模型只记录一次
+std::shared_ptr<const FringingCapacitanceModel> fringingModelFor(double plateArea_mm2) {
+    auto model = std::atomic_load(&activeFringingModel);
+    if (!model) {
+        return nullptr;
+    }
+    if (std::abs(model->getPlateArea() - plateArea_mm2) <= 1e-9 * plateArea_mm2) {
+        return model;
+    }
+    if (!fringingMismatchLogged.exchange(true)) {
+        LOG_WARNING("Fringing capacitance model was built for plate area " + std::to_string(model->getPlateArea()) +
+                    " mm², requested " + std::to_string(plateArea_mm2) + " mm², using parallel-plate formula");
+    }
+    return nullptr;
+}
+
+} // namespace
 
 double PhysicsCalculator::calculateParallelPlateCapacitance(
     double plateArea_mm2, double distance_mm, 
@@ -25,4 +54,127 @@ double PhysicsCalculator::calculateAngleFromSensors(
     double heightDiff = distance2 - distance1;
     double angleRad = std::atan(heightDiff / sensorSpacing);
     return angleRad * PhysicsConstants::RAD_TO_DEG;
-}
\ No newline at end of file
+}
+
+void PhysicsCalculator::calculateParallelPlateCapacitance(
+    const double* distances_mm, const double* angles_degrees, size_t count, double* out,
+    double plateArea_mm2, double dielectricConstant) {
+    
+    // 与标量版本相同的运算顺序，保证结果逐位一致
+    const double permittivity = PhysicsConstants::EPSILON_0 * dielectricConstant;
+    constexpr size_t blockSize = 256;
+    double effectiveArea[blockSize];
+    
+    double lastAngle = 0.0;
+    double lastArea = plateArea_mm2 * std::cos(0.0);
+    
+    for (size_t begin = 0; begin < count; begin += blockSize) {
+        const size_t len = count - begin < blockSize ? count - begin : blockSize;
+        
+        // 有效面积：余弦逐个计算，角度不变时复用
+        for (size_t i = 0; i < len; ++i) {
+            double angle = angles_degrees ? angles_degrees[begin + i] : 0.0;
+            if (angle != lastAngle) {
+                lastAngle = angle;
+                lastArea = plateArea_mm2 * std::cos(angle * PhysicsConstants::DEG_TO_RAD);
+            }
+            effectiveArea[i] = lastArea;
+        }
+        
+        // 无分支的算术部分（非正距离用选择而不是提前返回）
+        for (size_t i = 0; i < len; ++i) {
+            double distance = distances_mm[begin + i];
+            double capacitance = permittivity * (effectiveArea[i] * 1e-6) / (distance * 1e-3) * 1e12;
+            out[begin + i] = distance <= 0.0 ? 0.0 : capacitance;
+        }
+    }
+}
+
+double PhysicsCalculator::calculateTheoreticalCapacitance(
+    double plateArea_mm2, double distance_mm,
+    double angle_degrees, double dielectricConstant) {
+    
+    const double distance = distance_mm + distanceOffset.load(std::memory_order_relaxed);
+    double capacitance = calculateParallelPlateCapacitance(
+        plateArea_mm2, distance, angle_degrees, dielectricConstant);
+    auto model = fringingModelFor(plateArea_mm2);
+    if (model) {
+        capacitance *= model->factor(distance, angle_degrees);
+    }
+    return capacitance + parasiticCapacitance.load(std::memory_order_relaxed);
+}
+
+void PhysicsCalculator::calculateTheoreticalCapacitance(
+    const double* distances_mm, const double* angles_degrees, size_t count, double* out,
+    double plateArea_mm2, double dielectricConstant) {
+    
+    auto model = fringingModelFor(plateArea_mm2);
+    const double offset = distanceOffset.load(std::memory_order_relaxed);
+    const double parasitic = parasiticCapacitance.load(std::memory_order_relaxed);
+    if (!model && offset == 0.0 && parasitic == 0.0) {
+        calculateParallelPlateCapacitance(distances_mm, angles_degrees, count, out,
+                                          plateArea_mm2, dielectricConstant);
+        return;
+    }
+    
+    // out可能与distances_mm是同一数组：先把修正后的距离和修正系数复制到块缓冲区
+    constexpr size_t blockSize = 256;
+    double distances[blockSize];
+    double factors[blockSize];
+    for (size_t begin = 0; begin < count; begin += blockSize) {
+        const size_t len = count - begin < blockSize ? count - begin : blockSize;
+        for (size_t i = 0; i < len; ++i) {
+            distances[i] = distances_mm[begin + i] + offset;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            double angle = angles_degrees ? angles_degrees[begin + i] : 0.0;
+            factors[i] = model ? model->factor(distances[i], angle) : 1.0;
+        }
+        calculateParallelPlateCapacitance(distances, angles_degrees ? angles_degrees + begin : nullptr,
+                                          len, out + begin, plateArea_mm2, dielectricConstant);
+        for (size_t i = 0; i < len; ++i) {
+            out[begin + i] = out[begin + i] * factors[i] + parasitic;
+        }
+    }
+}
+
+void PhysicsCalculator::setFringingModel(std::shared_ptr<const FringingCapacitanceModel> model) {
+    std::atomic_store(&activeFringingModel, std::move(model));
+    fringingMismatchLogged.store(false);
+}
+
+std::shared_ptr<const FringingCapacitanceModel> PhysicsCalculator::getFringingModel() {
+    return std::atomic_load(&activeFringingModel);
+}
+
+void PhysicsCalculator::setCapacitanceOffsets(double parasitic_pF, double distanceOffset_mm) {
+    parasiticCapacitance.store(parasitic_pF);
+    distanceOffset.store(distanceOffset_mm);
+}
+
+double PhysicsCalculator::getParasiticCapacitance() {
+    return parasiticCapacitance.load();
+}
+
+double PhysicsCalculator::getDistanceOffset() {
+    return distanceOffset.load();
+}
+
+void PhysicsCalculator::calculateAngleFromSensors(
+    const double* distances1, const double* distances2, size_t count,
+    double sensorSpacing, double* out) {
+    
+    if (sensorSpacing <= 0.0) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = 0.0;
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = (distances2[i] - distances1[i]) / sensorSpacing;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::atan(out[i]) * PhysicsConstants::RAD_TO_DEG;
+    }
+}
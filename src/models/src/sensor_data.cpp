@@ -1,6 +1,7 @@
 #include "../include/sensor_data.h"
 #include "../include/system_config.h"
 #include "../../utils/include/time_utils.h"
+#include "../../utils/include/format_utils.h"
 #include "../include/physics_constants.h"
 #include "../../utils/include/math_utils.h"
 #include "../../utils/include/logger.h"
@@ -164,6 +165,7 @@ bool SensorData::setAngle(double a) {
 }
 
 bool SensorData::setCapacitance(double cap) {
+        capacitance = cap;
         isValid.capacitance = true;
         return true;
 }
@@ -178,6 +180,45 @@ bool SensorData::hasValidData() const {
            isValid.temperature || isValid.angle || isValid.capacitance;
 }
 
+double SensorData::getChannelValue(SensorChannel channel) const {
+    switch (channel) {
+        case SensorChannel::DISTANCE_UPPER_1: return distanceUpper1;
+        case SensorChannel::DISTANCE_UPPER_2: return distanceUpper2;
+        case SensorChannel::DISTANCE_LOWER_1: return distanceLower1;
+        case SensorChannel::DISTANCE_LOWER_2: return distanceLower2;
+        case SensorChannel::TEMPERATURE:      return temperature;
+        case SensorChannel::ANGLE:            return angle;
+        case SensorChannel::CAPACITANCE:      return capacitance;
+        default:                              return 0.0;
+    }
+}
+
+bool SensorData::isChannelValid(SensorChannel channel) const {
+    switch (channel) {
+        case SensorChannel::DISTANCE_UPPER_1: return isValid.distanceUpper1;
+        case SensorChannel::DISTANCE_UPPER_2: return isValid.distanceUpper2;
+        case SensorChannel::DISTANCE_LOWER_1: return isValid.distanceLower1;
+        case SensorChannel::DISTANCE_LOWER_2: return isValid.distanceLower2;
+        case SensorChannel::TEMPERATURE:      return isValid.temperature;
+        case SensorChannel::ANGLE:            return isValid.angle;
+        case SensorChannel::CAPACITANCE:      return isValid.capacitance;
+        default:                              return false;
+    }
+}
+
+void SensorData::setChannelValue(SensorChannel channel, double value) {
+    switch (channel) {
+        case SensorChannel::DISTANCE_UPPER_1: distanceUpper1 = value; break;
+        case SensorChannel::DISTANCE_UPPER_2: distanceUpper2 = value; break;
+        case SensorChannel::DISTANCE_LOWER_1: distanceLower1 = value; break;
+        case SensorChannel::DISTANCE_LOWER_2: distanceLower2 = value; break;
+        case SensorChannel::TEMPERATURE:      temperature = value; break;
+        case SensorChannel::ANGLE:            angle = value; break;
+        case SensorChannel::CAPACITANCE:      capacitance = value; break;
+        default:                              break;
+    }
+}
+
 bool SensorData::parseFromString(const std::string& dataString) {
     if (dataString.empty()) {
         return false;
@@ -248,35 +289,27 @@ std::string SensorData::toString() const {
 }
 
 std::string SensorData::toCSV() const {
-    std::ostringstream oss;
-    auto formatFloat = [](double value, int precision = 2) -> std::string {
+    const double values[] = {
+        distanceUpper1, distanceUpper2, distanceLower1, distanceLower2,
+        temperature, angle, capacitance,
+        getAverageHeight(), getCalculatedAngle(),
+        getAverageGroundDistance(), getCalculatedUpperDistance()
+    };
+
+    std::string result;
+    result.reserve(192);
+    result += TimeUtils::formatTimestamp(timestamp);
+    for (double value : values) {
+        result += ',';
         if (std::isnan(value)) {
-            return "NaN";
+            result += "NaN";
         } else if (std::isinf(value)) {
-            return value > 0 ? "Inf" : "-Inf";
+            result += value > 0 ? "Inf" : "-Inf";
         } else {
-            std::ostringstream ss;
-            ss << std::fixed << std::setprecision(precision) << value;
-            return ss.str();
+            FormatUtils::appendFixed(result, value, 2);
         }
-    };
-    
-    oss << TimeUtils::formatTimestamp(timestamp) << ",";
-    
-    oss << formatFloat(distanceUpper1) << ",";
-    oss << formatFloat(distanceUpper2) << ",";
-    oss << formatFloat(distanceLower1) << ",";
-    oss << formatFloat(distanceLower2) << ",";
-    oss << formatFloat(temperature) << ",";
-    oss << formatFloat(angle) << ",";
-    oss << formatFloat(capacitance) << ",";
-    
-    oss << formatFloat(getAverageHeight()) << ",";
-    oss << formatFloat(getCalculatedAngle()) << ",";
-    oss << formatFloat(getAverageGroundDistance()) << ",";
-    oss << formatFloat(getCalculatedUpperDistance());
-    
-    return oss.str();
+    }
+    return result;
 }
 
 std::string SensorData::getCSVHeader() {
@@ -1,4 +1,5 @@
 #include "../include/system_config.h"
+#include "../include/physics_calculator.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -63,6 +64,8 @@ bool SystemConfig::loadFromFile(const std::string& filename) {
         // 解析电容板参数
         std::regex areaRegex(R"("area"\s*:\s*([0-9.+-]+))");
         std::regex epsilonRegex(R"("dielectricConstant"\s*:\s*([0-9.+-]+))");
+        std::regex parasiticRegex(R"("parasiticCapacitance"\s*:\s*([0-9.+-]+))");
+        std::regex offsetRegex(R"("distanceOffset"\s*:\s*([0-9.+-]+))");
         
         if (std::regex_search(content, match, areaRegex)) {
             plateArea = std::stod(match[1]);
@@ -70,6 +73,13 @@ bool SystemConfig::loadFromFile(const std::string& filename) {
         if (std::regex_search(content, match, epsilonRegex)) {
             dielectricConstant = std::stod(match[1]);
         }
+        if (std::regex_search(content, match, parasiticRegex)) {
+            parasiticCapacitance = std::stod(match[1]);
+        }
+        if (std::regex_search(content, match, offsetRegex)) {
+            distanceOffset = std::stod(match[1]);
+        }
+        PhysicsCalculator::setCapacitanceOffsets(parasiticCapacitance, distanceOffset);
         
         // 解析系统尺寸
         std::regex totalHeightRegex(R"("totalHeight"\s*:\s*([0-9.+-]+))");
@@ -154,8 +164,10 @@ bool SystemConfig::saveToFile(const std::string& filename) const {
     
     // 电容板参数
     file << "    \"capacitorPlate\": {\n";
-    file << "        \"area\": " << std::setprecision(3) << plateArea << ",\n";
-    file << "        \"dielectricConstant\": " << dielectricConstant << "\n";
+    file << "        \"area\": " << std::setprecision(6) << plateArea << ",\n";
+    file << "        \"dielectricConstant\": " << dielectricConstant << ",\n";
+    file << "        \"parasiticCapacitance\": " << parasiticCapacitance << ",\n";
+    file << "        \"distanceOffset\": " << distanceOffset << "\n";
     file << "    },\n";
     
     // 系统尺寸
@@ -197,11 +209,13 @@ void SystemConfig::setSafetyLimits(double minH, double maxH, double minA, double
         return;
     }
     
-    std::lock_guard<std::mutex> lock(mutex);
-    minHeight = minH;
-    maxHeight = maxH;
-    minAngle = minA;
-    maxAngle = maxA;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        minHeight = minH;
+        maxHeight = maxH;
+        minAngle = minA;
+        maxAngle = maxA;
+    }
     notifyChange();
 }
 
@@ -210,9 +224,11 @@ void SystemConfig::setHeightLimits(double minH, double maxH) {
         return; // 无效范围
     }
     
-    std::lock_guard<std::mutex> lock(mutex);
-    this->minHeight = minH;
-    this->maxHeight = maxH;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->minHeight = minH;
+        this->maxHeight = maxH;
+    }
     notifyChange();
 }
 
@@ -221,9 +237,11 @@ void SystemConfig::setAngleLimits(double minA, double maxA) {
         return; // 无效范围
     }
     
-    std::lock_guard<std::mutex> lock(mutex);
-    this->minAngle = minA;
-    this->maxAngle = maxA;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->minAngle = minA;
+        this->maxAngle = maxA;
+    }
     notifyChange();
 }
 
@@ -232,8 +250,10 @@ bool SystemConfig::setPlateArea(double area) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(mutex);
-    plateArea = area;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        plateArea = area;
+    }
     notifyChange();
     return true;
 }
@@ -243,25 +263,56 @@ bool SystemConfig::setDielectricConstant(double epsilon) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(mutex);
-    dielectricConstant = epsilon;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dielectricConstant = epsilon;
+    }
+    notifyChange();
+    return true;
+}
+
+void SystemConfig::setCapacitanceOffsets(double parasitic, double offset) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        parasiticCapacitance = parasitic;
+        distanceOffset = offset;
+    }
+    notifyChange();
+}
+
+bool SystemConfig::setCapacitorCalibration(double area, double epsilon, double parasitic, double offset) {
+    if (area <= 0 || area > 1000000 || epsilon <= 0) {
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        plateArea = area;
+        dielectricConstant = epsilon;
+        parasiticCapacitance = parasitic;
+        distanceOffset = offset;
+    }
     notifyChange();
     return true;
 }
 
 void SystemConfig::setSystemDimensions(double total, double middle, double spacing) {
-    std::lock_guard<std::mutex> lock(mutex);
-    totalHeight = total;
-    middlePlateHeight = middle;
-    sensorSpacing = spacing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        totalHeight = total;
+        middlePlateHeight = middle;
+        sensorSpacing = spacing;
+    }
     notifyChange();
 }
 
 
 void SystemConfig::setHomePosition(double height, double angle) {
-    std::lock_guard<std::mutex> lock(mutex);
-    homeHeight = height;
-    homeAngle = angle;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        homeHeight = height;
+        homeAngle = angle;
+    }
     notifyChange();
 }
 
@@ -290,32 +341,36 @@ void SystemConfig::setConfigChangeCallback(ConfigChangeCallback callback) {
 
 // 更新reset()方法以使用新的默认值
 void SystemConfig::reset() {
-    std::lock_guard<std::mutex> lock(mutex);
-    
-    // 重置到新的默认值（符合第二页需求）
-    minHeight = 0.0;
-    maxHeight = 150.0;        // mm
-    minAngle = -90.0;
-    maxAngle = 90.0;
-    
-    plateArea = 2500.0;       // mm² (50mm x 50mm)
-    dielectricConstant = 1.0;
-    
-    totalHeight = 150.0;      // mm
-    middlePlateHeight = 25.0; // mm
-    sensorSpacing = 80.0;     // mm
-    
-    homeHeight = 0.0;         // mm，改为0
-    homeAngle = 0.0;          // degrees
-    
-    defaultBaudRate = 115200;
-    communicationTimeout = 5000;
-    retryCount = 3;
-    
-    sensorUpdateInterval = 2000;
-    maxRecords = 10000;
-    autoSaveInterval = 300000;
-    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        // 重置到新的默认值（符合第二页需求）
+        minHeight = 0.0;
+        maxHeight = 150.0;        // mm
+        minAngle = -90.0;
+        maxAngle = 90.0;
+        
+        plateArea = 2500.0;       // mm² (50mm x 50mm)
+        dielectricConstant = 1.0;
+        parasiticCapacitance = 0.0;
+        distanceOffset = 0.0;
+        
+        totalHeight = 150.0;      // mm
+        middlePlateHeight = 25.0; // mm
+        sensorSpacing = 80.0;     // mm
+        
+        homeHeight = 0.0;         // mm，改为0
+        homeAngle = 0.0;          // degrees
+        
+        defaultBaudRate = 115200;
+        communicationTimeout = 5000;
+        retryCount = 3;
+        
+        sensorUpdateInterval = 2000;
+        maxRecords = 10000;
+        autoSaveInterval = 300000;
+        
+    }
     notifyChange();
 }
 
@@ -326,7 +381,8 @@ std::string SystemConfig::getConfigSummary() const {
     oss << "System Configuration:\n";
     oss << "  Safety Limits: Height[" << minHeight << "-" << maxHeight << "]mm, ";
     oss << "Angle[" << minAngle << "-" << maxAngle << "]°\n";
-    oss << "  Capacitor: Area=" << plateArea << "m², ε_r=" << dielectricConstant << "\n";
+    oss << "  Capacitor: Area=" << plateArea << "mm², ε_r=" << dielectricConstant
+        << ", C_p=" << parasiticCapacitance << "pF, d_0=" << distanceOffset << "mm\n";
     oss << "  System: Height=" << totalHeight << "mm, MiddlePlate=" << middlePlateHeight << "mm\n";
     oss << "  Motor: Home=[" << homeHeight << "mm, " << homeAngle << "°]\n";
     oss << "  Communication: BaudRate=" << defaultBaudRate << ", Timeout=" << communicationTimeout << "ms\n";
@@ -339,6 +395,8 @@ void SystemConfig::notifyChange() {
     ConfigChangeCallback cb;
     {
         std::lock_guard<std::mutex> lock(mutex);
+        // 校准参数作用于全部理论电容计算
+        PhysicsCalculator::setCapacitanceOffsets(parasiticCapacitance, distanceOffset);
         cb = changeCallback;
     }
     if (cb) cb();
@@ -0,0 +1,59 @@
+#ifndef CUBIC_SPLINE_H
+#define CUBIC_SPLINE_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief 自然三次样条
+ *
+ * 构造时用追赶法（三对角矩阵算法）一次求出所有节点的二阶导数，O(n)；
+ * 每个区间预存多项式系数，求值时只需定位区间加一次Horner计算：
+ * - 单点求值使用二分查找，O(log n)
+ * - 批量求值对递增的查询点使用移动游标，整体 O(n + m)
+ *
+ * 查询点超出节点范围时按端点区间的多项式外推。构造完成后对象只读，可在线程间共享。
+ */
+class CubicSpline {
+public:
+    CubicSpline() = default;
+
+    /**
+     * @brief 由节点构造样条
+     * @param x 严格递增的节点横坐标
+     * @param y 节点纵坐标
+     * @return x非严格递增、长度不一致或节点少于2个时返回false
+     */
+    bool build(const std::vector<double>& x, const std::vector<double>& y);
+
+    bool isValid() const { return !xs.empty(); }
+    size_t size() const { return xs.size(); }
+
+    double evaluate(double x) const;
+
+    /**
+     * @brief 批量求值
+     * @param x      查询点；若非递减则使用游标，否则逐点二分查找
+     * @param count  查询点个数
+     * @param out    输出缓冲区，至少count个元素
+     */
+    void evaluate(const double* x, size_t count, double* out) const;
+    std::vector<double> evaluate(const std::vector<double>& x) const;
+
+    /**
+     * @brief 定位x所在区间 [xs[i], xs[i+1]]，结果限制在 0..size()-2
+     */
+    size_t findInterval(double x) const;
+
+private:
+    double evaluateInterval(size_t i, double x) const;
+
+    std::vector<double> xs;
+    // 区间i上：y = a + b·dx + c·dx² + d·dx³，dx = x - xs[i]
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<double> c;
+    std::vector<double> d;
+};
+
+#endif // CUBIC_SPLINE_H
@@ -0,0 +1,83 @@
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <complex>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief FFT计算计划
+ *
+ * 为固定长度预先计算旋转因子和位反转表，创建后只读，可在线程间共享：
+ * - 2的幂长度：迭代式基2原位蝶形运算
+ * - 任意长度：Bluestein（chirp-z）算法，内部复用2的幂长度计划
+ *
+ * 通过 FFTPlan::get() 获取的计划按长度缓存，重复分析同一长度时不再重新计算旋转因子。
+ */
+class FFTPlan {
+public:
+    using Complex = std::complex<double>;
+
+    /**
+     * @brief 获取指定长度的缓存计划（线程安全）
+     */
+    static std::shared_ptr<const FFTPlan> get(size_t n);
+
+    /**
+     * @brief 清空计划缓存
+     */
+    static void clearCache();
+
+    explicit FFTPlan(size_t n);
+
+    size_t size() const { return n; }
+    bool isPowerOfTwo() const { return useRadix2; }
+
+    /**
+     * @brief 原位正变换（不归一化）
+     */
+    void forward(Complex* data) const;
+
+    /**
+     * @brief 原位逆变换（结果已除以n，inverse(forward(x)) == x）
+     */
+    void inverse(Complex* data) const;
+
+    /**
+     * @brief 实数输入正变换
+     * @param input  n个实数样本
+     * @param output 输出 n/2+1 个非负频率分量
+     */
+    void forwardReal(const double* input, Complex* output) const;
+
+    // vector便捷接口
+    std::vector<Complex> forward(const std::vector<Complex>& data) const;
+    std::vector<Complex> forwardReal(const std::vector<double>& input) const;
+
+private:
+    void transformRadix2(Complex* data, bool invert) const;
+    void transformBluestein(Complex* data, bool invert) const;
+    void prepareRealTransform() const;
+
+    size_t n;
+    bool useRadix2;
+
+    // 基2：旋转因子 exp(-2πik/n)，k < n/2；位反转置换表
+    std::vector<Complex> twiddles;
+    std::vector<uint32_t> bitReverse;
+
+    // Bluestein：chirp序列及其共轭滤波器在m点上的频谱
+    std::vector<Complex> chirp;
+    std::vector<Complex> chirpFilterSpectrum;
+    std::shared_ptr<const FFTPlan> convolutionPlan;
+
+    // 实数变换：n/2长度的复数子计划与后处理旋转因子（首次使用时创建）
+    mutable std::once_flag realOnce;
+    mutable std::shared_ptr<const FFTPlan> halfPlan;
+    mutable std::vector<Complex> realTwiddles;
+};
+
+#endif // FFT_PLAN_H
@@ -0,0 +1,70 @@
+#ifndef FORMAT_UTILS_H
+#define FORMAT_UTILS_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "time_utils.h"
+
+/**
+ * @brief 与区域设置无关的数字格式化，直接追加到输出缓冲区
+ *
+ * 基于 std::to_chars：小数点总是'.'，不分配临时字符串。
+ * appendFixed 与流的 std::fixed + setprecision 输出逐字一致。
+ */
+class FormatUtils {
+public:
+    // 定点小数，decimalPlaces位小数
+    static void appendFixed(std::string& out, double value, int decimalPlaces);
+
+    // 能精确还原该值的最短表示
+    static void appendShortest(std::string& out, double value);
+
+    static void appendInteger(std::string& out, int64_t value);
+
+    static std::string formatFixed(double value, int decimalPlaces);
+};
+
+/**
+ * @brief 带缓存的时间戳格式化（毫秒时间戳 → strftime格式）
+ *
+ * 同一分钟内的时间戳只有秒字段不同：按分钟缓存其余部分的渲染结果，
+ * 分钟不变时只写秒（和毫秒），不再调用localtime/strftime。
+ * 格式中含有依赖秒但不可拆分的转换（%s、%c、%X、%r、%+ 等）时不缓存，每次完整渲染。
+ *
+ * 非线程安全：每个线程（或每个导出块）使用自己的实例。
+ */
+class TimestampFormatter {
+public:
+    /**
+     * @param format strftime格式
+     * @param milliseconds 是否在末尾追加 ".mmm"
+     * @param suffix 末尾附加的固定文本（如UTC的"Z"）
+     */
+    explicit TimestampFormatter(const std::string& format = "%Y-%m-%d %H:%M:%S",
+                                TimeUtils::TimeZone timeZone = TimeUtils::TimeZone::LOCAL,
+                                bool milliseconds = false,
+                                const std::string& suffix = "");
+
+    void append(std::string& out, int64_t timestampMs);
+    std::string format(int64_t timestampMs);
+
+private:
+    void renderMinute(int64_t minute);
+    void renderFull(std::string& out, int64_t seconds) const;
+    std::tm toTm(int64_t seconds) const;
+
+    std::string pattern;
+    TimeUtils::TimeZone timeZone;
+    bool milliseconds;
+    std::string suffix;
+
+    bool cacheable = true;
+    std::vector<std::string> pieces;   // 按%S拆分的格式片段
+    std::vector<std::string> rendered; // 当前分钟各片段的渲染结果
+    int64_t cachedMinute = 0;
+    bool hasCache = false;
+};
+
+#endif // FORMAT_UTILS_H
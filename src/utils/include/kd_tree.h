@@ -0,0 +1,44 @@
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief 二维k-d树
+ *
+ * 以隐式数组方式存储（按中位数递归划分的点索引），构造 O(n log n)，
+ * k近邻查询平均 O(log n + k)。构造完成后只读，可在线程间共享。
+ */
+class KdTree2D {
+public:
+    KdTree2D() = default;
+
+    /**
+     * @brief 由点集构造，x与y长度须一致
+     */
+    void build(const std::vector<double>& x, const std::vector<double>& y);
+
+    size_t size() const { return index.size(); }
+    bool empty() const { return index.empty(); }
+
+    /**
+     * @brief 查询距(qx, qy)最近的k个点
+     * @param indices 输出点的原始下标，按距离从近到远
+     * @param distancesSq 输出对应的平方距离
+     */
+    void nearest(double qx, double qy, size_t k,
+                 std::vector<size_t>& indices, std::vector<double>& distancesSq) const;
+
+private:
+    void buildRange(size_t begin, size_t end, int depth);
+    void search(size_t begin, size_t end, int depth, double qx, double qy, size_t k,
+                std::vector<std::pair<double, size_t>>& heap) const;
+
+    std::vector<double> px;
+    std::vector<double> py;
+    std::vector<size_t> index;   // 子区间[begin, end)的中点为该节点
+};
+
+#endif // KD_TREE_H
@@ -0,0 +1,66 @@
+#ifndef LAPLACE_SOLVER_H
+#define LAPLACE_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 二维拉普拉斯方程的多重网格求解器
+ *
+ * 均匀网格上 (nx+1)×(ny+1) 个节点，五点差分格式。固定节点为狄利克雷条件（如电极电位），
+ * 外边界为零法向导数（镜像），相当于孤立系统，电极间的电通量全部闭合在电极之间。
+ *
+ * 求解采用V循环：红黑Gauss-Seidel平滑、全加权限制、双线性延拓；
+ * 粗网格上与细网格固定节点重合或上下左右相邻的节点也视为固定，使细薄电极在粗网格上仍然可见。
+ * 网格在nx、ny均为偶数时逐层减半，nx、ny取16的倍数可得到足够的层数。
+ */
+class LaplaceSolver2D {
+public:
+    LaplaceSolver2D(size_t nx, size_t ny);
+
+    size_t nodesX() const { return levels[0].nx + 1; }
+    size_t nodesY() const { return levels[0].ny + 1; }
+
+    /**
+     * @brief 固定节点电位；label > 0 的节点可用 charge(label) 汇总电荷
+     */
+    void setFixed(size_t i, size_t j, double value, int label = 0);
+    bool isFixed(size_t i, size_t j) const;
+    int labelAt(size_t i, size_t j) const;
+    double value(size_t i, size_t j) const;
+
+    /**
+     * @brief 求解，返回V循环次数；残差未降到初始残差的tolerance倍以下时返回-1
+     */
+    int solve(double tolerance = 1e-9, int maxCycles = 100);
+
+    /**
+     * @brief 指定标签的固定节点上的电荷之和（以ε为单位的单位长度电荷，与网格间距无关）
+     */
+    double charge(int label) const;
+
+private:
+    struct Level {
+        size_t nx = 0;
+        size_t ny = 0;
+        std::vector<double> u;
+        std::vector<double> f;
+        std::vector<uint8_t> fixed;
+
+        size_t index(size_t i, size_t j) const { return j * (nx + 1) + i; }
+    };
+
+    void buildCoarseMasks();
+    void smooth(Level& level, int sweeps) const;
+    double residual(const Level& level, std::vector<double>& r) const;
+    void restrictResidual(const Level& fine, const std::vector<double>& r, Level& coarse) const;
+    void prolongAndCorrect(const Level& coarse, Level& fine) const;
+    void vCycle(size_t depth);
+
+    std::vector<Level> levels;
+    std::vector<int8_t> labels;
+    bool masksBuilt = false;
+};
+
+#endif // LAPLACE_SOLVER_H
@@ -0,0 +1,81 @@
+#ifndef LEAST_SQUARES_H
+#define LEAST_SQUARES_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief 线性最小二乘求解器
+ *
+ * 对列主序的 rows×cols 矩阵 A 做一次分解，之后可对任意多个右端项求解 min ||A·x - b||：
+ * - 先将每列缩放为单位范数，降低条件数
+ * - 默认使用 Householder QR 分解
+ * - 矩阵秩亏（或行数少于列数）时退回单边 Jacobi SVD，给出（缩放后变量下的）最小范数解
+ *
+ * 分解完成后对象只读，可在线程间共享。
+ */
+class LeastSquaresSolver {
+public:
+    /**
+     * @param a    列主序矩阵数据，a[col * rows + row]
+     * @param rows 行数（方程数）
+     * @param cols 列数（未知数个数）
+     */
+    LeastSquaresSolver(std::vector<double> a, size_t rows, size_t cols);
+
+    size_t rows() const { return m; }
+    size_t cols() const { return n; }
+    size_t rank() const { return effectiveRank; }
+    bool usesSVD() const { return useSVD; }
+
+    /**
+     * @brief 求解一个右端项
+     * @param b 长度为rows
+     * @param x 输出，长度为cols
+     */
+    void solve(const double* b, double* x) const;
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    /**
+     * @brief 多项式最小二乘拟合
+     *
+     * 自变量先平移缩放到 [-1, 1] 再构造 Vandermonde 矩阵，求解后换算回原始自变量下的系数。
+     * @param weights 可为nullptr；否则为每个点的非负权重
+     * @param coefficients 输出，从低阶到高阶共 degree+1 个
+     * @return 点数不足或参数无效时返回false
+     */
+    static bool fitPolynomial(const double* x, const double* y, const double* weights,
+                              size_t count, int degree, std::vector<double>& coefficients);
+
+    /**
+     * @brief 共享自变量的多项式批量拟合（只分解一次）
+     * @param ySeries 每个元素与x等长
+     * @param coefficients 输出，每个序列一组系数
+     */
+    static bool fitPolynomials(const std::vector<double>& x,
+                               const std::vector<std::vector<double>>& ySeries,
+                               int degree,
+                               std::vector<std::vector<double>>& coefficients);
+
+private:
+    void factorQR();
+    void factorSVD();
+
+    // 构造 t = (x - center) / scale 的 Vandermonde 矩阵（列主序，可带行权重）
+    static std::vector<double> vandermonde(const double* x, const double* sqrtWeights, size_t count,
+                                           int degree, double center, double scale);
+    static void polynomialRange(const double* x, size_t count, double& center, double& scale);
+    static std::vector<double> toPowerBasis(const std::vector<double>& scaled, double center, double scale);
+
+    size_t m;
+    size_t n;
+    std::vector<double> matrix;       // QR: R的上三角 + Householder向量; SVD: 左奇异向量U
+    std::vector<double> columnScale;  // 列缩放因子
+    std::vector<double> rDiag;        // QR: R的对角元
+    std::vector<double> singular;     // SVD: 奇异值
+    std::vector<double> rightVectors; // SVD: 右奇异向量V（列主序 n×n）
+    size_t effectiveRank = 0;
+    bool useSVD = false;
+};
+
+#endif // LEAST_SQUARES_H
@@ -0,0 +1,70 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief 可合并的流式分位数草图（合并式 t-digest）
+ *
+ * 新样本先进入缓冲区，缓冲区满时与已有质心一起排序压缩，
+ * 质心数量受压缩参数约束（约为 compression/2 量级），与样本总数无关，
+ * 因此插入均摊 O(log δ)，查询只遍历固定数量的质心。
+ * 两端质心更小，p1/p99 这类尾部分位数的相对误差也较低。
+ *
+ * 两个草图可以合并（会话之间、数据块之间），合并结果与在同一草图中顺序插入精度相当，
+ * 因此历史数据只需保存草图本身而不必保留原始样本。
+ * 查询时会整理缓冲区，非线程安全，由调用方加锁。
+ */
+class QuantileSketch {
+public:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    explicit QuantileSketch(double compression = 100.0);
+
+    /**
+     * @brief 加入一个样本，weight可用于导入已有质心
+     */
+    void add(double value, double weight = 1.0);
+    void merge(const QuantileSketch& other);
+    void reset();
+
+    /**
+     * @brief 估计q分位数（q ∈ [0, 1]），空草图返回0
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief 估计小于等于value的样本比例
+     */
+    double cdf(double value) const;
+
+    double count() const { return totalWeight; }
+    bool empty() const { return totalWeight <= 0.0; }
+    double min() const { return minimum; }
+    double max() const { return maximum; }
+    double compression() const { return delta; }
+
+    /**
+     * @brief 压缩后的质心（按均值升序），用于持久化
+     */
+    const std::vector<Centroid>& centroids() const;
+
+private:
+    void flush() const;
+    double scale(double q) const;
+    double inverseScale(double k) const;
+
+    double delta;
+    size_t bufferLimit;
+    double totalWeight = 0.0;
+    double minimum;
+    double maximum;
+    mutable std::vector<Centroid> merged;
+    mutable std::vector<Centroid> buffer;
+};
+
+#endif // QUANTILE_SKETCH_H
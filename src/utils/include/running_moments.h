@@ -0,0 +1,56 @@
+#ifndef RUNNING_MOMENTS_H
+#define RUNNING_MOMENTS_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief 多变量流式矩统计
+ *
+ * 每次加入一个d维样本，单次遍历同时维护：
+ * - 各维的均值、二~四阶中心矩（Welford / Terriberry 更新）和最值
+ * - 两两之间的协矩（co-moment），用于协方差和相关系数
+ *
+ * 两个累加器可以合并（Chan / Pébay 公式），因此可以对数据分块并行统计后再合并，
+ * 合并结果与顺序统计在数值上等价。偏度、峰度采用与 StatisticsUtils 相同的样本修正公式。
+ */
+class RunningMoments {
+public:
+    explicit RunningMoments(size_t dimensions = 1);
+
+    void add(const double* values);
+    void add(double value) { add(&value); }
+    void merge(const RunningMoments& other);
+    void reset();
+
+    size_t count() const { return n; }
+    size_t dimensions() const { return dims; }
+
+    double mean(size_t d = 0) const { return means[d]; }
+    double min(size_t d = 0) const { return minimum[d]; }
+    double max(size_t d = 0) const { return maximum[d]; }
+    double variance(size_t d = 0) const;          // 样本方差（n-1）
+    double stdDev(size_t d = 0) const;
+    double skewness(size_t d = 0) const;
+    double kurtosis(size_t d = 0) const;          // 超值峰度
+
+    double covariance(size_t i, size_t j) const;  // 样本协方差（n-1）
+    double correlation(size_t i, size_t j) const;
+
+private:
+    double& comoment(size_t i, size_t j);
+    double comoment(size_t i, size_t j) const;
+
+    size_t dims;
+    size_t n = 0;
+    std::vector<double> means;
+    std::vector<double> m2;
+    std::vector<double> m3;
+    std::vector<double> m4;
+    std::vector<double> minimum;
+    std::vector<double> maximum;
+    std::vector<double> comoments;   // 上三角（不含对角线）按行存放
+    std::vector<double> deltas;      // add()的临时缓冲
+};
+
+#endif // RUNNING_MOMENTS_H
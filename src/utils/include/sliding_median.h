@@ -0,0 +1,31 @@
+#ifndef SLIDING_MEDIAN_H
+#define SLIDING_MEDIAN_H
+
+#include <set>
+#include <cstddef>
+
+/**
+ * @brief 滑动窗口中位数
+ *
+ * 用两个有序集合维护窗口的下半部分和上半部分，插入、删除为 O(log w)，
+ * 查询中位数为 O(1)。适用于中值滤波和流式数据的窗口统计。
+ */
+class SlidingMedian {
+public:
+    void insert(double value);
+    bool erase(double value);
+    void clear();
+
+    double median() const;
+    size_t size() const { return lower.size() + upper.size(); }
+    bool empty() const { return lower.empty(); }
+
+private:
+    void rebalance();
+
+    // lower保存较小的一半（元素个数比upper多0或1个）
+    std::multiset<double> lower;
+    std::multiset<double> upper;
+};
+
+#endif // SLIDING_MEDIAN_H
@@ -12,6 +12,7 @@ public:
     static double variance(const std::vector<double>& data);
     static double variance(const std::vector<double>& data, double mean);
     static double median(const std::vector<double>& data);
+    static double percentile(const std::vector<double>& data, double p);  // p ∈ [0, 100]，线性插值
 
     static double skewness(const std::vector<double>& data, double mean, double stdDev);
     static double kurtosis(const std::vector<double>& data, double mean, double stdDev);
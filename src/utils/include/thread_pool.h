@@ -0,0 +1,105 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 取消令牌
+ *
+ * 复制后共享同一状态：界面线程持有一份并调用cancel()，计算任务在块边界检查isCancelled()。
+ */
+class CancellationToken {
+public:
+    CancellationToken() : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { state->store(true); }
+    void reset() const { state->store(false); }
+    bool isCancelled() const { return state->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+/**
+ * @brief 工作窃取线程池
+ *
+ * 每个工作线程有自己的任务队列：本线程从队尾取任务（后进先出，缓存友好），
+ * 空闲线程从其他队列的队首窃取。外部提交的任务轮流放入各队列，
+ * 工作线程内部提交的任务放入自己的队列。
+ *
+ * parallelFor() 的调用线程也参与执行数据块，因此在池内任务中嵌套调用不会死锁，
+ * 池中没有空闲线程时由调用线程独自完成全部数据块。
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 创建线程池，threadCount为0时使用硬件线程数
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 进程内共享的线程池（首次使用时创建）
+     */
+    static ThreadPool& shared();
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief 提交任务，不等待结果
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief 提交任务并通过future获取结果（异常也经由future传递）
+     */
+    template <typename Fn>
+    auto submit(Fn fn) -> std::future<decltype(fn())> {
+        using Result = decltype(fn());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+        std::future<Result> future = task->get_future();
+        post([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief 对 [0, chunkCount) 中每个块调用fn(chunk)，全部完成后返回
+     * @param maxParallelism 最多同时执行的线程数（含调用线程），0表示不限制
+     *
+     * 块按编号顺序领取；fn抛出的第一个异常在全部块结束后于调用线程重新抛出。
+     */
+    void parallelFor(size_t chunkCount, const std::function<void(size_t)>& fn,
+                     size_t maxParallelism = 0);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
+    bool stealTask(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<long> pendingTasks{0};   // 入队与计数不在同一把锁内，短暂为负是允许的
+    std::atomic<size_t> nextQueue{0};
+    std::atomic<bool> stopping{false};
+};
+
+#endif // THREAD_POOL_H
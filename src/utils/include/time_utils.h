@@ -17,6 +17,9 @@ public:
     static std::string formatTimestamp(int64_t timestamp, TimeZone tz = TimeZone::LOCAL);
 
     static std::string toISO8601(int64_t timestamp);
+    
+    // 解析 formatTimestamp() 的输出（末尾带Z按UTC解析），失败返回-1
+    static int64_t parseTimestamp(const std::string& text, TimeZone tz = TimeZone::LOCAL);
 };
 
 #endif
\ No newline at end of file
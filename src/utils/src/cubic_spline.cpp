@@ -0,0 +1,115 @@
+#include "../include/cubic_spline.h"
+#include <algorithm>
+
+bool CubicSpline::build(const std::vector<double>& x, const std::vector<double>& y) {
+    xs.clear();
+    a.clear();
+    b.clear();
+    c.clear();
+    d.clear();
+
+    const size_t n = x.size();
+    if (n < 2 || y.size() != n) {
+        return false;
+    }
+    for (size_t i = 1; i < n; ++i) {
+        if (!(x[i] > x[i - 1])) {
+            return false;
+        }
+    }
+
+    const size_t intervals = n - 1;
+    std::vector<double> h(intervals);
+    for (size_t i = 0; i < intervals; ++i) {
+        h[i] = x[i + 1] - x[i];
+    }
+
+    // 自然边界条件下求内部节点的二阶导数 m[1..n-2]（追赶法），m[0] = m[n-1] = 0
+    std::vector<double> m(n, 0.0);
+    if (n > 2) {
+        std::vector<double> diag(n - 2);
+        std::vector<double> rhs(n - 2);
+        for (size_t i = 1; i + 1 < n; ++i) {
+            diag[i - 1] = 2.0 * (h[i - 1] + h[i]);
+            rhs[i - 1] = 6.0 * ((y[i + 1] - y[i]) / h[i] - (y[i] - y[i - 1]) / h[i - 1]);
+        }
+
+        // 前向消元：次对角线元素为h[i]
+        for (size_t k = 1; k < n - 2; ++k) {
+            double w = h[k] / diag[k - 1];
+            diag[k] -= w * h[k];
+            rhs[k] -= w * rhs[k - 1];
+        }
+
+        // 回代
+        m[n - 2] = rhs[n - 3] / diag[n - 3];
+        for (size_t k = n - 3; k-- > 0;) {
+            m[k + 1] = (rhs[k] - h[k + 1] * m[k + 2]) / diag[k];
+        }
+    }
+
+    xs = x;
+    a.assign(y.begin(), y.begin() + intervals);
+    b.resize(intervals);
+    c.resize(intervals);
+    d.resize(intervals);
+    for (size_t i = 0; i < intervals; ++i) {
+        b[i] = (y[i + 1] - y[i]) / h[i] - h[i] * (2.0 * m[i] + m[i + 1]) / 6.0;
+        c[i] = m[i] / 2.0;
+        d[i] = (m[i + 1] - m[i]) / (6.0 * h[i]);
+    }
+
+    return true;
+}
+
+size_t CubicSpline::findInterval(double x) const {
+    if (xs.size() < 2) {
+        return 0;
+    }
+    // 第一个大于x的节点的前一个节点
+    auto it = std::upper_bound(xs.begin() + 1, xs.end() - 1, x);
+    return static_cast<size_t>(it - xs.begin()) - 1;
+}
+
+double CubicSpline::evaluateInterval(size_t i, double x) const {
+    double dx = x - xs[i];
+    return a[i] + dx * (b[i] + dx * (c[i] + dx * d[i]));
+}
+
+double CubicSpline::evaluate(double x) const {
+    if (!isValid()) {
+        return 0.0;
+    }
+    return evaluateInterval(findInterval(x), x);
+}
+
+void CubicSpline::evaluate(const double* x, size_t count, double* out) const {
+    if (!isValid()) {
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+
+    bool sorted = std::is_sorted(x, x + count);
+    if (!sorted) {
+        for (size_t j = 0; j < count; ++j) {
+            out[j] = evaluate(x[j]);
+        }
+        return;
+    }
+
+    // 递增查询：游标只向前移动
+    const size_t last = xs.size() - 2;
+    size_t i = count > 0 ? findInterval(x[0]) : 0;
+    for (size_t j = 0; j < count; ++j) {
+        while (i < last && x[j] >= xs[i + 1]) {
+            ++i;
+        }
+        out[j] = evaluateInterval(i, x[j]);
+    }
+}
+
+std::vector<double> CubicSpline::evaluate(const std::vector<double>& x) const {
+    std::vector<double> result(x.size());
+    evaluate(x.data(), x.size(), result.data());
+    return result;
+}
@@ -0,0 +1,281 @@
+#include "../include/fft_plan.h"
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr size_t MAX_CACHED_PLANS = 64;
+
+std::mutex& cacheMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::map<size_t, std::shared_ptr<const FFTPlan>>& planCache() {
+    static std::map<size_t, std::shared_ptr<const FFTPlan>> cache;
+    return cache;
+}
+
+// 每个线程独立的临时缓冲区，避免每次变换都分配内存
+std::vector<FFTPlan::Complex>& bluesteinScratch() {
+    thread_local std::vector<FFTPlan::Complex> buffer;
+    return buffer;
+}
+
+std::vector<FFTPlan::Complex>& realScratch() {
+    thread_local std::vector<FFTPlan::Complex> buffer;
+    return buffer;
+}
+
+// 手写复数乘法，避免std::complex乘法中的NaN/Inf检查开销
+inline FFTPlan::Complex mul(const FFTPlan::Complex& a, const FFTPlan::Complex& b) {
+    return FFTPlan::Complex(a.real() * b.real() - a.imag() * b.imag(),
+                            a.real() * b.imag() + a.imag() * b.real());
+}
+
+bool isPow2(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+} // namespace
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(size_t n) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex());
+        auto it = planCache().find(n);
+        if (it != planCache().end()) {
+            return it->second;
+        }
+    }
+
+    // 在锁外构建：Bluestein计划会递归获取子计划
+    auto plan = std::make_shared<const FFTPlan>(n);
+
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    auto& cache = planCache();
+    if (cache.size() >= MAX_CACHED_PLANS) {
+        cache.clear();
+    }
+    auto result = cache.emplace(n, plan);
+    return result.first->second;
+}
+
+void FFTPlan::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    planCache().clear();
+}
+
+FFTPlan::FFTPlan(size_t size)
+    : n(size), useRadix2(size <= 1 || isPow2(size)) {
+    if (n == 0) {
+        return;
+    }
+
+    if (useRadix2) {
+        if (n > 0xFFFFFFFFull) {
+            throw std::length_error("FFT size too large");
+        }
+
+        twiddles.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+            twiddles[k] = Complex(std::cos(angle), std::sin(angle));
+        }
+
+        int bits = 0;
+        while ((size_t(1) << bits) < n) ++bits;
+        bitReverse.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t r = 0;
+            for (int b = 0; b < bits; ++b) {
+                if (i & (size_t(1) << b)) {
+                    r |= uint32_t(1) << (bits - 1 - b);
+                }
+            }
+            bitReverse[i] = r;
+        }
+        return;
+    }
+
+    // Bluestein：X_k = w_k * Σ (x_j w_j) conj(w_{k-j})，w_k = exp(-iπk²/n)
+    size_t m = 1;
+    while (m < 2 * n - 1) m <<= 1;
+    convolutionPlan = get(m);
+
+    chirp.resize(n);
+    const uint64_t period = 2 * static_cast<uint64_t>(n);
+    for (size_t k = 0; k < n; ++k) {
+        // k²取模2n后再求角度，避免大k时的精度损失
+        uint64_t k2 = (static_cast<uint64_t>(k) * k) % period;
+        double angle = -PI * static_cast<double>(k2) / static_cast<double>(n);
+        chirp[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    chirpFilterSpectrum.assign(m, Complex(0.0, 0.0));
+    chirpFilterSpectrum[0] = std::conj(chirp[0]);
+    for (size_t k = 1; k < n; ++k) {
+        chirpFilterSpectrum[k] = std::conj(chirp[k]);
+        chirpFilterSpectrum[m - k] = std::conj(chirp[k]);
+    }
+    convolutionPlan->forward(chirpFilterSpectrum.data());
+}
+
+void FFTPlan::forward(Complex* data) const {
+    if (n <= 1) return;
+
+    if (useRadix2) {
+        transformRadix2(data, false);
+    } else {
+        transformBluestein(data, false);
+    }
+}
+
+void FFTPlan::inverse(Complex* data) const {
+    if (n <= 1) return;
+
+    if (useRadix2) {
+        transformRadix2(data, true);
+    } else {
+        transformBluestein(data, true);
+    }
+
+    const double scale = 1.0 / static_cast<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] *= scale;
+    }
+}
+
+void FFTPlan::forwardReal(const double* input, Complex* output) const {
+    if (n == 0) return;
+    if (n == 1) {
+        output[0] = Complex(input[0], 0.0);
+        return;
+    }
+
+    if (n % 2 != 0) {
+        // 奇数长度：按复数序列直接变换
+        auto& buffer = realScratch();
+        buffer.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = Complex(input[i], 0.0);
+        }
+        forward(buffer.data());
+        for (size_t k = 0; k <= n / 2; ++k) {
+            output[k] = buffer[k];
+        }
+        return;
+    }
+
+    prepareRealTransform();
+
+    // 偶数长度：将2h个实数打包为h个复数，做h点FFT后拆分
+    const size_t h = n / 2;
+    for (size_t i = 0; i < h; ++i) {
+        output[i] = Complex(input[2 * i], input[2 * i + 1]);
+    }
+    halfPlan->forward(output);
+
+    Complex z0 = output[0];
+    output[0] = Complex(z0.real() + z0.imag(), 0.0);
+    output[h] = Complex(z0.real() - z0.imag(), 0.0);
+
+    for (size_t k = 1; k <= h / 2; ++k) {
+        Complex zk = output[k];
+        Complex zm = output[h - k];
+
+        Complex even = 0.5 * (zk + std::conj(zm));
+        Complex diff = zk - std::conj(zm);
+        Complex odd(0.5 * diff.imag(), -0.5 * diff.real()); // -i * diff / 2
+
+        Complex t = mul(realTwiddles[k], odd);
+        output[k] = even + t;
+        output[h - k] = std::conj(even - t);
+    }
+}
+
+std::vector<FFTPlan::Complex> FFTPlan::forward(const std::vector<Complex>& data) const {
+    std::vector<Complex> result(data);
+    result.resize(n);
+    forward(result.data());
+    return result;
+}
+
+std::vector<FFTPlan::Complex> FFTPlan::forwardReal(const std::vector<double>& input) const {
+    std::vector<Complex> result(n / 2 + 1);
+    if (input.size() < n) {
+        std::vector<double> padded(input);
+        padded.resize(n, 0.0);
+        forwardReal(padded.data(), result.data());
+    } else {
+        forwardReal(input.data(), result.data());
+    }
+    return result;
+}
+
+void FFTPlan::transformRadix2(Complex* data, bool invert) const {
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = bitReverse[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+
+        for (size_t i = 0; i < n; i += len) {
+            Complex* lo = data + i;
+            Complex* hi = lo + half;
+            for (size_t k = 0; k < half; ++k) {
+                Complex w = twiddles[k * step];
+                if (invert) w = std::conj(w);
+
+                Complex v = mul(hi[k], w);
+                Complex u = lo[k];
+                lo[k] = u + v;
+                hi[k] = u - v;
+            }
+        }
+    }
+}
+
+void FFTPlan::transformBluestein(Complex* data, bool invert) const {
+    const size_t m = convolutionPlan->size();
+    auto& buffer = bluesteinScratch();
+    buffer.resize(m);
+
+    // 逆变换利用 IDFT(x) = conj(DFT(conj(x)))，缩放由inverse()完成
+    for (size_t k = 0; k < n; ++k) {
+        Complex x = invert ? std::conj(data[k]) : data[k];
+        buffer[k] = mul(x, chirp[k]);
+    }
+    std::fill(buffer.begin() + n, buffer.end(), Complex(0.0, 0.0));
+
+    convolutionPlan->forward(buffer.data());
+    for (size_t k = 0; k < m; ++k) {
+        buffer[k] = mul(buffer[k], chirpFilterSpectrum[k]);
+    }
+    convolutionPlan->inverse(buffer.data());
+
+    for (size_t k = 0; k < n; ++k) {
+        Complex y = mul(buffer[k], chirp[k]);
+        data[k] = invert ? std::conj(y) : y;
+    }
+}
+
+void FFTPlan::prepareRealTransform() const {
+    std::call_once(realOnce, [this]() {
+        const size_t h = n / 2;
+        halfPlan = get(h);
+
+        realTwiddles.resize(h / 2 + 1);
+        for (size_t k = 0; k <= h / 2; ++k) {
+            double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+            realTwiddles[k] = Complex(std::cos(angle), std::sin(angle));
+        }
+    });
+}
@@ -0,0 +1,177 @@
+#include "../include/format_utils.h"
+#include <charconv>
+#include <cstdio>
+
+namespace {
+
+// 向下取整的除法（负时间戳也落在正确的秒/分钟内）
+inline int64_t floorDiv(int64_t value, int64_t divisor) {
+    int64_t quotient = value / divisor;
+    return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+
+inline void appendTwoDigits(std::string& out, int value) {
+    out.push_back(static_cast<char>('0' + value / 10));
+    out.push_back(static_cast<char>('0' + value % 10));
+}
+
+std::string strftimeString(const std::string& format, const std::tm& tm) {
+    if (format.empty()) {
+        return std::string();
+    }
+    std::vector<char> buffer(64 + format.size() * 4);
+    for (int attempt = 0; attempt < 6; ++attempt) {
+        size_t length = std::strftime(buffer.data(), buffer.size(), format.c_str(), &tm);
+        if (length > 0) {
+            return std::string(buffer.data(), length);
+        }
+        buffer.resize(buffer.size() * 2);
+    }
+    return std::string();
+}
+
+} // namespace
+
+void FormatUtils::appendFixed(std::string& out, double value, int decimalPlaces) {
+    if (decimalPlaces < 0) {
+        decimalPlaces = 0;
+    }
+    char buffer[128];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, decimalPlaces);
+    if (result.ec == std::errc()) {
+        out.append(buffer, result.ptr);
+        return;
+    }
+
+    // 量级很大的值定点表示超出栈缓冲区
+    int length = std::snprintf(nullptr, 0, "%.*f", decimalPlaces, value);
+    if (length > 0) {
+        size_t start = out.size();
+        out.resize(start + static_cast<size_t>(length) + 1);
+        std::snprintf(&out[start], static_cast<size_t>(length) + 1, "%.*f", decimalPlaces, value);
+        out.resize(start + static_cast<size_t>(length));
+    }
+}
+
+void FormatUtils::appendShortest(std::string& out, double value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void FormatUtils::appendInteger(std::string& out, int64_t value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+std::string FormatUtils::formatFixed(double value, int decimalPlaces) {
+    std::string out;
+    appendFixed(out, value, decimalPlaces);
+    return out;
+}
+
+TimestampFormatter::TimestampFormatter(const std::string& format, TimeUtils::TimeZone timeZone,
+                                       bool milliseconds, const std::string& suffix)
+    : timeZone(timeZone), milliseconds(milliseconds), suffix(suffix) {
+    // %T 展开为 %H:%M:%S，使秒字段可以单独渲染
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '%' && i + 1 < format.size()) {
+            if (format[i + 1] == 'T') {
+                pattern += "%H:%M:%S";
+            } else {
+                pattern += format.substr(i, 2);
+            }
+            ++i;
+        } else {
+            pattern += format[i];
+        }
+    }
+
+    std::string piece;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] != '%' || i + 1 >= pattern.size()) {
+            piece += pattern[i];
+            continue;
+        }
+        char conversion = pattern[i + 1];
+        if (conversion == 'S') {
+            pieces.push_back(piece);
+            piece.clear();
+        } else {
+            if (conversion == 's' || conversion == 'c' || conversion == 'X' || conversion == 'r' ||
+                conversion == '+' || conversion == 'E' || conversion == 'O') {
+                cacheable = false;
+            }
+            piece += pattern.substr(i, 2);
+        }
+        ++i;
+    }
+    pieces.push_back(piece);
+}
+
+std::tm TimestampFormatter::toTm(int64_t seconds) const {
+    std::time_t time = static_cast<std::time_t>(seconds);
+    std::tm tm{};
+    if (timeZone == TimeUtils::TimeZone::LOCAL) {
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+    } else {
+#ifdef _WIN32
+        gmtime_s(&tm, &time);
+#else
+        gmtime_r(&time, &tm);
+#endif
+    }
+    return tm;
+}
+
+void TimestampFormatter::renderMinute(int64_t minute) {
+    std::tm tm = toTm(minute * 60);
+    rendered.resize(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        rendered[i] = strftimeString(pieces[i], tm);
+    }
+    cachedMinute = minute;
+    hasCache = true;
+}
+
+void TimestampFormatter::renderFull(std::string& out, int64_t seconds) const {
+    out += strftimeString(pattern, toTm(seconds));
+}
+
+void TimestampFormatter::append(std::string& out, int64_t timestampMs) {
+    const int64_t seconds = floorDiv(timestampMs, 1000);
+
+    if (cacheable) {
+        const int64_t minute = floorDiv(seconds, 60);
+        if (!hasCache || minute != cachedMinute) {
+            renderMinute(minute);
+        }
+        const int second = static_cast<int>(seconds - minute * 60);
+        out += rendered[0];
+        for (size_t i = 1; i < rendered.size(); ++i) {
+            appendTwoDigits(out, second);
+            out += rendered[i];
+        }
+    } else {
+        renderFull(out, seconds);
+    }
+
+    if (milliseconds) {
+        int millis = static_cast<int>(timestampMs - seconds * 1000);
+        out.push_back('.');
+        out.push_back(static_cast<char>('0' + millis / 100));
+        appendTwoDigits(out, millis % 100);
+    }
+    out += suffix;
+}
+
+std::string TimestampFormatter::format(int64_t timestampMs) {
+    std::string out;
+    append(out, timestampMs);
+    return out;
+}
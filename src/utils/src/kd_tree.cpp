@@ -0,0 +1,86 @@
+#include "../include/kd_tree.h"
+#include <algorithm>
+#include <numeric>
+
+void KdTree2D::build(const std::vector<double>& x, const std::vector<double>& y) {
+    size_t n = std::min(x.size(), y.size());
+    px.assign(x.begin(), x.begin() + n);
+    py.assign(y.begin(), y.begin() + n);
+    index.resize(n);
+    std::iota(index.begin(), index.end(), 0);
+    buildRange(0, n, 0);
+}
+
+void KdTree2D::buildRange(size_t begin, size_t end, int depth) {
+    if (end - begin <= 1) {
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    const std::vector<double>& axis = (depth % 2 == 0) ? px : py;
+    std::nth_element(index.begin() + begin, index.begin() + mid, index.begin() + end,
+                     [&](size_t l, size_t r) { return axis[l] < axis[r]; });
+
+    buildRange(begin, mid, depth + 1);
+    buildRange(mid + 1, end, depth + 1);
+}
+
+void KdTree2D::nearest(double qx, double qy, size_t k,
+                       std::vector<size_t>& indices, std::vector<double>& distancesSq) const {
+    indices.clear();
+    distancesSq.clear();
+    if (index.empty() || k == 0) {
+        return;
+    }
+
+    // 最大堆保存当前最近的k个点
+    std::vector<std::pair<double, size_t>> heap;
+    heap.reserve(k + 1);
+    search(0, index.size(), 0, qx, qy, k, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto& entry : heap) {
+        distancesSq.push_back(entry.first);
+        indices.push_back(entry.second);
+    }
+}
+
+void KdTree2D::search(size_t begin, size_t end, int depth, double qx, double qy, size_t k,
+                      std::vector<std::pair<double, size_t>>& heap) const {
+    if (begin >= end) {
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    size_t point = index[mid];
+
+    double dx = px[point] - qx;
+    double dy = py[point] - qy;
+    double distSq = dx * dx + dy * dy;
+    if (heap.size() < k) {
+        heap.emplace_back(distSq, point);
+        std::push_heap(heap.begin(), heap.end());
+    } else if (distSq < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {distSq, point};
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    double diff = (depth % 2 == 0) ? qx - px[point] : qy - py[point];
+    bool leftFirst = diff < 0.0;
+
+    // 先搜索查询点所在一侧，另一侧仅在分割面距离小于当前第k近距离时搜索
+    if (leftFirst) {
+        search(begin, mid, depth + 1, qx, qy, k, heap);
+    } else {
+        search(mid + 1, end, depth + 1, qx, qy, k, heap);
+    }
+
+    if (heap.size() < k || diff * diff < heap.front().first) {
+        if (leftFirst) {
+            search(mid + 1, end, depth + 1, qx, qy, k, heap);
+        } else {
+            search(begin, mid, depth + 1, qx, qy, k, heap);
+        }
+    }
+}
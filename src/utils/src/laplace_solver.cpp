@@ -0,0 +1,226 @@
+#include "../include/laplace_solver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 镜像边界：越界的邻点取对称位置的节点
+inline size_t mirrorLow(size_t i) { return i == 0 ? 1 : i - 1; }
+inline size_t mirrorHigh(size_t i, size_t n) { return i == n ? n - 1 : i + 1; }
+
+constexpr size_t kMinCoarseCells = 4;
+constexpr int kCoarsestSweeps = 200;
+
+} // namespace
+
+LaplaceSolver2D::LaplaceSolver2D(size_t nx, size_t ny) {
+    nx = std::max<size_t>(nx, 2);
+    ny = std::max<size_t>(ny, 2);
+
+    Level fine;
+    fine.nx = nx;
+    fine.ny = ny;
+    levels.push_back(fine);
+    while (nx % 2 == 0 && ny % 2 == 0 && nx / 2 >= kMinCoarseCells && ny / 2 >= kMinCoarseCells) {
+        nx /= 2;
+        ny /= 2;
+        Level coarse;
+        coarse.nx = nx;
+        coarse.ny = ny;
+        levels.push_back(coarse);
+    }
+
+    for (auto& level : levels) {
+        size_t nodes = (level.nx + 1) * (level.ny + 1);
+        level.u.assign(nodes, 0.0);
+        level.f.assign(nodes, 0.0);
+        level.fixed.assign(nodes, 0);
+    }
+    labels.assign(levels[0].u.size(), 0);
+}
+
+void LaplaceSolver2D::setFixed(size_t i, size_t j, double value, int label) {
+    Level& fine = levels[0];
+    if (i > fine.nx || j > fine.ny) {
+        return;
+    }
+    size_t p = fine.index(i, j);
+    fine.fixed[p] = 1;
+    fine.u[p] = value;
+    labels[p] = static_cast<int8_t>(label);
+    masksBuilt = false;
+}
+
+bool LaplaceSolver2D::isFixed(size_t i, size_t j) const {
+    return levels[0].fixed[levels[0].index(i, j)] != 0;
+}
+
+int LaplaceSolver2D::labelAt(size_t i, size_t j) const {
+    return labels[levels[0].index(i, j)];
+}
+
+double LaplaceSolver2D::value(size_t i, size_t j) const {
+    return levels[0].u[levels[0].index(i, j)];
+}
+
+void LaplaceSolver2D::buildCoarseMasks() {
+    // 粗节点对应的细节点或其四个相邻细节点中有固定节点时，粗节点固定
+    for (size_t l = 1; l < levels.size(); ++l) {
+        const Level& fine = levels[l - 1];
+        Level& coarse = levels[l];
+        for (size_t J = 0; J <= coarse.ny; ++J) {
+            for (size_t I = 0; I <= coarse.nx; ++I) {
+                size_t i = 2 * I;
+                size_t j = 2 * J;
+                bool fixed = fine.fixed[fine.index(i, j)] ||
+                             fine.fixed[fine.index(mirrorLow(i), j)] ||
+                             fine.fixed[fine.index(mirrorHigh(i, fine.nx), j)] ||
+                             fine.fixed[fine.index(i, mirrorLow(j))] ||
+                             fine.fixed[fine.index(i, mirrorHigh(j, fine.ny))];
+                coarse.fixed[coarse.index(I, J)] = fixed ? 1 : 0;
+            }
+        }
+    }
+    masksBuilt = true;
+}
+
+void LaplaceSolver2D::smooth(Level& level, int sweeps) const {
+    const size_t nx = level.nx;
+    const size_t ny = level.ny;
+    double* u = level.u.data();
+    const double* f = level.f.data();
+    const uint8_t* fixed = level.fixed.data();
+    const size_t stride = nx + 1;
+
+    for (int sweep = 0; sweep < sweeps; ++sweep) {
+        for (size_t colour = 0; colour < 2; ++colour) {
+            for (size_t j = 0; j <= ny; ++j) {
+                const size_t down = mirrorLow(j) * stride;
+                const size_t up = mirrorHigh(j, ny) * stride;
+                const size_t row = j * stride;
+                for (size_t i = (j + colour) % 2; i <= nx; i += 2) {
+                    size_t p = row + i;
+                    if (fixed[p]) continue;
+                    double sum = u[row + mirrorLow(i)] + u[row + mirrorHigh(i, nx)] + u[down + i] + u[up + i];
+                    u[p] = 0.25 * (f[p] + sum);
+                }
+            }
+        }
+    }
+}
+
+double LaplaceSolver2D::residual(const Level& level, std::vector<double>& r) const {
+    const size_t nx = level.nx;
+    const size_t ny = level.ny;
+    const size_t stride = nx + 1;
+    const double* u = level.u.data();
+    r.assign(level.u.size(), 0.0);
+
+    double maxResidual = 0.0;
+    for (size_t j = 0; j <= ny; ++j) {
+        const size_t down = mirrorLow(j) * stride;
+        const size_t up = mirrorHigh(j, ny) * stride;
+        const size_t row = j * stride;
+        for (size_t i = 0; i <= nx; ++i) {
+            size_t p = row + i;
+            if (level.fixed[p]) continue;
+            double au = 4.0 * u[p] - u[row + mirrorLow(i)] - u[row + mirrorHigh(i, nx)] - u[down + i] - u[up + i];
+            r[p] = level.f[p] - au;
+            maxResidual = std::max(maxResidual, std::abs(r[p]));
+        }
+    }
+    return maxResidual;
+}
+
+void LaplaceSolver2D::restrictResidual(const Level& fine, const std::vector<double>& r, Level& coarse) const {
+    // 全加权；粗网格方程不含1/h²，间距加倍需乘以4
+    for (size_t J = 0; J <= coarse.ny; ++J) {
+        for (size_t I = 0; I <= coarse.nx; ++I) {
+            size_t c = coarse.index(I, J);
+            coarse.u[c] = 0.0;
+            if (coarse.fixed[c]) {
+                coarse.f[c] = 0.0;
+                continue;
+            }
+            size_t i = 2 * I;
+            size_t j = 2 * J;
+            size_t il = mirrorLow(i), ih = mirrorHigh(i, fine.nx);
+            size_t jl = mirrorLow(j), jh = mirrorHigh(j, fine.ny);
+            double centre = r[fine.index(i, j)];
+            double edges = r[fine.index(il, j)] + r[fine.index(ih, j)] + r[fine.index(i, jl)] + r[fine.index(i, jh)];
+            double corners = r[fine.index(il, jl)] + r[fine.index(ih, jl)] + r[fine.index(il, jh)] + r[fine.index(ih, jh)];
+            coarse.f[c] = 4.0 * (0.25 * centre + 0.125 * edges + 0.0625 * corners);
+        }
+    }
+}
+
+void LaplaceSolver2D::prolongAndCorrect(const Level& coarse, Level& fine) const {
+    for (size_t j = 0; j <= fine.ny; ++j) {
+        size_t J0 = j / 2;
+        size_t J1 = std::min(coarse.ny, (j + 1) / 2);
+        for (size_t i = 0; i <= fine.nx; ++i) {
+            size_t p = fine.index(i, j);
+            if (fine.fixed[p]) continue;
+            size_t I0 = i / 2;
+            size_t I1 = std::min(coarse.nx, (i + 1) / 2);
+            double e = 0.25 * (coarse.u[coarse.index(I0, J0)] + coarse.u[coarse.index(I1, J0)] +
+                               coarse.u[coarse.index(I0, J1)] + coarse.u[coarse.index(I1, J1)]);
+            fine.u[p] += e;
+        }
+    }
+}
+
+void LaplaceSolver2D::vCycle(size_t depth) {
+    Level& level = levels[depth];
+    if (depth + 1 == levels.size()) {
+        smooth(level, kCoarsestSweeps);
+        return;
+    }
+
+    smooth(level, 2);
+    std::vector<double> r;
+    residual(level, r);
+    restrictResidual(level, r, levels[depth + 1]);
+    vCycle(depth + 1);
+    prolongAndCorrect(levels[depth + 1], level);
+    smooth(level, 2);
+}
+
+int LaplaceSolver2D::solve(double tolerance, int maxCycles) {
+    if (!masksBuilt) {
+        buildCoarseMasks();
+    }
+
+    std::vector<double> r;
+    double initial = residual(levels[0], r);
+    if (initial == 0.0) {
+        return 0;
+    }
+
+    for (int cycle = 1; cycle <= maxCycles; ++cycle) {
+        vCycle(0);
+        if (residual(levels[0], r) <= tolerance * initial) {
+            return cycle;
+        }
+    }
+    return -1;
+}
+
+double LaplaceSolver2D::charge(int label) const {
+    const Level& fine = levels[0];
+    const size_t nx = fine.nx;
+    const size_t ny = fine.ny;
+    const double* u = fine.u.data();
+
+    // 固定节点上离散拉普拉斯算子的值即该节点的电荷（单位长度，以ε为单位）
+    double total = 0.0;
+    for (size_t j = 0; j <= ny; ++j) {
+        for (size_t i = 0; i <= nx; ++i) {
+            size_t p = fine.index(i, j);
+            if (!fine.fixed[p] || labels[p] != label) continue;
+            total += 4.0 * u[p] - u[fine.index(mirrorLow(i), j)] - u[fine.index(mirrorHigh(i, nx), j)] -
+                     u[fine.index(i, mirrorLow(j))] - u[fine.index(i, mirrorHigh(j, ny))];
+        }
+    }
+    return total;
+}
@@ -0,0 +1,346 @@
+#include "../include/least_squares.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// QR对角元相对最大对角元低于该比例时视为秩亏
+constexpr double kRankTolerance = 1e-10;
+constexpr int kMaxJacobiSweeps = 60;
+
+} // namespace
+
+LeastSquaresSolver::LeastSquaresSolver(std::vector<double> a, size_t rows, size_t cols)
+    : m(rows), n(cols), matrix(std::move(a)) {
+    matrix.resize(m * n, 0.0);
+
+    // 列缩放：每列归一化为单位范数
+    columnScale.assign(n, 1.0);
+    for (size_t j = 0; j < n; ++j) {
+        double* col = matrix.data() + j * m;
+        double norm = 0.0;
+        for (size_t i = 0; i < m; ++i) {
+            norm += col[i] * col[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm > 0.0) {
+            columnScale[j] = norm;
+            for (size_t i = 0; i < m; ++i) {
+                col[i] /= norm;
+            }
+        }
+    }
+
+    if (m >= n) {
+        std::vector<double> scaled = matrix;
+        factorQR();
+        if (effectiveRank < n) {
+            matrix = std::move(scaled);
+            factorSVD();
+        }
+    } else {
+        factorSVD();
+    }
+}
+
+void LeastSquaresSolver::factorQR() {
+    useSVD = false;
+    rDiag.assign(n, 0.0);
+
+    for (size_t k = 0; k < n; ++k) {
+        double* v = matrix.data() + k * m;
+
+        double norm = 0.0;
+        for (size_t i = k; i < m; ++i) {
+            norm += v[i] * v[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0.0) {
+            // 零列：对应的Householder变换取单位阵
+            std::fill(v + k, v + m, 0.0);
+            continue;
+        }
+
+        double alpha = v[k] > 0.0 ? -norm : norm;
+        v[k] -= alpha;
+
+        double vNorm = 0.0;
+        for (size_t i = k; i < m; ++i) {
+            vNorm += v[i] * v[i];
+        }
+        vNorm = std::sqrt(vNorm);
+        for (size_t i = k; i < m; ++i) {
+            v[i] /= vNorm;
+        }
+        rDiag[k] = alpha;
+
+        // 对后续列施加 H = I - 2vv^T
+        for (size_t j = k + 1; j < n; ++j) {
+            double* col = matrix.data() + j * m;
+            double dot = 0.0;
+            for (size_t i = k; i < m; ++i) {
+                dot += v[i] * col[i];
+            }
+            dot *= 2.0;
+            for (size_t i = k; i < m; ++i) {
+                col[i] -= dot * v[i];
+            }
+        }
+    }
+
+    double maxDiag = 0.0;
+    for (double d : rDiag) {
+        maxDiag = std::max(maxDiag, std::abs(d));
+    }
+    effectiveRank = 0;
+    for (double d : rDiag) {
+        if (std::abs(d) > kRankTolerance * maxDiag) {
+            ++effectiveRank;
+        }
+    }
+}
+
+void LeastSquaresSolver::factorSVD() {
+    useSVD = true;
+
+    // 单边Jacobi：对列做正交旋转直到两两正交，matrix收敛为 U·diag(s)
+    rightVectors.assign(n * n, 0.0);
+    for (size_t j = 0; j < n; ++j) {
+        rightVectors[j * n + j] = 1.0;
+    }
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    for (int sweep = 0; sweep < kMaxJacobiSweeps; ++sweep) {
+        bool rotated = false;
+        for (size_t p = 0; p + 1 < n; ++p) {
+            for (size_t q = p + 1; q < n; ++q) {
+                double* up = matrix.data() + p * m;
+                double* uq = matrix.data() + q * m;
+
+                double alpha = 0.0, beta = 0.0, gamma = 0.0;
+                for (size_t i = 0; i < m; ++i) {
+                    alpha += up[i] * up[i];
+                    beta += uq[i] * uq[i];
+                    gamma += up[i] * uq[i];
+                }
+                if (std::abs(gamma) <= eps * std::sqrt(alpha * beta) || gamma == 0.0) {
+                    continue;
+                }
+                rotated = true;
+
+                double zeta = (beta - alpha) / (2.0 * gamma);
+                double t = (zeta >= 0.0 ? 1.0 : -1.0) / (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                double c = 1.0 / std::sqrt(1.0 + t * t);
+                double s = c * t;
+
+                for (size_t i = 0; i < m; ++i) {
+                    double a = up[i];
+                    double b = uq[i];
+                    up[i] = c * a - s * b;
+                    uq[i] = s * a + c * b;
+                }
+
+                double* vp = rightVectors.data() + p * n;
+                double* vq = rightVectors.data() + q * n;
+                for (size_t i = 0; i < n; ++i) {
+                    double a = vp[i];
+                    double b = vq[i];
+                    vp[i] = c * a - s * b;
+                    vq[i] = s * a + c * b;
+                }
+            }
+        }
+        if (!rotated) break;
+    }
+
+    singular.assign(n, 0.0);
+    double maxSingular = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        double* u = matrix.data() + j * m;
+        double norm = 0.0;
+        for (size_t i = 0; i < m; ++i) {
+            norm += u[i] * u[i];
+        }
+        norm = std::sqrt(norm);
+        singular[j] = norm;
+        if (norm > 0.0) {
+            for (size_t i = 0; i < m; ++i) {
+                u[i] /= norm;
+            }
+        }
+        maxSingular = std::max(maxSingular, norm);
+    }
+
+    double cutoff = std::max(m, n) * eps * maxSingular;
+    effectiveRank = 0;
+    for (size_t j = 0; j < n; ++j) {
+        if (singular[j] > cutoff) {
+            ++effectiveRank;
+        } else {
+            singular[j] = 0.0;
+        }
+    }
+}
+
+void LeastSquaresSolver::solve(const double* b, double* x) const {
+    if (useSVD) {
+        // x = V · diag(1/s) · U^T · b
+        std::fill(x, x + n, 0.0);
+        for (size_t j = 0; j < n; ++j) {
+            if (singular[j] == 0.0) continue;
+            const double* u = matrix.data() + j * m;
+            double dot = 0.0;
+            for (size_t i = 0; i < m; ++i) {
+                dot += u[i] * b[i];
+            }
+            dot /= singular[j];
+            const double* v = rightVectors.data() + j * n;
+            for (size_t i = 0; i < n; ++i) {
+                x[i] += dot * v[i];
+            }
+        }
+    } else {
+        // y = Q^T · b
+        std::vector<double> y(b, b + m);
+        for (size_t k = 0; k < n; ++k) {
+            const double* v = matrix.data() + k * m;
+            double dot = 0.0;
+            for (size_t i = k; i < m; ++i) {
+                dot += v[i] * y[i];
+            }
+            dot *= 2.0;
+            for (size_t i = k; i < m; ++i) {
+                y[i] -= dot * v[i];
+            }
+        }
+
+        // 回代求解 R·x = y
+        for (size_t k = n; k-- > 0;) {
+            double sum = y[k];
+            for (size_t j = k + 1; j < n; ++j) {
+                sum -= matrix[j * m + k] * x[j];
+            }
+            x[k] = sum / rDiag[k];
+        }
+    }
+
+    for (size_t j = 0; j < n; ++j) {
+        x[j] /= columnScale[j];
+    }
+}
+
+std::vector<double> LeastSquaresSolver::solve(const std::vector<double>& b) const {
+    std::vector<double> x(n, 0.0);
+    if (b.size() >= m) {
+        solve(b.data(), x.data());
+    }
+    return x;
+}
+
+bool LeastSquaresSolver::fitPolynomial(const double* x, const double* y, const double* weights,
+                                       size_t count, int degree, std::vector<double>& coefficients) {
+    if (degree < 0 || count < static_cast<size_t>(degree) + 1) {
+        return false;
+    }
+
+    std::vector<double> sqrtWeights;
+    std::vector<double> rhs(y, y + count);
+    if (weights) {
+        sqrtWeights.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (!(weights[i] >= 0.0)) {
+                return false;
+            }
+            sqrtWeights[i] = std::sqrt(weights[i]);
+            rhs[i] *= sqrtWeights[i];
+        }
+    }
+
+    double center, scale;
+    polynomialRange(x, count, center, scale);
+
+    LeastSquaresSolver solver(vandermonde(x, weights ? sqrtWeights.data() : nullptr, count,
+                                          degree, center, scale),
+                              count, degree + 1);
+    coefficients = toPowerBasis(solver.solve(rhs), center, scale);
+    return true;
+}
+
+bool LeastSquaresSolver::fitPolynomials(const std::vector<double>& x,
+                                        const std::vector<std::vector<double>>& ySeries,
+                                        int degree,
+                                        std::vector<std::vector<double>>& coefficients) {
+    coefficients.clear();
+    if (degree < 0 || x.size() < static_cast<size_t>(degree) + 1) {
+        return false;
+    }
+    for (const auto& y : ySeries) {
+        if (y.size() != x.size()) {
+            return false;
+        }
+    }
+
+    double center, scale;
+    polynomialRange(x.data(), x.size(), center, scale);
+
+    LeastSquaresSolver solver(vandermonde(x.data(), nullptr, x.size(), degree, center, scale),
+                              x.size(), degree + 1);
+
+    coefficients.reserve(ySeries.size());
+    std::vector<double> scaled(degree + 1);
+    for (const auto& y : ySeries) {
+        solver.solve(y.data(), scaled.data());
+        coefficients.push_back(toPowerBasis(scaled, center, scale));
+    }
+    return true;
+}
+
+std::vector<double> LeastSquaresSolver::vandermonde(const double* x, const double* sqrtWeights,
+                                                    size_t count, int degree,
+                                                    double center, double scale) {
+    size_t cols = static_cast<size_t>(degree) + 1;
+    std::vector<double> a(count * cols);
+
+    for (size_t i = 0; i < count; ++i) {
+        double t = (x[i] - center) / scale;
+        double p = sqrtWeights ? sqrtWeights[i] : 1.0;
+        for (size_t j = 0; j < cols; ++j) {
+            a[j * count + i] = p;
+            p *= t;
+        }
+    }
+    return a;
+}
+
+void LeastSquaresSolver::polynomialRange(const double* x, size_t count, double& center, double& scale) {
+    center = 0.0;
+    scale = 1.0;
+    if (count == 0) return;
+
+    auto range = std::minmax_element(x, x + count);
+    center = (*range.first + *range.second) / 2.0;
+    double half = (*range.second - *range.first) / 2.0;
+    if (half > 0.0) {
+        scale = half;
+    }
+}
+
+std::vector<double> LeastSquaresSolver::toPowerBasis(const std::vector<double>& scaled,
+                                                     double center, double scale) {
+    // Horner展开：p(x) = sum a_k · ((x - center) / scale)^k
+    std::vector<double> result(scaled.size(), 0.0);
+    if (scaled.empty()) return result;
+
+    result[0] = scaled.back();
+    size_t length = 1;
+    for (size_t k = scaled.size() - 1; k-- > 0;) {
+        // result *= (x / scale - center / scale)
+        for (size_t j = length; j > 0; --j) {
+            result[j] = result[j - 1] / scale - result[j] * center / scale;
+        }
+        result[0] = -result[0] * center / scale + scaled[k];
+        ++length;
+    }
+    return result;
+}
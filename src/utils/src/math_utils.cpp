@@ -22,8 +22,16 @@ double MathUtils::exponentialSmooth(double currentValue, double newValue, double
 }
 
 double MathUtils::medianFilter(std::vector<double> window) {
-    // 复用StatisticsUtils::median
-    return StatisticsUtils::median(window);
+    // 参数按值传入，直接在其上做nth_element，避免再复制一次
+    if (window.empty()) return 0.0;
+    size_t n = window.size();
+    auto mid = window.begin() + n / 2;
+    std::nth_element(window.begin(), mid, window.end());
+    if (n % 2 == 0) {
+        double lower = *std::max_element(window.begin(), mid);
+        return (lower + *mid) / 2.0;
+    }
+    return *mid;
 }
 
 double MathUtils::mapRange(double x, double in_min, double in_max, 
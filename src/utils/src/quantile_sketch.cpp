@@ -0,0 +1,180 @@
+#include "../include/quantile_sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double kPi = 3.14159265358979323846;
+}
+
+QuantileSketch::QuantileSketch(double compression)
+    : delta(std::max(compression, 10.0)),
+      bufferLimit(static_cast<size_t>(delta) * 5) {
+    reset();
+}
+
+void QuantileSketch::reset() {
+    totalWeight = 0.0;
+    minimum = std::numeric_limits<double>::max();
+    maximum = std::numeric_limits<double>::lowest();
+    merged.clear();
+    buffer.clear();
+    buffer.reserve(bufferLimit);
+}
+
+void QuantileSketch::add(double value, double weight) {
+    if (!std::isfinite(value) || !(weight > 0.0)) {
+        return;
+    }
+
+    buffer.push_back({value, weight});
+    totalWeight += weight;
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+
+    if (buffer.size() >= bufferLimit) {
+        flush();
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.empty()) {
+        return;
+    }
+
+    const std::vector<Centroid>& incoming = other.centroids();
+    buffer.insert(buffer.end(), incoming.begin(), incoming.end());
+    totalWeight += other.totalWeight;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+    flush();
+}
+
+// k1 尺度函数：k(q) = δ/(2π)·asin(2q-1)，每个质心覆盖的k区间不超过1
+double QuantileSketch::scale(double q) const {
+    return delta / (2.0 * kPi) * std::asin(2.0 * q - 1.0);
+}
+
+double QuantileSketch::inverseScale(double k) const {
+    if (k >= delta / 4.0) {
+        return 1.0;
+    }
+    return (std::sin(k * 2.0 * kPi / delta) + 1.0) / 2.0;
+}
+
+void QuantileSketch::flush() const {
+    if (buffer.empty()) {
+        return;
+    }
+
+    buffer.insert(buffer.end(), merged.begin(), merged.end());
+    std::sort(buffer.begin(), buffer.end(),
+              [](const Centroid& l, const Centroid& r) { return l.mean < r.mean; });
+
+    merged.clear();
+    Centroid current = buffer.front();
+    double weightSoFar = 0.0;
+    double qLimit = inverseScale(scale(0.0) + 1.0);
+
+    for (size_t i = 1; i < buffer.size(); ++i) {
+        const Centroid& next = buffer[i];
+        double projected = weightSoFar + current.weight + next.weight;
+        if (projected <= qLimit * totalWeight) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            merged.push_back(current);
+            qLimit = inverseScale(scale(weightSoFar / totalWeight) + 1.0);
+            current = next;
+        }
+    }
+    merged.push_back(current);
+    buffer.clear();
+}
+
+const std::vector<QuantileSketch::Centroid>& QuantileSketch::centroids() const {
+    flush();
+    return merged;
+}
+
+double QuantileSketch::quantile(double q) const {
+    flush();
+    if (merged.empty()) {
+        return 0.0;
+    }
+    if (q <= 0.0) {
+        return minimum;
+    }
+    if (q >= 1.0) {
+        return maximum;
+    }
+    if (merged.size() == 1) {
+        return merged.front().mean;
+    }
+
+    // 质心i的中心位于累计权重 cum_i + w_i/2，在相邻中心之间线性插值，
+    // 首尾分别与最小值、最大值插值
+    const double index = q * totalWeight;
+    const Centroid& first = merged.front();
+    if (index < first.weight / 2.0) {
+        return minimum + (first.mean - minimum) * index / (first.weight / 2.0);
+    }
+
+    double center = first.weight / 2.0;
+    double cumulative = first.weight;
+    for (size_t i = 1; i < merged.size(); ++i) {
+        double nextCenter = cumulative + merged[i].weight / 2.0;
+        if (index < nextCenter) {
+            double t = (index - center) / (nextCenter - center);
+            return merged[i - 1].mean + t * (merged[i].mean - merged[i - 1].mean);
+        }
+        center = nextCenter;
+        cumulative += merged[i].weight;
+    }
+
+    const Centroid& last = merged.back();
+    double tail = totalWeight - center;
+    if (tail <= 0.0) {
+        return last.mean;
+    }
+    return last.mean + (maximum - last.mean) * (index - center) / tail;
+}
+
+double QuantileSketch::cdf(double value) const {
+    flush();
+    if (merged.empty()) {
+        return 0.0;
+    }
+    if (value < minimum) {
+        return 0.0;
+    }
+    if (value >= maximum) {
+        return 1.0;
+    }
+
+    const Centroid& first = merged.front();
+    if (value < first.mean) {
+        double span = first.mean - minimum;
+        double w = span > 0.0 ? (value - minimum) / span : 1.0;
+        return w * first.weight / 2.0 / totalWeight;
+    }
+
+    double center = first.weight / 2.0;
+    double cumulative = first.weight;
+    for (size_t i = 1; i < merged.size(); ++i) {
+        double nextCenter = cumulative + merged[i].weight / 2.0;
+        if (value < merged[i].mean) {
+            double span = merged[i].mean - merged[i - 1].mean;
+            double t = span > 0.0 ? (value - merged[i - 1].mean) / span : 1.0;
+            return (center + t * (nextCenter - center)) / totalWeight;
+        }
+        center = nextCenter;
+        cumulative += merged[i].weight;
+    }
+
+    const Centroid& last = merged.back();
+    double span = maximum - last.mean;
+    double t = span > 0.0 ? (value - last.mean) / span : 1.0;
+    return (center + t * (totalWeight - center)) / totalWeight;
+}
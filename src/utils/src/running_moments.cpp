@@ -0,0 +1,156 @@
+#include "../include/running_moments.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+RunningMoments::RunningMoments(size_t dimensions)
+    : dims(dimensions) {
+    reset();
+}
+
+void RunningMoments::reset() {
+    n = 0;
+    means.assign(dims, 0.0);
+    m2.assign(dims, 0.0);
+    m3.assign(dims, 0.0);
+    m4.assign(dims, 0.0);
+    minimum.assign(dims, std::numeric_limits<double>::max());
+    maximum.assign(dims, std::numeric_limits<double>::lowest());
+    comoments.assign(dims > 1 ? dims * (dims - 1) / 2 : 0, 0.0);
+    deltas.assign(dims, 0.0);
+}
+
+double& RunningMoments::comoment(size_t i, size_t j) {
+    if (i > j) std::swap(i, j);
+    // 第i行之前共有 i*dims - i*(i+1)/2 个元素
+    return comoments[i * dims - i * (i + 1) / 2 + (j - i - 1)];
+}
+
+double RunningMoments::comoment(size_t i, size_t j) const {
+    return const_cast<RunningMoments*>(this)->comoment(i, j);
+}
+
+void RunningMoments::add(const double* values) {
+    const double n1 = static_cast<double>(n);
+    ++n;
+    const double nd = static_cast<double>(n);
+
+    for (size_t d = 0; d < dims; ++d) {
+        double x = values[d];
+        double delta = x - means[d];
+        double deltaN = delta / nd;
+        double deltaN2 = deltaN * deltaN;
+        double term1 = delta * deltaN * n1;
+
+        deltas[d] = delta;
+        means[d] += deltaN;
+        m4[d] += term1 * deltaN2 * (nd * nd - 3.0 * nd + 3.0) + 6.0 * deltaN2 * m2[d] - 4.0 * deltaN * m3[d];
+        m3[d] += term1 * deltaN * (nd - 2.0) - 3.0 * deltaN * m2[d];
+        m2[d] += term1;
+
+        minimum[d] = std::min(minimum[d], x);
+        maximum[d] = std::max(maximum[d], x);
+    }
+
+    // C_ij += (x_i - 旧均值_i) * (x_j - 新均值_j)
+    double* c = comoments.data();
+    for (size_t i = 0; i < dims; ++i) {
+        for (size_t j = i + 1; j < dims; ++j) {
+            *c++ += deltas[i] * (values[j] - means[j]);
+        }
+    }
+}
+
+void RunningMoments::merge(const RunningMoments& other) {
+    if (other.n == 0 || other.dims != dims) {
+        return;
+    }
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+
+    const double na = static_cast<double>(n);
+    const double nb = static_cast<double>(other.n);
+    const double nt = na + nb;
+
+    for (size_t d = 0; d < dims; ++d) {
+        double delta = other.means[d] - means[d];
+        double delta2 = delta * delta;
+        deltas[d] = delta;
+
+        double newM4 = m4[d] + other.m4[d]
+                     + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (nt * nt * nt)
+                     + 6.0 * delta2 * (na * na * other.m2[d] + nb * nb * m2[d]) / (nt * nt)
+                     + 4.0 * delta * (na * other.m3[d] - nb * m3[d]) / nt;
+        double newM3 = m3[d] + other.m3[d]
+                     + delta2 * delta * na * nb * (na - nb) / (nt * nt)
+                     + 3.0 * delta * (na * other.m2[d] - nb * m2[d]) / nt;
+        double newM2 = m2[d] + other.m2[d] + delta2 * na * nb / nt;
+
+        means[d] += delta * nb / nt;
+        m2[d] = newM2;
+        m3[d] = newM3;
+        m4[d] = newM4;
+        minimum[d] = std::min(minimum[d], other.minimum[d]);
+        maximum[d] = std::max(maximum[d], other.maximum[d]);
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < dims; ++i) {
+        for (size_t j = i + 1; j < dims; ++j, ++k) {
+            comoments[k] += other.comoments[k] + deltas[i] * deltas[j] * na * nb / nt;
+        }
+    }
+
+    n += other.n;
+}
+
+double RunningMoments::variance(size_t d) const {
+    return n > 1 ? m2[d] / (n - 1) : 0.0;
+}
+
+double RunningMoments::stdDev(size_t d) const {
+    return std::sqrt(variance(d));
+}
+
+double RunningMoments::skewness(size_t d) const {
+    double s = stdDev(d);
+    if (n < 3 || s < 1e-10) {
+        return 0.0;
+    }
+    double nd = static_cast<double>(n);
+    return nd * m3[d] / ((nd - 1.0) * (nd - 2.0) * s * s * s);
+}
+
+double RunningMoments::kurtosis(size_t d) const {
+    double s = stdDev(d);
+    if (n < 4 || s < 1e-10) {
+        return 0.0;
+    }
+    double nd = static_cast<double>(n);
+    double sumZ4 = m4[d] / (s * s * s * s);
+    return nd * (nd + 1.0) * sumZ4 / ((nd - 1.0) * (nd - 2.0) * (nd - 3.0))
+         - 3.0 * (nd - 1.0) * (nd - 1.0) / ((nd - 2.0) * (nd - 3.0));
+}
+
+double RunningMoments::covariance(size_t i, size_t j) const {
+    if (n < 2) {
+        return 0.0;
+    }
+    if (i == j) {
+        return variance(i);
+    }
+    return comoment(i, j) / (n - 1);
+}
+
+double RunningMoments::correlation(size_t i, size_t j) const {
+    if (i == j) {
+        return m2[i] > 0.0 ? 1.0 : 0.0;
+    }
+    double denom = m2[i] * m2[j];
+    if (denom <= 0.0) {
+        return 0.0;
+    }
+    return comoment(i, j) / std::sqrt(denom);
+}
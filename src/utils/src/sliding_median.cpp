@@ -0,0 +1,50 @@
+#include "../include/sliding_median.h"
+#include <iterator>
+
+void SlidingMedian::insert(double value) {
+    if (lower.empty() || value <= *lower.rbegin()) {
+        lower.insert(value);
+    } else {
+        upper.insert(value);
+    }
+    rebalance();
+}
+
+bool SlidingMedian::erase(double value) {
+    if (!lower.empty() && value <= *lower.rbegin()) {
+        auto it = lower.find(value);
+        if (it == lower.end()) return false;
+        lower.erase(it);
+    } else {
+        auto it = upper.find(value);
+        if (it == upper.end()) return false;
+        upper.erase(it);
+    }
+    rebalance();
+    return true;
+}
+
+void SlidingMedian::clear() {
+    lower.clear();
+    upper.clear();
+}
+
+double SlidingMedian::median() const {
+    if (lower.empty()) return 0.0;
+
+    if (lower.size() > upper.size()) {
+        return *lower.rbegin();
+    }
+    return (*lower.rbegin() + *upper.begin()) / 2.0;
+}
+
+void SlidingMedian::rebalance() {
+    // 通过节点转移（extract）在两个集合间移动元素，避免重新分配
+    if (lower.size() > upper.size() + 1) {
+        auto node = lower.extract(std::prev(lower.end()));
+        upper.insert(std::move(node));
+    } else if (upper.size() > lower.size()) {
+        auto node = upper.extract(upper.begin());
+        lower.insert(std::move(node));
+    }
+}
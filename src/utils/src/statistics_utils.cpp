@@ -25,13 +25,29 @@ double StatisticsUtils::stdDev(const std::vector<double>& data) {
 
 double StatisticsUtils::median(const std::vector<double>& data) {
     if (data.empty()) return 0.0;
-    std::vector<double> sorted = data;
-    std::sort(sorted.begin(), sorted.end());
-    size_t n = sorted.size();
+    // nth_element为平均O(n)，无需完整排序
+    std::vector<double> values = data;
+    size_t n = values.size();
+    auto mid = values.begin() + n / 2;
+    std::nth_element(values.begin(), mid, values.end());
     if (n % 2 == 0) {
-        return (sorted[n/2 - 1] + sorted[n/2]) / 2.0;
+        double lower = *std::max_element(values.begin(), mid);
+        return (lower + *mid) / 2.0;
     }
-    return sorted[n/2];
+    return *mid;
+}
+
+double StatisticsUtils::percentile(const std::vector<double>& data, double p) {
+    if (data.empty()) return 0.0;
+    std::vector<double> values = data;
+    double pos = std::min(std::max(p, 0.0), 100.0) / 100.0 * (values.size() - 1);
+    size_t lower = static_cast<size_t>(pos);
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double low = values[lower];
+    if (lower + 1 >= values.size()) return low;
+    // 下一个顺序统计量是右半部分的最小值
+    double high = *std::min_element(values.begin() + lower + 1, values.end());
+    return low + (pos - lower) * (high - low);
 }
 
 double StatisticsUtils::variance(const std::vector<double>& data, double mean) {
@@ -0,0 +1,159 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace {
+// 当前线程所属的线程池及其队列编号，用于把嵌套提交的任务放入本线程队列
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    size_t index = (currentPool == this) ? currentIndex : nextQueue++ % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++pendingTasks;
+    }
+    wakeCondition.notify_one();
+}
+
+bool ThreadPool::popTask(size_t index, std::function<void()>& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t index, std::function<void()>& task) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& queue = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (popTask(index, task) || stealTask(index, task)) {
+            --pendingTasks;
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() { return stopping || pendingTasks > 0; });
+        if (stopping && pendingTasks <= 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t chunkCount, const std::function<void(size_t)>& fn,
+                             size_t maxParallelism) {
+    if (chunkCount == 0) {
+        return;
+    }
+
+    size_t helpers = std::min(workers.size(), chunkCount - 1);
+    if (maxParallelism > 0) {
+        helpers = std::min(helpers, maxParallelism - 1);
+    }
+    if (helpers == 0) {
+        for (size_t c = 0; c < chunkCount; ++c) {
+            fn(c);
+        }
+        return;
+    }
+
+    // 共享状态由辅助任务持有，迟到的辅助任务发现块已领完后直接退出，不再访问fn
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count = 0;
+        const std::function<void(size_t)>* fn = nullptr;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->count = chunkCount;
+    state->fn = &fn;
+
+    auto run = [](State& s) {
+        for (size_t c = s.next++; c < s.count; c = s.next++) {
+            try {
+                (*s.fn)(c);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                if (!s.error) {
+                    s.error = std::current_exception();
+                }
+            }
+            if (++s.done == s.count) {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.finished.notify_all();
+            }
+        }
+    };
+
+    for (size_t h = 0; h < helpers; ++h) {
+        post([state, run]() { run(*state); });
+    }
+    run(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]() { return state->done.load() == state->count; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
@@ -1,7 +1,9 @@
 #include "../include/time_utils.h"
+#include "../include/format_utils.h"
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <cctype>
 
 int64_t TimeUtils::getCurrentTimestamp() {
     using namespace std::chrono;
@@ -11,36 +13,10 @@ int64_t TimeUtils::getCurrentTimestamp() {
 }
 
 std::string TimeUtils::formatTimestamp(int64_t timestamp, TimeZone tz) {
-    auto seconds = timestamp / 1000;
-    std::time_t time = static_cast<std::time_t>(seconds);
-    std::tm tm{};
-
-    if (tz == TimeZone::LOCAL) {
-#ifdef _WIN32
-    localtime_s(&tm, &time);
-#else
-    localtime_r(&time, &tm);
-#endif
-    } else {
-#ifdef _WIN32
-        gmtime_s(&tm, &time);
-#else
-        gmtime_r(&time, &tm);
-#endif
-    }
-
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    // 添加毫秒
-    int milliseconds = timestamp % 1000;
-    oss << "." << std::setfill('0') << std::setw(3) << milliseconds;
-
-    if (tz == TimeZone::UTC) {
-        oss << "Z";
-    }
-    
-    return oss.str();
+    // 每线程缓存当前分钟的渲染结果，同一分钟内只写秒和毫秒
+    thread_local TimestampFormatter localFormatter("%Y-%m-%d %H:%M:%S", TimeZone::LOCAL, true);
+    thread_local TimestampFormatter utcFormatter("%Y-%m-%d %H:%M:%S", TimeZone::UTC, true, "Z");
+    return tz == TimeZone::LOCAL ? localFormatter.format(timestamp) : utcFormatter.format(timestamp);
 }
 
 std::string TimeUtils::toISO8601(int64_t timestamp) {
@@ -62,4 +38,44 @@ std::string TimeUtils::toISO8601(int64_t timestamp) {
     oss << "." << std::setfill('0') << std::setw(3) << milliseconds << "Z";
     
     return oss.str();
-}
\ No newline at end of file
+}
+
+int64_t TimeUtils::parseTimestamp(const std::string& text, TimeZone tz) {
+    std::tm tm{};
+    std::istringstream iss(text);
+    iss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (iss.fail()) {
+        return -1;
+    }
+    
+    int milliseconds = 0;
+    if (iss.peek() == '.') {
+        iss.get();
+        std::string digits;
+        while (digits.size() < 3 && std::isdigit(iss.peek())) {
+            digits.push_back(static_cast<char>(iss.get()));
+        }
+        digits.resize(3, '0');
+        milliseconds = std::stoi(digits);
+    }
+    if (iss.peek() == 'Z') {
+        tz = TimeZone::UTC;
+    }
+    
+    std::time_t seconds;
+    if (tz == TimeZone::UTC) {
+#ifdef _WIN32
+        seconds = _mkgmtime(&tm);
+#else
+        seconds = timegm(&tm);
+#endif
+    } else {
+        tm.tm_isdst = -1;
+        seconds = std::mktime(&tm);
+    }
+    if (seconds == static_cast<std::time_t>(-1)) {
+        return -1;
+    }
+    
+    return static_cast<int64_t>(seconds) * 1000 + milliseconds;
+}
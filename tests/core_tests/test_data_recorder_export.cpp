@@ -0,0 +1,68 @@
+// tests/core_tests/test_data_recorder_export.cpp
+#include <gtest/gtest.h>
+#include "core/include/data_recorder.h"
+#include "models/include/measurement_data.h"
+#include "models/include/sensor_data.h"
+#include "models/include/system_config.h"
+#include "utils/include/logger.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+class DataRecorderExportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        SystemConfig::getInstance().reset();
+        testDir = (std::filesystem::temp_directory_path() / "cdc_recorder_export_test").string();
+        std::filesystem::create_directories(testDir);
+        dataRecorder = std::make_unique<DataRecorder>();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::string testDir;
+    std::unique_ptr<DataRecorder> dataRecorder;
+};
+
+// 测试达到容量上限时边记录边导出：未读记录被淘汰则导出失败，只淘汰已读记录时完整导出
+TEST_F(DataRecorderExportTest, ExportWhileRecordingAtCapacity) {
+    const int capacity = 5000;   // 大于一个读取块（4096条）
+    dataRecorder->setMaxRecords(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        dataRecorder->recordMeasurement(MeasurementData(10.0 + i % 50, 0.0, SensorData()));
+    }
+
+    // 读完第一块（4096条）后记录count条新数据
+    auto exportWhileRecording = [&](int count, const std::string& filename) {
+        bool recorded = false;
+        dataRecorder->setExportProgressCallback([&](int, int) {
+            if (!recorded) {
+                recorded = true;
+                for (int i = 0; i < count; ++i) {
+                    dataRecorder->recordMeasurement(MeasurementData(10.0 + i % 50, 0.0, SensorData()));
+                }
+            }
+        });
+        bool success = dataRecorder->exportToCSV(filename);
+        dataRecorder->setExportProgressCallback(nullptr);
+        return success;
+    };
+
+    // 只淘汰已经读过的记录
+    std::string filename = testDir + "/at_capacity.csv";
+    EXPECT_TRUE(exportWhileRecording(100, filename));
+    std::ifstream file(filename);
+    std::string line;
+    int lines = 0;
+    while (std::getline(file, line)) {
+        ++lines;
+    }
+    EXPECT_EQ(lines, capacity + 1);
+
+    // 未读的记录被淘汰
+    EXPECT_FALSE(exportWhileRecording(4500, testDir + "/truncated.csv"));
+    EXPECT_EQ(dataRecorder->size(), static_cast<size_t>(capacity));
+}
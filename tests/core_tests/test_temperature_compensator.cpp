@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "core/include/temperature_compensator.h"
+#include "core/include/sensor_manager.h"
+#include "models/include/system_config.h"
+#include "utils/include/logger.h"
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+namespace {
+SensorData makeReading(double temperature, double capacitance, double distance) {
+    SensorData data;
+    data.setTemperature(temperature);
+    data.setCapacitance(capacitance);
+    data.setUpperSensors(distance, distance);
+    return data;
+}
+}
+
+class TemperatureCompensatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        SystemConfig::getInstance().reset();
+    }
+
+    // 两个空闲期（不同位置），温度缓慢上升；电容 0.2 pF/°C，距离 -0.05 mm/°C
+    void learnTwoPeriods(TemperatureCompensator& compensator) {
+        std::mt19937 gen(7);
+        std::normal_distribution<> noise(0.0, 0.02);
+        const double offsets[] = {150.0, 172.0};
+        for (int period = 0; period < 2; ++period) {
+            compensator.beginIdlePeriod();
+            for (int i = 0; i < 600; ++i) {
+                double t = 24.0 + period * 3.0 + i * 0.004;
+                double drift = t - 24.0;
+                compensator.learn(makeReading(t, offsets[period] + 0.2 * drift + noise(gen),
+                                              40.0 + period * 10.0 - 0.05 * drift + noise(gen)));
+            }
+        }
+    }
+};
+
+// 测试跨空闲期学习温度系数并补偿漂移
+TEST_F(TemperatureCompensatorTest, LearnsCoefficientAcrossIdlePeriods) {
+    TemperatureCompensator compensator;
+    learnTwoPeriods(compensator);
+
+    ChannelCompensation cap = compensator.getCompensation(SensorChannel::CAPACITANCE);
+    EXPECT_NEAR(cap.coefficient, 0.2, 0.01);
+    EXPECT_TRUE(cap.confident);
+    EXPECT_EQ(cap.samples, 1200u);
+    EXPECT_NEAR(cap.residualStd, 0.02, 0.01);
+    EXPECT_LT(cap.standardError, 0.01);
+    EXPECT_NEAR(cap.temperatureSpan, 5.4, 0.01);
+
+    ChannelCompensation distance = compensator.getCompensation(SensorChannel::DISTANCE_UPPER_1);
+    EXPECT_NEAR(distance.coefficient, -0.05, 0.01);
+    EXPECT_TRUE(distance.confident);
+
+    // 未参与学习的通道与温度本身不补偿
+    EXPECT_FALSE(compensator.getCompensation(SensorChannel::DISTANCE_LOWER_1).confident);
+    EXPECT_FALSE(TemperatureCompensator::isCompensated(SensorChannel::TEMPERATURE));
+
+    // 同一位置在不同温度下的读数补偿后一致
+    SensorData cold = compensator.apply(makeReading(24.0, 160.0, 45.0));
+    SensorData warm = compensator.apply(makeReading(34.0, 162.0, 44.5));
+    EXPECT_NEAR(cold.capacitance, warm.capacitance, 0.1);
+    EXPECT_NEAR(cold.distanceUpper2, warm.distanceUpper2, 0.1);
+    EXPECT_DOUBLE_EQ(warm.temperature, 34.0);
+}
+
+// 测试温度不变时系数不可辨识，不做补偿
+TEST_F(TemperatureCompensatorTest, ConstantTemperatureIsNotConfident) {
+    TemperatureCompensator compensator;
+    compensator.beginIdlePeriod();
+    for (int i = 0; i < 500; ++i) {
+        compensator.learn(makeReading(25.0, 150.0 + 0.01 * (i % 3), 40.0));
+    }
+
+    EXPECT_FALSE(compensator.getCompensation(SensorChannel::CAPACITANCE).confident);
+    SensorData reading = makeReading(30.0, 151.0, 40.0);
+    EXPECT_DOUBLE_EQ(compensator.apply(reading).capacitance, 151.0);
+}
+
+// 测试学习结果跨会话保存和读取
+TEST_F(TemperatureCompensatorTest, PersistsBetweenSessions) {
+    TemperatureCompensator compensator;
+    learnTwoPeriods(compensator);
+
+    std::string path = (std::filesystem::temp_directory_path() / "cdc_temperature_compensation.json").string();
+    ASSERT_TRUE(compensator.saveToFile(path));
+
+    TemperatureCompensator restored;
+    ASSERT_TRUE(restored.loadFromFile(path));
+    std::remove(path.c_str());
+
+    EXPECT_DOUBLE_EQ(restored.getReferenceTemperature(), compensator.getReferenceTemperature());
+    for (SensorChannel channel : {SensorChannel::CAPACITANCE, SensorChannel::DISTANCE_UPPER_1}) {
+        ChannelCompensation a = compensator.getCompensation(channel);
+        ChannelCompensation b = restored.getCompensation(channel);
+        EXPECT_DOUBLE_EQ(a.coefficient, b.coefficient);
+        EXPECT_DOUBLE_EQ(a.standardError, b.standardError);
+        EXPECT_EQ(a.samples, b.samples);
+        EXPECT_EQ(a.confident, b.confident);
+    }
+    SensorData reading = makeReading(31.0, 155.0, 42.0);
+    EXPECT_DOUBLE_EQ(restored.apply(reading).capacitance, compensator.apply(reading).capacitance);
+
+    EXPECT_FALSE(restored.loadFromFile(path));
+}
+
+// 测试传感器管理器在空闲期间学习，输出补偿后的读数
+TEST_F(TemperatureCompensatorTest, SensorManagerCompensatesReadings) {
+    SensorManager manager(nullptr);
+    manager.setHistorySize(10);
+    manager.setCompensationLearning(true);
+    for (int i = 0; i < 400; ++i) {
+        double t = 22.0 + i * 0.01;
+        manager.updateLatestData(makeReading(t, 140.0 + 0.3 * (t - 22.0), 40.0));
+    }
+    manager.setCompensationLearning(false);
+
+    ChannelCompensation cap = manager.getTemperatureCompensation(SensorChannel::CAPACITANCE);
+    ASSERT_TRUE(cap.confident);
+    EXPECT_NEAR(cap.coefficient, 0.3, 1e-6);
+
+    // 移动中不学习；读数按学到的系数补偿
+    manager.updateLatestData(makeReading(30.0, 150.0, 40.0));
+    EXPECT_EQ(manager.getTemperatureCompensation(SensorChannel::CAPACITANCE).samples, 400u);
+    EXPECT_NEAR(manager.getLatestData().capacitance, 150.0 - 0.3 * 8.0, 1e-6);
+
+    manager.setTemperatureCompensationEnabled(false);
+    manager.updateLatestData(makeReading(30.0, 150.0, 40.0));
+    EXPECT_DOUBLE_EQ(manager.getLatestData().capacitance, 150.0);
+}
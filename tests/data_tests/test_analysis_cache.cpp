@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "data/include/analysis_cache.h"
+#include "data/include/data_processor.h"
+#include "core/include/data_recorder.h"
+#include "utils/include/logger.h"
+#include <random>
+
+class AnalysisCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        recorder = std::make_unique<DataRecorder>();
+        recorder->setMaxRecords(100000);
+        source = [this](const DatasetVersion& since, DatasetVersion& current) {
+            ++fetches;
+            auto delta = recorder->getMeasurementsSince(since, current);
+            fetchedRecords += delta.size();
+            return delta;
+        };
+    }
+
+    void record(int count) {
+        std::normal_distribution<> noise(0.0, 0.2);
+        for (int i = 0; i < count; ++i) {
+            double h = 20.0 + (next % 200) * 0.25;
+            SensorData sensorData;
+            sensorData.capacitance = 1.5 * h + 4.0 + noise(gen);
+            sensorData.temperature = 25.0 + noise(gen);
+            MeasurementData m(h, 0.0, sensorData);
+            m.setTimestamp(1000 + next);
+            recorder->recordMeasurement(m);
+            ++next;
+        }
+    }
+
+    std::unique_ptr<DataRecorder> recorder;
+    DataProcessor processor;
+    AnalysisCache cache;
+    AnalysisCache::DeltaSource source;
+    std::mt19937 gen{21};
+    int next = 0;
+    int fetches = 0;
+    size_t fetchedRecords = 0;
+};
+
+// 测试追加数据后的增量统计与完整计算一致
+TEST_F(AnalysisCacheTest, IncrementalStatisticsMatchFullComputation) {
+    record(5000);
+    auto first = cache.statistics(processor, recorder->getVersion(), source);
+    EXPECT_EQ(first.dataCount, 5000);
+
+    record(3001);
+    auto incremental = cache.statistics(processor, recorder->getVersion(), source);
+    auto full = processor.calculateStatistics(recorder->getAllMeasurements());
+
+    EXPECT_EQ(incremental.dataCount, full.dataCount);
+    EXPECT_NEAR(incremental.meanCapacitance, full.meanCapacitance, 1e-9);
+    EXPECT_NEAR(incremental.stdDevHeight, full.stdDevHeight, 1e-9);
+    EXPECT_NEAR(incremental.kurtosis, full.kurtosis, 1e-9);
+    EXPECT_DOUBLE_EQ(incremental.minHeight, full.minHeight);
+    EXPECT_DOUBLE_EQ(incremental.median, full.median);
+    EXPECT_EQ(incremental.firstRecordTime, full.firstRecordTime);
+    EXPECT_EQ(incremental.lastRecordTime, full.lastRecordTime);
+
+    auto regression = cache.regression(processor, recorder->getVersion(), source,
+                                       DataField::HEIGHT, DataField::CAPACITANCE);
+    auto fullRegression = processor.performLinearRegression(recorder->getAllMeasurements(),
+                                                            DataField::HEIGHT, DataField::CAPACITANCE);
+    EXPECT_NEAR(regression.slope, fullRegression.slope, 1e-9);
+    EXPECT_NEAR(regression.intercept, fullRegression.intercept, 1e-9);
+    EXPECT_NEAR(regression.rSquared, fullRegression.rSquared, 1e-9);
+}
+
+// 测试数据未变化时不再读取记录
+TEST_F(AnalysisCacheTest, UnchangedDataIsFree) {
+    record(1000);
+    cache.statistics(processor, recorder->getVersion(), source);
+    int fetchesAfterFirst = fetches;
+
+    for (int i = 0; i < 10; ++i) {
+        cache.statistics(processor, recorder->getVersion(), source);
+    }
+    EXPECT_EQ(fetches, fetchesAfterFirst);
+
+    int computed = 0;
+    auto compute = [&]() { ++computed; return std::vector<double>{1.0, 2.0}; };
+    for (int i = 0; i < 3; ++i) {
+        auto value = cache.getOrCompute<std::vector<double>>(recorder->getVersion(), "fft", "capacitance",
+                                                             compute);
+        EXPECT_EQ(value.size(), 2u);
+    }
+    EXPECT_EQ(computed, 1);
+
+    record(1);
+    cache.getOrCompute<std::vector<double>>(recorder->getVersion(), "fft", "capacitance", compute);
+    EXPECT_EQ(computed, 2);
+}
+
+// 测试清空后版本epoch变化，重新从头计算
+TEST_F(AnalysisCacheTest, ClearStartsNewEpoch) {
+    record(500);
+    DatasetVersion before = recorder->getVersion();
+    cache.statistics(processor, before, source);
+
+    recorder->clear();
+    record(10);
+    DatasetVersion after = recorder->getVersion();
+    EXPECT_NE(before.epoch, after.epoch);
+    EXPECT_FALSE(before.isPrefixOf(after));
+
+    auto stats = cache.statistics(processor, after, source);
+    EXPECT_EQ(stats.dataCount, 10);
+}
+
+// 测试记录数达到上限后持续滚动：首部淘汰仍按增量更新，结果与完整计算一致
+TEST_F(AnalysisCacheTest, IncrementalAtCapacity) {
+    recorder->setMaxRecords(3000);
+    record(5000);
+    auto first = cache.statistics(processor, recorder->getVersion(), source);
+    EXPECT_EQ(first.dataCount, 3000);
+    cache.regression(processor, recorder->getVersion(), source, DataField::HEIGHT, DataField::CAPACITANCE);
+
+    for (int round = 0; round < 3; ++round) {
+        record(round == 2 ? 1 : 700);
+        DatasetVersion version = recorder->getVersion();
+        EXPECT_EQ(version.epoch, 0u);
+        EXPECT_EQ(version.size, 3000u);
+
+        size_t fetchedBefore = fetchedRecords;
+        auto incremental = cache.statistics(processor, version, source);
+        EXPECT_EQ(fetchedRecords - fetchedBefore, round == 2 ? 1u : 700u);
+
+        auto full = processor.calculateStatistics(recorder->getAllMeasurements());
+        EXPECT_EQ(incremental.dataCount, full.dataCount);
+        EXPECT_NEAR(incremental.meanCapacitance, full.meanCapacitance, 1e-9);
+        EXPECT_NEAR(incremental.stdDevHeight, full.stdDevHeight, 1e-9);
+        EXPECT_NEAR(incremental.kurtosis, full.kurtosis, 1e-9);
+        EXPECT_DOUBLE_EQ(incremental.minHeight, full.minHeight);
+        EXPECT_DOUBLE_EQ(incremental.maxCapacitance, full.maxCapacitance);
+        EXPECT_DOUBLE_EQ(incremental.median, full.median);
+        EXPECT_EQ(incremental.firstRecordTime, full.firstRecordTime);
+        EXPECT_EQ(incremental.lastRecordTime, full.lastRecordTime);
+    }
+
+    // 两次查询之间淘汰的记录多于保留的记录
+    record(4000);
+    auto regression = cache.regression(processor, recorder->getVersion(), source,
+                                       DataField::HEIGHT, DataField::CAPACITANCE);
+    auto fullRegression = processor.performLinearRegression(recorder->getAllMeasurements(),
+                                                            DataField::HEIGHT, DataField::CAPACITANCE);
+    EXPECT_NEAR(regression.slope, fullRegression.slope, 1e-9);
+    EXPECT_NEAR(regression.rSquared, fullRegression.rSquared, 1e-9);
+}
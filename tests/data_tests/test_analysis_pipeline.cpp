@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "data/include/analysis_pipeline.h"
+#include "data/include/data_processor.h"
+#include "core/include/data_recorder.h"
+#include "utils/include/logger.h"
+#include <random>
+
+class AnalysisPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        std::mt19937 gen(9);
+        std::normal_distribution<> noise(0.0, 0.05);
+        for (int i = 0; i < 5000; ++i) {
+            double h = 10.0 + (i % 400) * 0.1;
+            double angle = (i % 3 == 0) ? 0.0 : 5.0;
+            SensorData sensorData;
+            sensorData.capacitance = 80.0 / h + 2.0 + noise(gen);
+            sensorData.temperature = 25.0 + (i % 7) * 0.1;
+            MeasurementData m(h, angle, sensorData);
+            m.setTimestamp(1000 + i * 10);
+            data.push_back(m);
+        }
+    }
+
+    std::vector<MeasurementData> data;
+    DataProcessor processor;
+};
+
+// 测试流水线结果与手工筛选、平滑、拟合一致
+TEST_F(AnalysisPipelineTest, MatchesManualComputation) {
+    const int64_t start = 5000;
+    const int64_t end = 40000;
+
+    std::vector<double> x;
+    std::vector<double> y;
+    for (const auto& m : data) {
+        if (m.getTimestamp() >= start && m.getTimestamp() <= end && m.getSetAngle() == 0.0) {
+            x.push_back(1.0 / m.getSetHeight());
+            y.push_back(m.getSensorData().capacitance);
+        }
+    }
+    y = processor.smoothValues(y, SmoothingMethod::MEDIAN, 5);
+    LinearRegression expected = processor.linearRegression(x, y);
+
+    VectorMeasurementSource source(data, 1000);
+    LinearRegression fit = AnalysisPipeline(source, processor)
+        .timeRange(start, end)
+        .where(DataField::ANGLE, 0.0, 0.0)
+        .map(DataField::HEIGHT, [](double h) { return 1.0 / h; })
+        .smooth(DataField::CAPACITANCE, SmoothingMethod::MEDIAN, 5)
+        .regress(DataField::HEIGHT, DataField::CAPACITANCE);
+
+    EXPECT_DOUBLE_EQ(fit.slope, expected.slope);
+    EXPECT_DOUBLE_EQ(fit.intercept, expected.intercept);
+    EXPECT_NEAR(fit.slope, 80.0, 2.0);
+    EXPECT_NEAR(fit.intercept, 2.0, 0.1);
+    EXPECT_EQ(fit.residuals.size(), x.size());
+}
+
+// 测试只物化所选列，且筛选字段不出现在结果中
+TEST_F(AnalysisPipelineTest, CollectSelectedColumns) {
+    VectorMeasurementSource source(data, 777);
+    MeasurementColumns columns = AnalysisPipeline(source, processor)
+        .select({DataField::TEMPERATURE})
+        .where(DataField::HEIGHT, 20.0, 30.0)
+        .where([](const MeasurementData& m) { return m.getSetAngle() > 0.0; })
+        .collect();
+
+    size_t expected = 0;
+    for (const auto& m : data) {
+        if (m.getSetHeight() >= 20.0 && m.getSetHeight() <= 30.0 && m.getSetAngle() > 0.0) {
+            ++expected;
+        }
+    }
+    ASSERT_EQ(columns.fields.size(), 1u);
+    EXPECT_EQ(columns.fields[0], DataField::TEMPERATURE);
+    EXPECT_EQ(columns.rows, expected);
+    EXPECT_EQ(columns.find(DataField::HEIGHT), nullptr);
+}
+
+// 测试流式矩统计与物化后的统计一致
+TEST_F(AnalysisPipelineTest, StreamingMoments) {
+    VectorMeasurementSource source(data);
+    AnalysisPipeline pipeline(source, processor);
+    pipeline.where(DataField::ANGLE, 5.0, 5.0);
+
+    RunningMoments streamed = pipeline.moments({DataField::HEIGHT, DataField::CAPACITANCE});
+    std::vector<MeasurementData> tilted;
+    for (const auto& m : data) {
+        if (m.getSetAngle() == 5.0) tilted.push_back(m);
+    }
+    RunningMoments direct = processor.computeMoments(tilted, {DataField::HEIGHT, DataField::CAPACITANCE});
+
+    ASSERT_EQ(streamed.count(), direct.count());
+    EXPECT_NEAR(streamed.mean(0), direct.mean(0), 1e-9);
+    EXPECT_NEAR(streamed.variance(1), direct.variance(1), 1e-9);
+    EXPECT_NEAR(streamed.correlation(0, 1), direct.correlation(0, 1), 1e-9);
+}
+
+// 测试以数据记录器为数据源
+TEST_F(AnalysisPipelineTest, RecorderSource) {
+    DataRecorder recorder;
+    recorder.setMaxRecords(100000);
+    for (const auto& m : data) {
+        recorder.recordMeasurement(m);
+    }
+
+    MeasurementColumns columns = AnalysisPipeline(recorder, processor)
+        .select({DataField::HEIGHT})
+        .timeRange(1000, 1000 + 99 * 10)
+        .collect();
+    EXPECT_EQ(columns.rows, 100u);
+}
+
+// 测试记录器已满且遍历期间持续记录：首部淘汰不中断遍历；未读记录被淘汰时返回空结果
+TEST_F(AnalysisPipelineTest, RecorderAtCapacity) {
+    DataRecorder recorder;
+    recorder.setMaxRecords(data.size());
+    for (const auto& m : data) {
+        recorder.recordMeasurement(m);
+    }
+
+    // 每读一行记录一条新数据，淘汰速度与读取速度相同，始终不会追上未读记录
+    size_t next = 0;
+    MeasurementColumns columns = AnalysisPipeline(recorder, processor)
+        .select({DataField::HEIGHT})
+        .where([&](const MeasurementData&) {
+            recorder.recordMeasurement(data[next++ % data.size()]);
+            return true;
+        })
+        .collect();
+    EXPECT_EQ(columns.rows, data.size());
+
+    // 每读一行记录两条，第一块之后未读记录已被淘汰
+    columns = AnalysisPipeline(recorder, processor)
+        .select({DataField::HEIGHT})
+        .where([&](const MeasurementData&) {
+            recorder.recordMeasurement(data[next++ % data.size()]);
+            recorder.recordMeasurement(data[next++ % data.size()]);
+            return true;
+        })
+        .collect();
+    EXPECT_EQ(columns.rows, 0u);
+    EXPECT_EQ(columns.values.size(), 0u);
+}
+
+// 测试取消后终端操作返回空结果
+TEST_F(AnalysisPipelineTest, Cancellation) {
+    ExecutionPolicy policy;
+    policy.cancellation.cancel();
+    processor.setExecutionPolicy(policy);
+
+    VectorMeasurementSource source(data);
+    MeasurementColumns columns = AnalysisPipeline(source, processor)
+        .select({DataField::HEIGHT})
+        .collect();
+    EXPECT_EQ(columns.rows, 0u);
+}
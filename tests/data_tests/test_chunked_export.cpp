@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "data/include/chunked_export.h"
+#include "data/include/export_manager.h"
+#include "utils/include/logger.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+// 记录每次write()的内存ByteSink
+class MemorySink : public ByteSink {
+public:
+    bool write(const char* data, size_t size) override {
+        if (failAfter >= 0 && writes >= failAfter) return false;
+        content.append(data, size);
+        writes++;
+        return true;
+    }
+    bool close() override { return true; }
+    size_t bytesWritten() const override { return content.size(); }
+
+    std::string content;
+    int writes = 0;
+    int failAfter = -1;
+};
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+}
+
+class ChunkedExportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        testDir = fs::temp_directory_path() / "cdc_chunked_export_test";
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::vector<MeasurementData> makeData(size_t count) {
+        std::vector<double> heights(count), angles(count);
+        std::vector<SensorData> sensors(count);
+        for (size_t i = 0; i < count; ++i) {
+            heights[i] = 10.0 + static_cast<double>(i % 100);
+            angles[i] = static_cast<double>(i % 7) - 3.0;
+            sensors[i].setCapacitance(100.0 + 0.001 * static_cast<double>(i));
+            sensors[i].setTemperature(23.0);
+        }
+        auto data = MeasurementData::createBatch(heights, angles, sensors);
+        for (size_t i = 0; i < count; ++i) {
+            data[i].setTimestamp(1700000000000LL + static_cast<int64_t>(i) * 10);
+        }
+        return data;
+    }
+
+    fs::path testDir;
+};
+
+// 测试格式化耗时不同的块仍按块序写出，每块一次write
+TEST_F(ChunkedExportTest, WritesChunksInOrder) {
+    MemorySink sink;
+    std::vector<size_t> written;
+    ChunkedExport::Options options;
+    options.batchChunks = 4;
+
+    bool ok = ChunkedExport::run(37, [](size_t chunk, std::string& out) {
+        if (chunk % 3 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        out += "chunk" + std::to_string(chunk) + ";";
+    }, sink, [&](size_t chunk) { written.push_back(chunk); }, options);
+
+    ASSERT_TRUE(ok);
+    std::string expected;
+    for (size_t i = 0; i < 37; ++i) {
+        expected += "chunk" + std::to_string(i) + ";";
+        ASSERT_EQ(written[i], i);
+    }
+    EXPECT_EQ(sink.content, expected);
+    EXPECT_EQ(sink.writes, 37);
+}
+
+// 测试写入失败、格式化异常和取消都会终止导出
+TEST_F(ChunkedExportTest, StopsOnFailure) {
+    auto format = [](size_t chunk, std::string& out) { out += std::to_string(chunk); };
+    ChunkedExport::Options options;
+    options.batchChunks = 2;
+    std::string error;
+
+    MemorySink failing;
+    failing.failAfter = 3;
+    EXPECT_FALSE(ChunkedExport::run(100, format, failing, nullptr, options, &error));
+    EXPECT_EQ(failing.writes, 3);
+    EXPECT_FALSE(error.empty());
+
+    MemorySink sink;
+    EXPECT_FALSE(ChunkedExport::run(10, [](size_t chunk, std::string& out) {
+        if (chunk == 5) throw std::runtime_error("bad record");
+        out += "x";
+    }, sink, nullptr, options, &error));
+    EXPECT_NE(error.find("bad record"), std::string::npos);
+    EXPECT_LE(sink.content.size(), 5u);
+
+    MemorySink cancelled;
+    options.cancellation.cancel();
+    EXPECT_FALSE(ChunkedExport::run(10, format, cancelled, nullptr, options, &error));
+    EXPECT_TRUE(cancelled.content.empty());
+}
+
+// 测试分块CSV/JSON导出与逐条格式化结果一致，进度按块报告
+TEST_F(ChunkedExportTest, ExportManagerMatchesRecordFormatting) {
+    auto data = makeData(10000);
+    ExportManager manager;
+    std::vector<int> progress;
+    manager.setProgressCallback([&](int percentage) { progress.push_back(percentage); });
+
+    ExportOptions options;
+    options.chunkRecords = 1000;
+    std::string csvFile = (testDir / "data.csv").string();
+    ASSERT_TRUE(manager.exportData(data, csvFile, options));
+
+    std::string csv = readFile(csvFile);
+    size_t lines = 0;
+    for (size_t pos = csv.find("\r\n"); pos != std::string::npos; pos = csv.find("\r\n", pos + 2)) {
+        lines++;
+    }
+    EXPECT_EQ(lines, 10001u);
+    EXPECT_EQ(csv.compare(0, 9, "Timestamp"), 0);
+    EXPECT_EQ(manager.getLastExportStatistics().fileSize, csv.size());
+
+    ASSERT_EQ(progress.size(), 10u);
+    for (size_t i = 0; i < progress.size(); ++i) {
+        EXPECT_EQ(progress[i], static_cast<int>((i + 1) * 10));
+    }
+
+    // 块大小不影响输出
+    options.chunkRecords = 7;
+    std::string smallChunks = (testDir / "small.csv").string();
+    ASSERT_TRUE(manager.exportData(data, smallChunks, options));
+    EXPECT_EQ(readFile(smallChunks), csv);
+
+    options.format = ExportFormat::JSON;
+    options.prettyPrint = true;
+    options.chunkRecords = 333;
+    std::string jsonFile = (testDir / "data.json").string();
+    ASSERT_TRUE(manager.exportData(data, jsonFile, options));
+    std::string json = readFile(jsonFile);
+    EXPECT_EQ(json.compare(0, 4, "[\n  "), 0);
+    EXPECT_EQ(json.compare(json.size() - 3, 3, "}\n]"), 0);
+    EXPECT_EQ(std::count(json.begin(), json.end(), '{'), 10000);
+    EXPECT_EQ(std::count(json.begin(), json.end(), ','), 10000 * 4 - 1);
+}
+
+// 测试无法打开文件时报告错误
+TEST_F(ChunkedExportTest, OpenFailure) {
+    ExportManager manager;
+    auto data = makeData(10);
+    EXPECT_FALSE(manager.exportData(data, (testDir / "missing" / "data.csv").string()));
+    EXPECT_FALSE(manager.getLastError().empty());
+}
+
+// 测试流式数据源的块大小与导出块大小无关：小块数据源与整个vector导出结果一致
+TEST_F(ChunkedExportTest, StreamsFromChunkedSource) {
+    auto data = makeData(5000);
+    ExportManager manager;
+    ExportOptions options;
+    options.chunkRecords = 250;
+
+    std::string fromVector = (testDir / "vector.csv").string();
+    ASSERT_TRUE(manager.exportData(data, fromVector, options));
+
+    std::vector<int> progress;
+    manager.setProgressCallback([&](int percentage) { progress.push_back(percentage); });
+    VectorMeasurementSource source(data, 37);
+    std::string fromSource = (testDir / "source.csv").string();
+    ASSERT_TRUE(manager.exportData(source, fromSource, options));
+    EXPECT_EQ(readFile(fromSource), readFile(fromVector));
+    EXPECT_EQ(manager.getLastExportStatistics().exportedRecords, 5000);
+    ASSERT_EQ(progress.size(), 20u);
+    EXPECT_EQ(progress.back(), 100);
+
+    options.format = ExportFormat::JSON;
+    options.prettyPrint = false;
+    ASSERT_TRUE(manager.exportData(source, fromSource, options));
+    std::string json = readFile(fromSource);
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_EQ(json.compare(json.size() - 2, 2, "}]"), 0);
+    EXPECT_EQ(json.find(",,"), std::string::npos);
+    EXPECT_EQ(std::count(json.begin(), json.end(), '{'), 5000);
+
+    std::vector<MeasurementData> empty;
+    EXPECT_FALSE(manager.exportData(VectorMeasurementSource(empty), fromSource, options));
+}
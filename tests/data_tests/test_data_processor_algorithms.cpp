@@ -0,0 +1,565 @@
+// tests/data_tests/test_data_processor_algorithms.cpp
+#include <gtest/gtest.h>
+#include "data/include/data_processor.h"
+#include "models/include/measurement_data.h"
+#include "models/include/sensor_data.h"
+#include "utils/include/logger.h"
+#include "utils/include/statistics_utils.h"
+#include <cmath>
+#include <random>
+#include <numeric>
+#include <chrono>
+#include <atomic>
+
+// 数据处理算法测试：每个测试自行构造数据，不依赖预置数据集
+class DataProcessorAlgorithmTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        dataProcessor = std::make_unique<DataProcessor>();
+    }
+
+    std::unique_ptr<DataProcessor> dataProcessor;
+};
+
+// 测试长序列FFT（超过65536点且非2的幂）
+TEST_F(DataProcessorAlgorithmTest, LongSeriesFFT) {
+    std::vector<MeasurementData> signalData;
+    const int n = 70000;
+    signalData.reserve(n);
+    for (int i = 0; i < n; i++) {
+        double t = i * 0.001; // 1kHz采样
+        double signal = 3.0 * std::sin(2 * M_PI * 50.0 * t);
+
+        SensorData sensorData;
+        sensorData.capacitance = signal;
+        MeasurementData measurement(10.0, 0.0, sensorData);
+        measurement.setTimestamp(i);
+        signalData.push_back(measurement);
+    }
+
+    auto spectrum = dataProcessor->performFFT(signalData, DataField::CAPACITANCE);
+
+    EXPECT_EQ(spectrum.frequencies.size(), static_cast<size_t>(n / 2));
+    EXPECT_NEAR(spectrum.dominantFrequency, 50.0, 0.05);
+}
+
+// 测试Welch功率谱估计
+TEST_F(DataProcessorAlgorithmTest, WelchPowerSpectrum) {
+    const double fs = 1000.0;
+    std::vector<double> signal(20000);
+    std::mt19937 gen(7);
+    std::normal_distribution<> noise(0.0, 0.5);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 2.0 * std::sin(2 * M_PI * 120.0 * i / fs) + noise(gen);
+    }
+
+    WelchOptions options;
+    options.segmentLength = 500;
+    options.overlap = 0.5;
+    auto psd = dataProcessor->welchPSD(signal, fs, options);
+
+    EXPECT_EQ(psd.segmentCount, 79);
+    EXPECT_EQ(psd.frequencies.size(), 251u);
+    EXPECT_NEAR(psd.dominantFrequency, 120.0, 2.0);
+
+    // PSD积分应接近信号方差（正弦功率2 + 噪声功率0.25）
+    double df = psd.frequencies[1] - psd.frequencies[0];
+    double power = std::accumulate(psd.density.begin(), psd.density.end(), 0.0) * df;
+    EXPECT_NEAR(power, 2.25, 0.15);
+
+    // 中位数平均同样应找到主频
+    options.averaging = SpectralAveraging::MEDIAN;
+    auto medianPsd = dataProcessor->welchPSD(signal, fs, options);
+    EXPECT_NEAR(medianPsd.dominantFrequency, 120.0, 2.0);
+}
+
+// 测试Savitzky-Golay平滑保留多项式趋势（含两端）
+TEST_F(DataProcessorAlgorithmTest, SavitzkyGolayPreservesPolynomial) {
+    std::vector<MeasurementData> data;
+    for (int i = 0; i < 100; i++) {
+        double x = i * 0.1;
+        SensorData sensorData;
+        sensorData.capacitance = 50.0 + 2.0 * x - 0.3 * x * x;
+        data.emplace_back(10.0, 0.0, sensorData);
+    }
+
+    auto smoothed = dataProcessor->smoothData(data, SmoothingMethod::SAVITZKY_GOLAY, 11, 2);
+
+    ASSERT_EQ(smoothed.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_NEAR(smoothed[i].getSensorData().capacitance,
+                    data[i].getSensorData().capacitance, 1e-9) << "i=" << i;
+    }
+}
+
+// 测试中值滤波去除脉冲噪声，以及大数据量下的平滑
+TEST_F(DataProcessorAlgorithmTest, MedianFilterRemovesSpikes) {
+    std::vector<MeasurementData> data;
+    for (int i = 0; i < 50; i++) {
+        SensorData sensorData;
+        sensorData.capacitance = (i % 10 == 5) ? 500.0 : 100.0;
+        data.emplace_back(10.0, 0.0, sensorData);
+    }
+
+    auto smoothed = dataProcessor->smoothData(data, SmoothingMethod::MEDIAN, 5);
+    for (const auto& m : smoothed) {
+        EXPECT_DOUBLE_EQ(m.getSensorData().capacitance, 100.0);
+    }
+
+    std::vector<MeasurementData> large(200000, data.front());
+    auto start = std::chrono::steady_clock::now();
+    auto largeSmoothed = dataProcessor->smoothData(large, SmoothingMethod::SAVITZKY_GOLAY, 21, 3);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(largeSmoothed.size(), large.size());
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+}
+
+// 测试列式平滑：并行与串行结果一致，且与smoothData写回的值一致
+TEST_F(DataProcessorAlgorithmTest, ColumnarSmoothingMatchesRecords) {
+    std::vector<MeasurementData> data;
+    std::mt19937 gen(11);
+    std::normal_distribution<> noise(0.0, 1.0);
+    for (int i = 0; i < 5000; i++) {
+        SensorData sensorData;
+        sensorData.capacitance = 100.0 + noise(gen);
+        sensorData.distanceUpper1 = 10.0 + noise(gen);
+        sensorData.distanceLower2 = 20.0 + noise(gen);
+        data.emplace_back(10.0, 0.0, sensorData);
+    }
+
+    std::vector<DataField> fields = {
+        DataField::CAPACITANCE, DataField::UPPER_SENSOR_1, DataField::LOWER_SENSOR_2
+    };
+    auto serial = dataProcessor->smoothColumns(data, SmoothingMethod::MEDIAN, 7, 2, fields, false);
+    auto parallel = dataProcessor->smoothColumns(data, SmoothingMethod::MEDIAN, 7, 2, fields, true);
+
+    ASSERT_EQ(serial.rows, data.size());
+    ASSERT_EQ(serial.values.size(), fields.size());
+    EXPECT_EQ(serial.values, parallel.values);
+
+    auto records = dataProcessor->smoothData(data, SmoothingMethod::MEDIAN, 7);
+    const auto* capacitance = serial.find(DataField::CAPACITANCE);
+    ASSERT_NE(capacitance, nullptr);
+    EXPECT_EQ(serial.find(DataField::TEMPERATURE), nullptr);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_DOUBLE_EQ(records[i].getSensorData().capacitance, (*capacitance)[i]);
+        EXPECT_DOUBLE_EQ(records[i].getSensorData().distanceLower2,
+                         (*serial.find(DataField::LOWER_SENSOR_2))[i]);
+    }
+}
+
+// 测试加权拟合与批量拟合接口
+TEST_F(DataProcessorAlgorithmTest, WeightedAndBatchPolynomialFitting) {
+    std::vector<PolynomialSeries> series(3);
+    for (size_t s = 0; s < series.size(); ++s) {
+        for (int i = 0; i < 20; ++i) {
+            double x = i * 0.5;
+            series[s].x.push_back(x);
+            series[s].y.push_back(10.0 * s + 2.0 * x + 0.3 * x * x);
+            series[s].weights.push_back(1.0 + i);
+        }
+    }
+    // 第一组加入一个零权重的离群点
+    series[0].x.push_back(3.0);
+    series[0].y.push_back(1000.0);
+    series[0].weights.push_back(0.0);
+
+    auto fits = dataProcessor->fitPolynomialBatch(series, 2);
+    ASSERT_EQ(fits.size(), series.size());
+    for (size_t s = 0; s < fits.size(); ++s) {
+        ASSERT_EQ(fits[s].coefficients.size(), 3u);
+        EXPECT_NEAR(fits[s].coefficients[0], 10.0 * s, 1e-8);
+        EXPECT_NEAR(fits[s].coefficients[1], 2.0, 1e-8);
+        EXPECT_NEAR(fits[s].coefficients[2], 0.3, 1e-8);
+        EXPECT_NEAR(fits[s].rSquared, 1.0, 1e-10);
+    }
+
+    std::vector<std::vector<double>> ySeries = {series[1].y, series[2].y};
+    auto shared = dataProcessor->fitPolynomialBatch(series[1].x, ySeries, 2);
+    ASSERT_EQ(shared.size(), 2u);
+    EXPECT_NEAR(shared[1].coefficients[0], 20.0, 1e-8);
+}
+
+// 测试K-means++聚类：全量与mini-batch均能分出三个工况，且结果与线程数无关
+TEST_F(DataProcessorAlgorithmTest, KMeansSeparatesOperatingRegimes) {
+    std::vector<MeasurementData> data;
+    std::mt19937 gen(5);
+    std::normal_distribution<> noise(0.0, 1.0);
+    const double centers[3][2] = {{20.0, 100.0}, {60.0, 200.0}, {100.0, 150.0}};
+    for (int i = 0; i < 30000; i++) {
+        const auto& c = centers[i % 3];
+        SensorData sensorData;
+        sensorData.capacitance = c[1] + noise(gen);
+        data.emplace_back(c[0] + noise(gen), 0.0, sensorData);
+    }
+
+    std::vector<DataField> features = {DataField::HEIGHT, DataField::CAPACITANCE};
+
+    ClusteringOptions options;
+    options.numThreads = 1;
+    auto serial = dataProcessor->performKMeans(data, 3, features, options);
+    options.numThreads = 4;
+    auto parallel = dataProcessor->performKMeans(data, 3, features, options);
+
+    ASSERT_EQ(serial.centroids.size(), 3u);
+    EXPECT_EQ(serial.labels, parallel.labels);
+    for (size_t size : serial.clusterSizes) {
+        EXPECT_EQ(size, 10000u);
+    }
+    // 同一工况的记录应落在同一簇
+    for (size_t i = 3; i < data.size(); ++i) {
+        EXPECT_EQ(serial.labels[i], serial.labels[i % 3]);
+    }
+
+    options.miniBatchSize = 512;
+    options.normalization = NormalizationMethod::MIN_MAX;
+    auto miniBatch = dataProcessor->performKMeans(data, 3, features, options);
+    ASSERT_EQ(miniBatch.centroids.size(), 3u);
+    for (const auto& centroid : miniBatch.centroids) {
+        double best = 1e9;
+        for (const auto& c : centers) {
+            best = std::min(best, std::hypot(centroid[0] - c[0], centroid[1] - c[1]));
+        }
+        EXPECT_LT(best, 1.0);
+    }
+
+    auto groups = dataProcessor->performClustering(data, 3, features);
+    ASSERT_EQ(groups.size(), 3u);
+    for (const auto& group : groups) {
+        EXPECT_EQ(group.size(), 10000u);
+    }
+}
+
+// 测试归一化、时间序列、导数、积分和分组的单次遍历实现
+TEST_F(DataProcessorAlgorithmTest, ColumnKernels) {
+    std::vector<MeasurementData> data;
+    for (int i = 0; i <= 100; i++) {
+        double x = 10.0 + i * 0.5;
+        SensorData sensorData;
+        sensorData.capacitance = x * x;
+        MeasurementData m(x, 0.0, sensorData);
+        m.setTimestamp(1000 + i * 10);
+        data.push_back(m);
+    }
+
+    auto minMax = dataProcessor->normalizeData(data, NormalizationMethod::MIN_MAX);
+    EXPECT_DOUBLE_EQ(minMax.front().getSetHeight(), 0.0);
+    EXPECT_DOUBLE_EQ(minMax.back().getSetHeight(), 1.0);
+    // 理论电容不由归一化后的值重算
+    EXPECT_DOUBLE_EQ(minMax[40].getTheoreticalCapacitance(), data[40].getTheoreticalCapacitance());
+    auto zScore = dataProcessor->normalizeData(data, NormalizationMethod::Z_SCORE);
+    EXPECT_NEAR(zScore[50].getSetHeight(), 0.0, 1e-12);
+    EXPECT_LT(zScore.front().getSetHeight(), 0.0);
+
+    auto timeSeries = dataProcessor->analyzeTimeSeries(data);
+    EXPECT_NEAR(timeSeries.samplingRate, 100.0, 1e-9);
+    EXPECT_NEAR(timeSeries.totalDuration, 1.0, 1e-12);
+    EXPECT_TRUE(timeSeries.isUniform);
+
+    // d(x²)/dx = 2x，二阶导数为2
+    auto derivative = dataProcessor->calculateDerivative(data, DataField::HEIGHT, DataField::CAPACITANCE);
+    ASSERT_EQ(derivative.size(), data.size());
+    for (size_t i = 1; i + 1 < derivative.size(); ++i) {
+        EXPECT_NEAR(derivative[i].value, 2.0 * derivative[i].x, 1e-9);
+        EXPECT_NEAR(derivative[i].secondDerivative, 2.0, 1e-9);
+    }
+
+    // ∫x²dx 在 [10, 60]，Simpson对二次函数精确
+    double exact = (60.0 * 60.0 * 60.0 - 10.0 * 10.0 * 10.0) / 3.0;
+    EXPECT_NEAR(dataProcessor->calculateIntegral(data, DataField::HEIGHT, DataField::CAPACITANCE,
+                                                 IntegrationMethod::SIMPSON), exact, 1e-6);
+    // 梯形法误差为 (b-a)·h²/12·f'' ≈ 2.083
+    EXPECT_NEAR(dataProcessor->calculateIntegral(data, DataField::HEIGHT, DataField::CAPACITANCE),
+                exact + 50.0 * 0.25 / 12.0 * 2.0, 1e-6);
+
+    auto groups = dataProcessor->groupData(data, [](const MeasurementData& m) {
+        return m.getSetHeight() < 35.0 ? std::string("Low") : std::string("High");
+    });
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups["Low"].size(), 50u);
+    EXPECT_EQ(groups["High"].size(), 51u);
+}
+
+// 测试样条重采样到均匀网格
+TEST_F(DataProcessorAlgorithmTest, SplineResampling) {
+    std::vector<MeasurementData> data;
+    for (int i = 0; i < 200; i++) {
+        double x = 5.0 + i * 0.7 + 0.2 * std::sin(i);   // 非均匀节点
+        SensorData sensorData;
+        sensorData.capacitance = 100.0 + 10.0 * std::sin(x / 10.0);
+        data.emplace_back(x, 0.0, sensorData);
+    }
+
+    for (auto method : {InterpolationMethod::SPLINE, InterpolationMethod::CUBIC, InterpolationMethod::LINEAR}) {
+        auto resampled = dataProcessor->interpolateData(data, DataField::HEIGHT, DataField::CAPACITANCE,
+                                                        method, 1000);
+        ASSERT_EQ(resampled.size(), 1000u);
+        double step = resampled[1].getSetHeight() - resampled[0].getSetHeight();
+        for (size_t i = 1; i < resampled.size(); ++i) {
+            double x = resampled[i].getSetHeight();
+            EXPECT_NEAR(x - resampled[i - 1].getSetHeight(), step, 1e-9);
+            double expected = 100.0 + 10.0 * std::sin(x / 10.0);
+            double tolerance = 1e-2;
+            if (method == InterpolationMethod::SPLINE) {
+                // 自然边界条件只在两端引入误差
+                tolerance = (i > 50 && i < 950) ? 1e-5 : 5e-3;
+            } else if (method == InterpolationMethod::CUBIC) {
+                tolerance = 0.1;
+            }
+            EXPECT_NEAR(resampled[i].getSensorData().capacitance, expected, tolerance);
+        }
+    }
+}
+
+// 测试散乱数据网格化：输出尺寸有界，空缺单元被插值填充
+TEST_F(DataProcessorAlgorithmTest, SurfaceGridding) {
+    std::vector<MeasurementData> data;
+    std::mt19937 gen(21);
+    std::uniform_real_distribution<> heightDist(10.0, 90.0);
+    std::uniform_real_distribution<> angleDist(-20.0, 20.0);
+    for (int i = 0; i < 20000; i++) {
+        double h = heightDist(gen);
+        double a = angleDist(gen);
+        if (h > 40.0 && h < 60.0 && a > -5.0 && a < 5.0) continue;  // 留出未测区域
+        SensorData sensorData;
+        sensorData.capacitance = 2.0 * h + a;
+        data.emplace_back(h, a, sensorData);
+    }
+
+    SurfaceGridOptions options;
+    options.xResolution = 40;
+    options.yResolution = 20;
+    auto surface = dataProcessor->prepare3DSurfaceData(data, DataField::HEIGHT, DataField::ANGLE,
+                                                       DataField::CAPACITANCE, options);
+
+    ASSERT_EQ(surface.xGrid.size(), 40u);
+    ASSERT_EQ(surface.yGrid.size(), 20u);
+    ASSERT_EQ(surface.zValues.size(), 20u);
+    for (size_t row = 0; row < surface.yGrid.size(); ++row) {
+        ASSERT_EQ(surface.zValues[row].size(), 40u);
+        for (size_t col = 0; col < surface.xGrid.size(); ++col) {
+            double expected = 2.0 * surface.xGrid[col] + surface.yGrid[row];
+            EXPECT_NEAR(surface.zValues[row][col], expected, 12.0);
+        }
+    }
+
+    // 规则扫描：坐标直接作为网格
+    std::vector<MeasurementData> regular;
+    for (int h = 0; h < 5; h++) {
+        for (int a = 0; a < 3; a++) {
+            SensorData sensorData;
+            sensorData.capacitance = h * 10.0 + a;
+            regular.emplace_back(20.0 + h * 10.0, a * 5.0, sensorData);
+        }
+    }
+    auto exact = dataProcessor->prepare3DSurfaceData(regular, DataField::HEIGHT, DataField::ANGLE,
+                                                     DataField::CAPACITANCE);
+    ASSERT_EQ(exact.xGrid.size(), 5u);
+    ASSERT_EQ(exact.yGrid.size(), 3u);
+    EXPECT_DOUBLE_EQ(exact.xGrid[1], 30.0);
+    EXPECT_DOUBLE_EQ(exact.zValues[2][4], 42.0);
+}
+
+// 测试单次遍历统计与相关矩阵
+TEST_F(DataProcessorAlgorithmTest, StatisticsAndCorrelationMatrix) {
+    std::vector<MeasurementData> data;
+    std::mt19937 gen(4);
+    std::normal_distribution<> noise(0.0, 1.0);
+    std::vector<double> heights;
+    for (int i = 0; i < 200000; i++) {
+        double h = 20.0 + (i % 100) * 0.5;
+        SensorData sensorData;
+        sensorData.capacitance = 3.0 * h + noise(gen);
+        sensorData.temperature = 25.0 + noise(gen);
+        sensorData.distanceUpper1 = 150.0 - h;
+        data.emplace_back(h, 0.0, sensorData);
+        heights.push_back(h);
+    }
+
+    auto stats = dataProcessor->calculateStatistics(data);
+    EXPECT_EQ(stats.dataCount, 200000);
+    EXPECT_NEAR(stats.meanHeight, 44.75, 1e-9);
+    EXPECT_NEAR(stats.variance, StatisticsUtils::variance(heights), 1e-8);
+    EXPECT_DOUBLE_EQ(stats.minHeight, 20.0);
+    EXPECT_DOUBLE_EQ(stats.maxHeight, 69.5);
+    EXPECT_DOUBLE_EQ(stats.median, 44.75);
+    EXPECT_NEAR(stats.meanTemperature, 25.0, 0.01);
+
+    auto matrix = dataProcessor->calculateCorrelationMatrix(data);
+    ASSERT_EQ(matrix.fields.size(), 8u);
+    EXPECT_EQ(matrix.sampleCount, data.size());
+    EXPECT_DOUBLE_EQ(matrix.at(0, 0), 1.0);
+    EXPECT_GT(matrix.at(0, 2), 0.99);                 // 高度-电容
+    EXPECT_NEAR(matrix.at(0, 4), -1.0, 1e-12);        // 高度-上传感器1
+    EXPECT_NEAR(matrix.at(0, 3), 0.0, 0.02);          // 高度-温度
+    EXPECT_DOUBLE_EQ(matrix.at(2, 0), matrix.at(0, 2));
+    EXPECT_DOUBLE_EQ(matrix.at(0, 5), 0.0);           // 常数列
+    EXPECT_NEAR(dataProcessor->calculateCorrelation(data, DataField::HEIGHT, DataField::CAPACITANCE),
+                matrix.at(0, 2), 1e-12);
+}
+
+// 测试并行执行策略：结果与顺序执行一致，支持进度回调和取消
+TEST_F(DataProcessorAlgorithmTest, ParallelExecutionPolicy) {
+    std::vector<MeasurementData> data;
+    std::mt19937 gen(8);
+    std::normal_distribution<> noise(0.0, 0.5);
+    for (int i = 0; i < 100000; i++) {
+        double h = 20.0 + (i % 500) * 0.1;
+        SensorData sensorData;
+        sensorData.capacitance = 2.0 * h + 5.0 + noise(gen);
+        sensorData.temperature = 25.0 + noise(gen);
+        if (i % 10007 == 0) sensorData.temperature += 10.0;
+        data.emplace_back(h, 0.0, sensorData);
+    }
+
+    ExecutionPolicy sequential;
+    sequential.parallel = false;
+    sequential.chunkSize = 4096;
+    dataProcessor->setExecutionPolicy(sequential);
+    auto statsSeq = dataProcessor->calculateStatistics(data);
+    auto regSeq = dataProcessor->performLinearRegression(data, DataField::HEIGHT, DataField::CAPACITANCE);
+    auto outliersSeq = dataProcessor->detectOutliers(data, DataField::TEMPERATURE, 6.0);
+
+    ExecutionPolicy parallel = sequential;
+    parallel.parallel = true;
+    parallel.maxThreads = 4;
+    std::atomic<size_t> lastProgress{0};
+    parallel.progress = [&](size_t completed, size_t total) {
+        EXPECT_LE(completed, total);
+        lastProgress = completed;
+    };
+    dataProcessor->setExecutionPolicy(parallel);
+    auto statsPar = dataProcessor->calculateStatistics(data);
+    EXPECT_EQ(lastProgress.load(), (data.size() + 4095) / 4096);
+    auto regPar = dataProcessor->performLinearRegression(data, DataField::HEIGHT, DataField::CAPACITANCE);
+    auto outliersPar = dataProcessor->detectOutliers(data, DataField::TEMPERATURE, 6.0);
+
+    // 块划分相同，合并顺序相同，结果逐位一致
+    EXPECT_EQ(statsPar.meanCapacitance, statsSeq.meanCapacitance);
+    EXPECT_EQ(statsPar.stdDevCapacitance, statsSeq.stdDevCapacitance);
+    EXPECT_EQ(regPar.slope, regSeq.slope);
+    EXPECT_EQ(regPar.rSquared, regSeq.rSquared);
+    EXPECT_NEAR(regPar.slope, 2.0, 0.01);
+    EXPECT_EQ(outliersPar, outliersSeq);
+    EXPECT_EQ(outliersPar.size(), 10u);
+
+    parallel.cancellation.cancel();
+    dataProcessor->setExecutionPolicy(parallel);
+    EXPECT_EQ(dataProcessor->calculateStatistics(data).dataCount, 0);
+    EXPECT_TRUE(dataProcessor->detectOutliers(data, DataField::TEMPERATURE, 6.0).empty());
+}
+
+// 测试编译期字段访问与运行期分派一致
+TEST_F(DataProcessorAlgorithmTest, CompileTimeFieldAccess) {
+    SensorData sensorData;
+    sensorData.capacitance = 12.5;
+    sensorData.distanceLower2 = 7.0;
+    std::vector<MeasurementData> data(3, MeasurementData(30.0, 5.0, sensorData));
+
+    EXPECT_DOUBLE_EQ(getField(data[0], FieldTag<DataField::CAPACITANCE>{}), 12.5);
+    EXPECT_DOUBLE_EQ(FieldAccessor<DataField::HEIGHT>::get(data[0]), 30.0);
+
+    setField(data[1], 20.0, FieldTag<DataField::CAPACITANCE>{});
+    std::vector<double> column(data.size());
+    gatherField(DataField::CAPACITANCE, data.data(), data.size(), column.data());
+    EXPECT_EQ(column, (std::vector<double>{12.5, 20.0, 12.5}));
+
+    double lower = dispatchField(DataField::LOWER_SENSOR_2,
+                                 [&](auto tag) { return getField(data[2], tag); });
+    EXPECT_DOUBLE_EQ(lower, 7.0);
+
+    auto chart = dataProcessor->prepareScatterPlotData(data, DataField::ANGLE, DataField::CAPACITANCE);
+    EXPECT_EQ(chart.yValues, column);
+    EXPECT_DOUBLE_EQ(chart.xValues[0], 5.0);
+}
+
+// 测试FFT互相关与直接求和一致
+TEST_F(DataProcessorAlgorithmTest, CrossCorrelationMatchesDirectSum) {
+    std::mt19937 gen(17);
+    std::normal_distribution<> dist(0.0, 1.0);
+    std::vector<double> x(37), y(37);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = dist(gen);
+        y[i] = dist(gen);
+    }
+
+    auto r = dataProcessor->crossCorrelation(x, y);
+    const int n = static_cast<int>(x.size());
+    ASSERT_EQ(r.size(), 2u * n - 1);
+    for (int k = -(n - 1); k < n; ++k) {
+        double expected = 0.0;
+        for (int t = 0; t < n; ++t) {
+            if (t + k >= 0 && t + k < n) expected += x[t] * y[t + k];
+        }
+        EXPECT_NEAR(r[k + n - 1], expected, 1e-9) << "lag " << k;
+    }
+}
+
+// 测试非均匀采样下的亚采样时滞估计和相干函数
+TEST_F(DataProcessorAlgorithmTest, ChannelLagEstimation) {
+    const double delay = 0.237;   // 电容响应滞后于设定高度(s)
+    auto command = [](double t) {
+        return 30.0 + 5.0 * std::sin(2.0 * M_PI * 0.31 * t) + 3.0 * std::sin(2.0 * M_PI * 0.87 * t + 1.0)
+             + 2.0 * std::sin(2.0 * M_PI * 1.93 * t + 2.0);
+    };
+
+    std::mt19937 gen(29);
+    std::uniform_int_distribution<int> jitter(-2, 2);
+    std::normal_distribution<> noise(0.0, 0.05);
+    std::vector<MeasurementData> data;
+    for (int i = 0; i < 6000; ++i) {
+        int64_t ms = i * 10 + jitter(gen);
+        double t = ms / 1000.0;
+        SensorData sensorData;
+        sensorData.capacitance = 2.0 * command(t - delay) + noise(gen);
+        sensorData.distanceUpper1 = -command(t - 0.05) + noise(gen);
+        MeasurementData m(command(t), 0.0, sensorData);
+        m.setTimestamp(ms);
+        data.push_back(m);
+    }
+
+    CrossCorrelationOptions options;
+    options.maxLagSeconds = 2.0;
+    options.coherence.segmentLength = 1024;
+    auto result = dataProcessor->analyzeChannelLags(
+        data, {DataField::HEIGHT, DataField::UPPER_SENSOR_1, DataField::CAPACITANCE}, options);
+
+    ASSERT_EQ(result.pairs.size(), 3u);
+    EXPECT_NEAR(result.samplingRate, 100.0, 0.1);
+
+    const ChannelLag* capacitance = result.find(DataField::HEIGHT, DataField::CAPACITANCE);
+    ASSERT_NE(capacitance, nullptr);
+    EXPECT_NEAR(capacitance->lagSeconds, delay, 0.005);
+    EXPECT_GT(capacitance->peakCorrelation, 0.95);
+
+    const ChannelLag* upper = result.find(DataField::HEIGHT, DataField::UPPER_SENSOR_1);
+    ASSERT_NE(upper, nullptr);
+    EXPECT_NEAR(upper->lagSeconds, 0.05, 0.005);
+    EXPECT_LT(upper->peakCorrelation, -0.95);
+
+    // 激励频点处相干接近1
+    size_t bin = static_cast<size_t>(std::round(0.87 / result.frequencies[1]));
+    EXPECT_GT(capacitance->coherence[bin], 0.9);
+    EXPECT_EQ(capacitance->coherence.size(), result.frequencies.size());
+}
+
+// 测试按模型参数批量计算理论电容的误差分析
+TEST_F(DataProcessorAlgorithmTest, CapacitanceErrorAgainstModel) {
+    CapacitorParameters parameters;
+    parameters.parasiticCapacitance = 2.0;
+    parameters.distanceOffset = 0.3;
+
+    std::vector<MeasurementData> data;
+    for (int i = 0; i < 100; ++i) {
+        double h = 5.0 + i * 0.5;
+        SensorData sensorData;
+        sensorData.capacitance = CapacitanceCalibrator::model(parameters, h, 10.0) + (i % 2 ? 0.1 : -0.1);
+        data.emplace_back(h, 10.0, sensorData);
+    }
+
+    auto error = dataProcessor->analyzeCapacitanceError(data, parameters);
+    ASSERT_EQ(error.errors.size(), data.size());
+    EXPECT_NEAR(error.meanError, 0.0, 1e-9);
+    EXPECT_NEAR(error.rootMeanSquareError, 0.1, 1e-9);
+}
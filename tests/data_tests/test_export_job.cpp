@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "data/include/export_manager.h"
+#include "utils/include/logger.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string readFile(const fs::path& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+// 每块之间暂停的数据源，并统计遍历次数
+class SlowSource : public MeasurementSource {
+public:
+    SlowSource(const std::vector<MeasurementData>& data, int delayMs) : data(data), delayMs(delayMs) {}
+
+    size_t size() const override { return data.size(); }
+
+    bool forEachChunk(const ChunkVisitor& visitor) const override {
+        passes++;
+        for (size_t begin = 0; begin < data.size(); begin += 100) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+            if (!visitor(data.data() + begin, std::min<size_t>(100, data.size() - begin))) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    mutable std::atomic<int> passes{0};
+
+private:
+    std::vector<MeasurementData> data;
+    int delayMs;
+};
+
+// 只提供前delivered条记录的数据源，size()仍报告全部记录数
+class TruncatedSource : public MeasurementSource {
+public:
+    TruncatedSource(const std::vector<MeasurementData>& data, size_t delivered, bool reportsStop)
+        : data(data), delivered(delivered), reportsStop(reportsStop) {}
+
+    size_t size() const override { return data.size(); }
+
+    bool forEachChunk(const ChunkVisitor& visitor) const override {
+        visitor(data.data(), std::min(delivered, data.size()));
+        return !reportsStop;
+    }
+
+private:
+    std::vector<MeasurementData> data;
+    size_t delivered;
+    bool reportsStop;
+};
+}
+
+class ExportJobTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        testDir = fs::temp_directory_path() / "cdc_export_job_test";
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::vector<MeasurementData> makeData(size_t count) {
+        std::vector<double> heights(count), angles(count);
+        std::vector<SensorData> sensors(count);
+        for (size_t i = 0; i < count; ++i) {
+            heights[i] = 10.0 + static_cast<double>(i % 50);
+            angles[i] = static_cast<double>(i % 5) - 2.0;
+            sensors[i].setCapacitance(100.0 + 0.01 * static_cast<double>(i));
+        }
+        auto data = MeasurementData::createBatch(heights, angles, sensors);
+        for (size_t i = 0; i < count; ++i) {
+            data[i].setTimestamp(1700000000000LL + static_cast<int64_t>(i) * 100);
+        }
+        return data;
+    }
+
+    fs::path testDir;
+};
+
+// 测试CSV、JSON和统计摘要共用一次读取遍历，结果与同步导出一致
+TEST_F(ExportJobTest, SharesOneReadPass) {
+    auto data = makeData(2000);
+    auto source = std::make_shared<SlowSource>(data, 0);
+
+    ExportManager manager;
+    std::vector<std::string> completed;
+    std::mutex completedMutex;
+    manager.setCompletionCallback([&](const ExportStatistics& stats) {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completed.push_back(stats.filename);
+    });
+
+    std::vector<ExportTarget> targets(3);
+    targets[0].filename = (testDir / "job.csv").string();
+    targets[0].options.chunkRecords = 128;
+    targets[1].filename = (testDir / "job.json").string();
+    targets[1].options.format = ExportFormat::JSON;
+    targets[2].filename = (testDir / "job.txt").string();
+    targets[2].statistics = true;
+
+    auto job = manager.submitExport(source, targets);
+    ASSERT_EQ(job->wait(), ExportJobStatus::COMPLETED) << job->getError();
+    EXPECT_TRUE(job->isFinished());
+    EXPECT_EQ(source->passes.load(), 1);
+    EXPECT_EQ(job->getProgress(), 100);
+    EXPECT_EQ(completed.size(), 3u);
+
+    auto stats = job->getStatistics();
+    ASSERT_EQ(stats.size(), 3u);
+    size_t totalBytes = 0;
+    for (const auto& s : stats) {
+        EXPECT_EQ(s.fileSize, fs::file_size(s.filename));
+        totalBytes += s.fileSize;
+    }
+    EXPECT_EQ(job->getBytesWritten(), totalBytes);
+    EXPECT_EQ(stats[0].exportedRecords, 2000);
+
+    ASSERT_TRUE(manager.exportData(data, (testDir / "sync.csv").string(), targets[0].options));
+    EXPECT_EQ(readFile(testDir / "job.csv"), readFile(testDir / "sync.csv"));
+    ASSERT_TRUE(manager.exportData(data, (testDir / "sync.json").string(), targets[1].options));
+    EXPECT_EQ(readFile(testDir / "job.json"), readFile(testDir / "sync.json"));
+    ASSERT_TRUE(manager.exportStatistics(data, (testDir / "sync.txt").string()));
+    EXPECT_EQ(readFile(testDir / "job.txt"), readFile(testDir / "sync.txt"));
+}
+
+// 测试取消与失败
+TEST_F(ExportJobTest, CancelAndFailure) {
+    ExportManager manager;
+    auto source = std::make_shared<SlowSource>(makeData(5000), 5);
+
+    ExportTarget target;
+    target.filename = (testDir / "slow.csv").string();
+    target.options.chunkRecords = 100;
+    auto job = manager.submitExport(source, {target});
+    EXPECT_FALSE(job->waitFor(20));
+    job->cancel();
+    EXPECT_EQ(job->wait(), ExportJobStatus::CANCELLED);
+    EXPECT_LT(job->getProgress(), 100);
+
+    target.filename = (testDir / "missing" / "data.csv").string();
+    auto failed = manager.submitExport(makeData(10), {target});
+    EXPECT_EQ(failed->wait(), ExportJobStatus::FAILED);
+    EXPECT_FALSE(failed->getError().empty());
+
+    auto empty = manager.submitExport(std::shared_ptr<const MeasurementSource>(), {target});
+    EXPECT_EQ(empty->getStatus(), ExportJobStatus::FAILED);
+}
+
+// 测试数据源未提供全部记录时任务失败并给出原因
+TEST_F(ExportJobTest, TruncatedSourceFails) {
+    ExportManager manager;
+    ExportTarget target;
+    target.filename = (testDir / "truncated.csv").string();
+
+    for (bool reportsStop : {true, false}) {
+        auto job = manager.submitExport(std::make_shared<TruncatedSource>(makeData(500), 200, reportsStop),
+                                        {target});
+        EXPECT_EQ(job->wait(), ExportJobStatus::FAILED) << "reportsStop=" << reportsStop;
+        EXPECT_NE(job->getError().find("200 of 500"), std::string::npos) << job->getError();
+        EXPECT_TRUE(job->getStatistics().empty());
+    }
+}
+
+// 测试ExportManager析构时取消并等待未完成的任务
+TEST_F(ExportJobTest, DestructorCancelsJobs) {
+    auto source = std::make_shared<SlowSource>(makeData(5000), 5);
+    std::shared_ptr<ExportJob> job;
+    {
+        ExportManager manager;
+        ExportTarget target;
+        target.filename = (testDir / "pending.csv").string();
+        job = manager.submitExport(source, {target});
+    }
+    EXPECT_TRUE(job->isFinished());
+    EXPECT_EQ(job->getStatus(), ExportJobStatus::CANCELLED);
+}
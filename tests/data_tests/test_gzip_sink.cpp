@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "data/include/gzip_sink.h"
+#include "data/include/export_manager.h"
+#include "utils/include/logger.h"
+#include <zlib.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+class MemorySink : public ByteSink {
+public:
+    bool write(const char* data, size_t size) override {
+        content.append(data, size);
+        return true;
+    }
+    bool close() override {
+        closed = true;
+        return true;
+    }
+    size_t bytesWritten() const override { return content.size(); }
+
+    std::string content;
+    bool closed = false;
+};
+
+// 用zlib解压gzip数据（含头部与CRC、长度校验），失败返回false
+bool gunzip(const std::string& compressed, std::string& out) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) return false;
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    char buffer[65536];
+    int result = Z_OK;
+    out.clear();
+    while (result == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    bool complete = result == Z_STREAM_END && stream.avail_in == 0;
+    inflateEnd(&stream);
+    return complete;
+}
+
+std::string makeText(size_t size) {
+    std::mt19937 rng(3);
+    std::string text;
+    while (text.size() < size) {
+        text += "2024-03-01 12:00:00," + std::to_string(rng() % 100000) + "," +
+                std::to_string(rng() % 1000) + ".25\r\n";
+    }
+    text.resize(size);
+    return text;
+}
+
+std::string compress(const std::string& text, const GzipOptions& options, size_t writeSize) {
+    auto memory = std::make_unique<MemorySink>();
+    MemorySink* raw = memory.get();
+    GzipSink sink(std::move(memory), options);
+    for (size_t pos = 0; pos < text.size(); pos += writeSize) {
+        EXPECT_TRUE(sink.write(text.data() + pos, std::min(writeSize, text.size() - pos)));
+    }
+    EXPECT_TRUE(sink.close());
+    EXPECT_TRUE(raw->closed);
+    EXPECT_EQ(sink.bytesConsumed(), text.size());
+    return raw->content;
+}
+}
+
+// 测试单线程与分块并行压缩都能被标准gzip解码还原
+TEST(GzipSinkTest, RoundTrips) {
+    const std::string text = makeText(3 * 1024 * 1024 + 12345);
+
+    for (size_t threads : {1, 2, 4}) {
+        for (int level : {0, 1, 6}) {
+            GzipOptions options;
+            options.threads = threads;
+            options.level = level;
+            std::string compressed = compress(text, options, 70000);
+            std::string restored;
+            ASSERT_TRUE(gunzip(compressed, restored)) << "threads=" << threads << " level=" << level;
+            EXPECT_EQ(restored, text);
+            if (level > 0) {
+                EXPECT_LT(compressed.size(), text.size() / 2);
+            }
+        }
+    }
+
+    // 块间预置字典：并行压缩的压缩比接近单线程
+    GzipOptions single;
+    GzipOptions parallel;
+    parallel.threads = 4;
+    double ratio = static_cast<double>(compress(text, parallel, 1 << 20).size()) /
+                   static_cast<double>(compress(text, single, 1 << 20).size());
+    EXPECT_LT(ratio, 1.05);
+
+    // 空输入
+    for (size_t threads : {1, 3}) {
+        GzipOptions options;
+        options.threads = threads;
+        std::string restored = "x";
+        ASSERT_TRUE(gunzip(compress("", options, 1), restored));
+        EXPECT_TRUE(restored.empty());
+    }
+}
+
+// 测试ExportManager在写出过程中压缩，解压结果与未压缩导出一致
+TEST(GzipSinkTest, CompressedExport) {
+    Logger::getInstance().enableConsoleOutput(false);
+    fs::path dir = fs::temp_directory_path() / "cdc_gzip_export_test";
+    fs::create_directories(dir);
+
+    std::vector<double> heights(20000), angles(20000);
+    std::vector<SensorData> sensors(20000);
+    for (size_t i = 0; i < heights.size(); ++i) {
+        heights[i] = 10.0 + static_cast<double>(i % 40);
+        angles[i] = static_cast<double>(i % 9) - 4.0;
+        sensors[i].setCapacitance(100.0 + 0.01 * static_cast<double>(i));
+    }
+    auto data = MeasurementData::createBatch(heights, angles, sensors);
+
+    auto readFile = [](const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream oss;
+        oss << file.rdbuf();
+        return oss.str();
+    };
+
+    ExportManager manager;
+    ExportOptions options;
+    ASSERT_TRUE(manager.exportData(data, (dir / "plain.csv").string(), options));
+
+    options.compress = true;
+    options.compressionThreads = 2;
+    options.compressionLevel = 1;
+    ASSERT_TRUE(manager.exportData(data, (dir / "data.csv.gz").string(), options));
+    EXPECT_EQ(manager.getLastExportStatistics().fileSize, fs::file_size(dir / "data.csv.gz"));
+
+    std::string restored;
+    ASSERT_TRUE(gunzip(readFile(dir / "data.csv.gz"), restored));
+    EXPECT_EQ(restored, readFile(dir / "plain.csv"));
+    EXPECT_LT(fs::file_size(dir / "data.csv.gz"), fs::file_size(dir / "plain.csv") / 3);
+
+    // 统计摘要目标同样按options.compress压缩
+    std::vector<ExportTarget> targets(2);
+    targets[0].filename = (dir / "stats.txt").string();
+    targets[0].statistics = true;
+    targets[1].filename = (dir / "stats.txt.gz").string();
+    targets[1].statistics = true;
+    targets[1].options = options;
+    auto job = manager.submitExport(data, targets);
+    ASSERT_EQ(job->wait(), ExportJobStatus::COMPLETED) << job->getError();
+    EXPECT_EQ(job->getStatistics()[1].fileSize, fs::file_size(dir / "stats.txt.gz"));
+    ASSERT_TRUE(gunzip(readFile(dir / "stats.txt.gz"), restored));
+    EXPECT_EQ(restored, readFile(dir / "stats.txt"));
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,78 @@
+// tests/data_tests/test_spectrogram.cpp
+#include <gtest/gtest.h>
+#include "data/include/spectrogram.h"
+#include "utils/include/logger.h"
+#include <cmath>
+
+class SpectrogramTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+    }
+
+    static std::vector<double> sine(size_t count, double frequency, double fs) {
+        std::vector<double> values(count);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = 100.0 + std::sin(2 * M_PI * frequency * i / fs);
+        }
+        return values;
+    }
+};
+
+// 测试帧数与帧间隔
+TEST_F(SpectrogramTest, EmitsFramesEveryHop) {
+    StreamingSpectrogram spectrogram(1000.0, 256, 64);
+
+    std::vector<SpectrogramFrame> frames;
+    spectrogram.setFrameCallback([&frames](const SpectrogramFrame& frame) {
+        frames.push_back(frame);
+    });
+
+    auto values = sine(1000, 50.0, 1000.0);
+    for (double v : values) {
+        spectrogram.pushSample(v);
+    }
+
+    // 第一帧在第256个样本，此后每64个样本一帧
+    EXPECT_EQ(frames.size(), 1u + (1000u - 256u) / 64u);
+    EXPECT_EQ(spectrogram.getFrameCount(), frames.size());
+    ASSERT_FALSE(frames.empty());
+    EXPECT_EQ(frames.front().density.size(), 129u);
+    EXPECT_LT(frames.front().time, frames.back().time);
+}
+
+// 测试流式频谱定位共振频率
+TEST_F(SpectrogramTest, TracksDominantFrequency) {
+    StreamingSpectrogram spectrogram(1000.0, 512, 256);
+
+    auto values = sine(5000, 125.0, 1000.0);
+    spectrogram.pushSamples(values);
+
+    EXPECT_NEAR(spectrogram.getPeakFrequency(), 125.0, 1000.0 / 512);
+}
+
+// 测试从传感器数据取值
+TEST_F(SpectrogramTest, ConsumesSensorData) {
+    StreamingSpectrogram spectrogram(10.0, 8, 4);
+    spectrogram.setField(DataField::CAPACITANCE);
+
+    for (int i = 0; i < 8; ++i) {
+        SensorData data;
+        data.capacitance = (i % 2 == 0) ? 1.0 : -1.0;
+        spectrogram.pushSensorData(data);
+    }
+
+    EXPECT_EQ(spectrogram.getFrameCount(), 1u);
+    EXPECT_NEAR(spectrogram.getPeakFrequency(), 5.0, 1e-9); // 奈奎斯特频率
+}
+
+// 测试重置
+TEST_F(SpectrogramTest, Reset) {
+    StreamingSpectrogram spectrogram(1000.0, 64, 32);
+    spectrogram.pushSamples(sine(200, 50.0, 1000.0));
+    EXPECT_GT(spectrogram.getFrameCount(), 0u);
+
+    spectrogram.reset();
+    EXPECT_EQ(spectrogram.getFrameCount(), 0u);
+    EXPECT_TRUE(spectrogram.getAveragedDensity().empty());
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "models/include/capacitance_calibrator.h"
+#include "models/include/fringing_capacitance.h"
+#include "models/include/system_config.h"
+#include "models/include/physics_calculator.h"
+#include "utils/include/logger.h"
+#include <cmath>
+#include <random>
+
+class CapacitanceCalibratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        SystemConfig::getInstance().reset();
+        truth.plateArea = 2380.0;
+        truth.dielectricConstant = 1.0;
+        truth.parasiticCapacitance = 3.2;
+        truth.distanceOffset = 0.45;
+    }
+
+    void TearDown() override {
+        PhysicsCalculator::setFringingModel(nullptr);
+        SystemConfig::getInstance().reset();
+    }
+
+    void makeSweep(size_t count, double noise, std::vector<double>& d, std::vector<double>& a,
+                   std::vector<double>& c) {
+        std::mt19937 gen(13);
+        std::uniform_real_distribution<> height(2.0, 60.0);
+        std::uniform_real_distribution<> angle(-20.0, 20.0);
+        std::normal_distribution<> error(0.0, noise);
+        for (size_t i = 0; i < count; ++i) {
+            d.push_back(height(gen));
+            a.push_back(angle(gen));
+            c.push_back(CapacitanceCalibrator::model(truth, d.back(), a.back()) + error(gen));
+        }
+    }
+
+    CapacitorParameters truth;
+};
+
+// 测试无噪声数据上恢复全部参数
+TEST_F(CapacitanceCalibratorTest, RecoversParameters) {
+    std::vector<double> d, a, c;
+    makeSweep(2000, 0.0, d, a, c);
+
+    CapacitanceCalibrator calibrator;
+    ASSERT_TRUE(calibrator.setSweep(d, a, c));
+    CalibrationResult result = calibrator.calibrate(CapacitorParameters());
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.initialRmse, 1.0);
+    EXPECT_LT(result.rmse, 1e-6);
+    EXPECT_NEAR(result.parameters.plateArea, truth.plateArea, 1e-4);
+    EXPECT_NEAR(result.parameters.parasiticCapacitance, truth.parasiticCapacitance, 1e-6);
+    EXPECT_NEAR(result.parameters.distanceOffset, truth.distanceOffset, 1e-7);
+    EXPECT_DOUBLE_EQ(result.parameters.dielectricConstant, 1.0);
+}
+
+// 测试百万点带噪声扫描并写回系统配置
+TEST_F(CapacitanceCalibratorTest, LargeSweepWritesBackToConfig) {
+    std::vector<double> d, a, c;
+    makeSweep(1000000, 0.05, d, a, c);
+
+    CapacitanceCalibrator calibrator;
+    ASSERT_TRUE(calibrator.setSweep(d, a, c));
+
+    int notifications = 0;
+    SystemConfig& config = SystemConfig::getInstance();
+    config.setConfigChangeCallback([&]() { ++notifications; });
+    CalibrationResult result = calibrator.calibrate(config);
+    config.setConfigChangeCallback(nullptr);
+
+    ASSERT_TRUE(result.converged);
+    EXPECT_EQ(result.pointCount, 1000000u);
+    EXPECT_NEAR(result.rmse, 0.05, 0.001);
+    EXPECT_NEAR(result.parameters.plateArea, truth.plateArea, 2.0);
+    EXPECT_NEAR(result.parameters.distanceOffset, truth.distanceOffset, 0.002);
+    EXPECT_EQ(notifications, 1);
+    EXPECT_DOUBLE_EQ(config.getPlateArea(), result.parameters.plateArea);
+    EXPECT_DOUBLE_EQ(config.getParasiticCapacitance(), result.parameters.parasiticCapacitance);
+    EXPECT_DOUBLE_EQ(config.getDistanceOffset(), result.parameters.distanceOffset);
+}
+
+// 测试从测量记录构建扫描，固定参数保持不变
+TEST_F(CapacitanceCalibratorTest, MeasurementSweepWithFixedParameters) {
+    std::vector<MeasurementData> sweep;
+    for (int i = 0; i < 200; ++i) {
+        double h = 5.0 + i * 0.25;
+        SensorData sensorData;
+        sensorData.capacitance = CapacitanceCalibrator::model(truth, h, 0.0);
+        sweep.emplace_back(h, 0.0, sensorData);
+    }
+
+    CalibrationOptions options;
+    options.fitPlateArea = false;
+    options.fitDielectricConstant = true;
+    options.fitDistanceOffset = false;
+    CapacitanceCalibrator calibrator(options);
+    calibrator.setSweep(sweep);
+
+    CapacitorParameters initial;
+    initial.plateArea = truth.plateArea;
+    initial.distanceOffset = truth.distanceOffset;
+    CalibrationResult result = calibrator.calibrate(initial);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(result.parameters.dielectricConstant, 1.0, 1e-9);
+    EXPECT_NEAR(result.parameters.parasiticCapacitance, truth.parasiticCapacitance, 1e-8);
+    EXPECT_DOUBLE_EQ(result.parameters.plateArea, truth.plateArea);
+    EXPECT_DOUBLE_EQ(result.parameters.distanceOffset, truth.distanceOffset);
+}
+
+// 测试写回的寄生电容和距离偏差作用于理论电容与电容差值
+TEST_F(CapacitanceCalibratorTest, CalibrationAppliesToTheoreticalCapacitance) {
+    truth.plateArea = 2500.0;
+    std::vector<double> d, a, c;
+    makeSweep(2000, 0.0, d, a, c);
+
+    SensorData sensorData;
+    sensorData.capacitance = CapacitanceCalibrator::model(truth, 20.0, 5.0);
+    MeasurementData before(20.0, 5.0, sensorData);
+    EXPECT_GT(std::abs(before.getCapacitanceDifference()), 1.0);
+
+    CalibrationOptions options;
+    options.fitPlateArea = false;
+    CapacitanceCalibrator calibrator(options);
+    ASSERT_TRUE(calibrator.setSweep(d, a, c));
+    CalibrationResult result = calibrator.calibrate(SystemConfig::getInstance());
+    ASSERT_TRUE(result.converged);
+
+    EXPECT_DOUBLE_EQ(PhysicsCalculator::getParasiticCapacitance(), result.parameters.parasiticCapacitance);
+    EXPECT_DOUBLE_EQ(PhysicsCalculator::getDistanceOffset(), result.parameters.distanceOffset);
+    MeasurementData after(20.0, 5.0, sensorData);
+    EXPECT_NEAR(after.getTheoreticalCapacitance(), CapacitanceCalibrator::model(result.parameters, 20.0, 5.0), 1e-9);
+    EXPECT_NEAR(after.getCapacitanceDifference(), 0.0, 1e-6);
+
+    // 批量接口与逐条计算一致
+    double distances[] = {20.0, 35.0};
+    double angles[] = {5.0, 0.0};
+    double batch[2];
+    PhysicsCalculator::calculateTheoreticalCapacitance(distances, angles, 2, batch, 2500.0);
+    EXPECT_DOUBLE_EQ(batch[0], after.getTheoreticalCapacitance());
+    EXPECT_DOUBLE_EQ(batch[1], PhysicsCalculator::calculateTheoreticalCapacitance(2500.0, 35.0, 0.0));
+
+    SystemConfig::getInstance().reset();
+    EXPECT_DOUBLE_EQ(PhysicsCalculator::getParasiticCapacitance(), 0.0);
+    EXPECT_DOUBLE_EQ(MeasurementData(20.0, 5.0, sensorData).getCapacitanceDifference(),
+                     before.getCapacitanceDifference());
+}
+
+// 测试安装边缘场模型后拟合与理论电容使用同一修正系数，不重复计入
+TEST_F(CapacitanceCalibratorTest, CalibrationIncludesFringingFactor) {
+    FringingModelOptions fringingOptions;
+    fringingOptions.gapCount = 8;
+    fringingOptions.angleCount = 3;
+    fringingOptions.maxAngle = 20.0;
+    fringingOptions.maxCells = 256;
+    auto fringing = FringingCapacitanceModel::build(2500.0, 0.5, 150.0, 20.0, fringingOptions);
+    ASSERT_TRUE(fringing);
+    PhysicsCalculator::setFringingModel(fringing);
+
+    // 面积等于表格面积时与运行时的修正系数一致
+    truth.plateArea = 2500.0;
+    EXPECT_DOUBLE_EQ(fringing->scaledFactor(2500.0, 20.45, 5.0), fringing->factor(20.45, 5.0));
+    EXPECT_GT(CapacitanceCalibrator::model(truth, 20.0, 5.0) - truth.parasiticCapacitance,
+              PhysicsCalculator::calculateParallelPlateCapacitance(2500.0, 20.45, 5.0));
+
+    std::vector<double> d, a, c;
+    makeSweep(2000, 0.0, d, a, c);
+    CalibrationOptions options;
+    options.fitPlateArea = false;
+    CapacitanceCalibrator fixedArea(options);
+    ASSERT_TRUE(fixedArea.setSweep(d, a, c));
+    CalibrationResult result = fixedArea.calibrate(SystemConfig::getInstance());
+    ASSERT_TRUE(result.converged);
+    EXPECT_LT(result.rmse, 1e-6);
+    EXPECT_NEAR(result.parameters.parasiticCapacitance, truth.parasiticCapacitance, 1e-6);
+    EXPECT_NEAR(result.parameters.distanceOffset, truth.distanceOffset, 1e-6);
+
+    SensorData sensorData;
+    sensorData.capacitance = CapacitanceCalibrator::model(truth, 20.0, 5.0);
+    EXPECT_NEAR(MeasurementData(20.0, 5.0, sensorData).getCapacitanceDifference(), 0.0, 1e-6);
+
+    // 面积参与拟合时按相似换算修正系数，仍能恢复真实面积
+    truth.plateArea = 2380.0;
+    d.clear();
+    a.clear();
+    c.clear();
+    makeSweep(2000, 0.0, d, a, c);
+    CapacitanceCalibrator freeArea;
+    ASSERT_TRUE(freeArea.setSweep(d, a, c));
+    result = freeArea.calibrate(CapacitorParameters());
+    ASSERT_TRUE(result.converged);
+    EXPECT_LT(result.rmse, 1e-6);
+    EXPECT_NEAR(result.parameters.plateArea, truth.plateArea, 1e-3);
+    EXPECT_NEAR(result.parameters.parasiticCapacitance, truth.parasiticCapacitance, 1e-5);
+    EXPECT_NEAR(result.parameters.distanceOffset, truth.distanceOffset, 1e-6);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "models/include/csv_measurement_source.h"
+#include "utils/include/logger.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+class CsvMeasurementSourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        filename = (fs::temp_directory_path() / "cdc_csv_source_test.csv").string();
+    }
+
+    void TearDown() override {
+        fs::remove(filename);
+    }
+
+    std::string filename;
+};
+
+// 测试按块重读toCSV导出的文件，跳过无法解析的行
+TEST_F(CsvMeasurementSourceTest, ReadsExportedRowsInChunks) {
+    std::vector<MeasurementData> written;
+    {
+        std::ofstream file(filename);
+        file << MeasurementData::getCSVHeader() << "\n";
+        for (int i = 0; i < 25; ++i) {
+            SensorData sensor;
+            sensor.setUpperSensors(10.0 + i, 10.5 + i);
+            sensor.setLowerSensors(20.0 + i, 20.5 + i);
+            sensor.setTemperature(23.0);
+            sensor.setCapacitance(100.0 + i);
+            MeasurementData data(15.0 + i, 1.0, sensor);
+            data.setTimestamp(1700000000000LL + i * 1000);
+            written.push_back(data);
+            file << data.toCSV() << "\r\n";
+            if (i == 10) {
+                file << "broken,row\n\n";
+            }
+        }
+    }
+
+    CsvMeasurementSource source(filename, 10);
+    ASSERT_TRUE(source.isOpen());
+    EXPECT_EQ(source.size(), 26u);
+
+    std::vector<size_t> chunkSizes;
+    std::vector<MeasurementData> read;
+    source.forEachChunk([&](const MeasurementData* rows, size_t count) {
+        chunkSizes.push_back(count);
+        read.insert(read.end(), rows, rows + count);
+        return true;
+    });
+
+    EXPECT_EQ(chunkSizes, (std::vector<size_t>{10, 10, 5}));
+    EXPECT_EQ(source.getSkippedRows(), 1u);
+    ASSERT_EQ(read.size(), written.size());
+    for (size_t i = 0; i < read.size(); ++i) {
+        EXPECT_EQ(read[i].getTimestamp(), written[i].getTimestamp());
+        EXPECT_NEAR(read[i].getSetHeight(), written[i].getSetHeight(), 1e-9);
+        EXPECT_NEAR(read[i].getSensorData().capacitance, written[i].getSensorData().capacitance, 1e-9);
+    }
+
+    // visitor返回false时提前结束
+    size_t visited = 0;
+    source.forEachChunk([&](const MeasurementData*, size_t) { return ++visited < 2; });
+    EXPECT_EQ(visited, 2u);
+
+    EXPECT_FALSE(CsvMeasurementSource(filename + ".missing").isOpen());
+}
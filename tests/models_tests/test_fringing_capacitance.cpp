@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "models/include/fringing_capacitance.h"
+#include "models/include/measurement_data.h"
+#include "models/include/physics_calculator.h"
+#include "models/include/system_config.h"
+#include "utils/include/logger.h"
+#include <cmath>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+// Palmer公式：二维平行板（宽W、间距g）的边缘场修正系数
+double palmerFactor(double width, double gap) {
+    const double pi = 3.14159265358979323846;
+    return 1.0 + gap / (pi * width) * (1.0 + std::log(2.0 * pi * width / gap));
+}
+}
+
+class FringingCapacitanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::getInstance().enableConsoleOutput(false);
+        SystemConfig::getInstance().reset();
+        cacheDir = fs::temp_directory_path() / "cdc_fringing_test";
+        fs::remove_all(cacheDir);
+        options.gapCount = 4;
+        options.angleCount = 3;
+        options.maxAngle = 20.0;
+        options.maxCells = 256;
+    }
+
+    void TearDown() override {
+        PhysicsCalculator::setFringingModel(nullptr);
+        SystemConfig::getInstance().reset();
+        fs::remove_all(cacheDir);
+    }
+
+    fs::path cacheDir;
+    FringingModelOptions options;
+};
+
+// 测试二维截面电容与Palmer公式一致
+TEST_F(FringingCapacitanceTest, CrossSectionMatchesPalmer) {
+    for (double gap : {2.0, 5.0, 10.0}) {
+        double factor = FringingCapacitanceModel::crossSectionCapacitance(50.0, gap, 0.0, 512) / (50.0 / gap);
+        EXPECT_NEAR(factor, palmerFactor(50.0, gap), 0.03 * palmerFactor(50.0, gap)) << "gap=" << gap;
+    }
+}
+
+// 测试修正系数随间距减小趋近于1，两板接触时无解
+TEST_F(FringingCapacitanceTest, FactorLimits) {
+    double small = FringingCapacitanceModel::crossSectionCapacitance(50.0, 1.0, 0.0, 512) / 50.0;
+    double large = FringingCapacitanceModel::crossSectionCapacitance(50.0, 10.0, 0.0, 512) / 5.0;
+    EXPECT_GT(small, 1.0);
+    EXPECT_LT(small, 1.06);
+    EXPECT_GT(large, small);
+
+    EXPECT_TRUE(std::isnan(FringingCapacitanceModel::crossSectionCapacitance(50.0, 5.0, 30.0)));
+    EXPECT_TRUE(std::isfinite(FringingCapacitanceModel::crossSectionCapacitance(50.0, 5.0, 5.0, 512)));
+}
+
+// 测试网格无法分辨最小间距时改用解析近似，且在分界两侧连续
+TEST_F(FringingCapacitanceTest, UnresolvedGapFallsBackContinuously) {
+    // 64个单元时网格间距约2.3，1的间距无法分辨
+    double coarse = FringingCapacitanceModel::crossSectionCapacitance(50.0, 1.0, 0.0, 64) / 50.0;
+    EXPECT_NEAR(coarse, palmerFactor(50.0, 1.0), 0.03 * palmerFactor(50.0, 1.0));
+
+    // 倾斜使最小间距逐渐减小，跨过网格分辨极限时电容单调增加且没有跳变
+    double previous = FringingCapacitanceModel::crossSectionCapacitance(50.0, 5.0, 0.0, 256);
+    for (double lowest = 4.0; lowest > 0.04; lowest *= 0.8) {
+        double angle = std::asin((5.0 - lowest) / 25.0) / 3.14159265358979323846 * 180.0;
+        double capacitance = FringingCapacitanceModel::crossSectionCapacitance(50.0, 5.0, angle, 256);
+        ASSERT_TRUE(std::isfinite(capacitance)) << "lowest=" << lowest;
+        EXPECT_GT(capacitance, previous) << "lowest=" << lowest;
+        EXPECT_LT(capacitance, 1.15 * previous) << "lowest=" << lowest;
+        previous = capacitance;
+    }
+}
+
+// 测试接触节点附近的查询不退回1，修正系数随间距连续变化
+TEST_F(FringingCapacitanceTest, FactorContinuousNearContact) {
+    options.gapCount = 8;
+    options.angleCount = 5;
+    options.maxAngle = 80.0;
+    auto model = FringingCapacitanceModel::build(2500.0, 0.5, 150.0, 80.0, options);
+    ASSERT_TRUE(model);
+
+    for (double angle : {0.0, 10.0, 45.0}) {
+        double previous = model->factor(0.5, angle);
+        for (double gap = 0.5; gap <= 150.0; gap *= 1.1) {
+            double value = model->factor(gap, angle);
+            ASSERT_TRUE(std::isfinite(value)) << "gap=" << gap << " angle=" << angle;
+            EXPECT_GT(value, 1.0) << "gap=" << gap << " angle=" << angle;
+            EXPECT_LT(std::abs(value / previous - 1.0), 0.2) << "gap=" << gap << " angle=" << angle;
+            previous = value;
+        }
+    }
+    EXPECT_GE(model->factor(10.0, 10.0), model->factor(10.0, 0.0));
+    EXPECT_GT(model->factor(30.0, 80.0), model->factor(30.0, 45.0));
+}
+
+// 测试表格写入缓存后按几何重新读取
+TEST_F(FringingCapacitanceTest, CacheRoundTrip) {
+    SystemConfig& config = SystemConfig::getInstance();
+    auto built = FringingCapacitanceModel::loadOrBuild(config, cacheDir.string(), options);
+    ASSERT_TRUE(built);
+    EXPECT_FALSE(built->isLoadedFromCache());
+    EXPECT_TRUE(fs::exists(cacheDir / built->cacheFileName()));
+    EXPECT_DOUBLE_EQ(built->getPlateArea(), config.getPlateArea());
+    EXPECT_DOUBLE_EQ(built->getMaxGap(), config.getMaxHeight());
+    EXPECT_DOUBLE_EQ(built->getMaxAngle(), 20.0);
+
+    auto cached = FringingCapacitanceModel::loadOrBuild(config, cacheDir.string(), options);
+    ASSERT_TRUE(cached);
+    EXPECT_TRUE(cached->isLoadedFromCache());
+    for (double gap : {0.7, 3.0, 25.0, 140.0}) {
+        for (double angle : {0.0, -4.0, 15.0}) {
+            EXPECT_DOUBLE_EQ(cached->factor(gap, angle), built->factor(gap, angle));
+        }
+        EXPECT_DOUBLE_EQ(built->factor(gap, 3.0), built->factor(gap, -3.0));
+    }
+    EXPECT_GE(built->factor(10.0, 0.0), 1.0);
+    EXPECT_GT(built->factor(100.0, 0.0), built->factor(10.0, 0.0));
+
+    ASSERT_TRUE(config.setPlateArea(1600.0));
+    auto other = FringingCapacitanceModel::loadOrBuild(config, cacheDir.string(), options);
+    ASSERT_TRUE(other);
+    EXPECT_FALSE(other->isLoadedFromCache());
+    EXPECT_NE(other->cacheFileName(), built->cacheFileName());
+
+    // 损坏的缓存文件被重新构建
+    fs::resize_file(cacheDir / other->cacheFileName(), 20);
+    auto rebuilt = FringingCapacitanceModel::loadOrBuild(config, cacheDir.string(), options);
+    ASSERT_TRUE(rebuilt);
+    EXPECT_FALSE(rebuilt->isLoadedFromCache());
+}
+
+// 测试测量数据的理论电容使用当前模型的修正系数
+TEST_F(FringingCapacitanceTest, MeasurementDataAppliesFactor) {
+    auto model = FringingCapacitanceModel::build(2500.0, 5.0, 50.0, 4.0, options);
+    ASSERT_TRUE(model);
+    double plain = PhysicsCalculator::calculateParallelPlateCapacitance(2500.0, 10.0, 2.0);
+
+    PhysicsCalculator::setFringingModel(model);
+    MeasurementData data(10.0, 2.0, SensorData());
+    EXPECT_DOUBLE_EQ(data.getTheoreticalCapacitance(), plain * model->factor(10.0, 2.0));
+    EXPECT_GT(data.getTheoreticalCapacitance(), plain);
+
+    auto batch = MeasurementData::createBatch({10.0, 0.0}, {2.0, 0.0}, {SensorData(), SensorData()});
+    EXPECT_DOUBLE_EQ(batch[0].getTheoreticalCapacitance(), data.getTheoreticalCapacitance());
+    EXPECT_DOUBLE_EQ(batch[1].getTheoreticalCapacitance(), 0.0);
+
+    // 极板面积不同的模型不生效
+    data.setPlateArea(1600.0);
+    EXPECT_DOUBLE_EQ(data.getTheoreticalCapacitance(),
+                     PhysicsCalculator::calculateParallelPlateCapacitance(1600.0, 10.0, 2.0));
+
+    PhysicsCalculator::setFringingModel(nullptr);
+    MeasurementData plainData(10.0, 2.0, SensorData());
+    EXPECT_DOUBLE_EQ(plainData.getTheoreticalCapacitance(), plain);
+}
+
+// 测试几何变化后重新安装与当前极板面积一致的表格
+TEST_F(FringingCapacitanceTest, ReinstalledWhenGeometryChanges) {
+    SystemConfig& config = SystemConfig::getInstance();
+    ASSERT_TRUE(FringingCapacitanceModel::ensureInstalled(config, cacheDir.string(), options));
+    auto installed = PhysicsCalculator::getFringingModel();
+    ASSERT_TRUE(installed);
+    EXPECT_TRUE(installed->matches(config, options));
+    EXPECT_GT(PhysicsCalculator::calculateTheoreticalCapacitance(2500.0, 10.0, 0.0),
+              PhysicsCalculator::calculateParallelPlateCapacitance(2500.0, 10.0, 0.0));
+
+    // 几何未变时不重新构建
+    ASSERT_TRUE(FringingCapacitanceModel::ensureInstalled(config, cacheDir.string(), options));
+    EXPECT_EQ(PhysicsCalculator::getFringingModel(), installed);
+
+    // 面积变化后旧表格失效，理论电容退回平行板公式，直到重新安装
+    ASSERT_TRUE(config.setPlateArea(1600.0));
+    EXPECT_FALSE(installed->matches(config, options));
+    EXPECT_DOUBLE_EQ(PhysicsCalculator::calculateTheoreticalCapacitance(1600.0, 10.0, 0.0),
+                     PhysicsCalculator::calculateParallelPlateCapacitance(1600.0, 10.0, 0.0));
+
+    ASSERT_TRUE(FringingCapacitanceModel::ensureInstalled(config, cacheDir.string(), options));
+    auto reinstalled = PhysicsCalculator::getFringingModel();
+    ASSERT_TRUE(reinstalled);
+    EXPECT_DOUBLE_EQ(reinstalled->getPlateArea(), 1600.0);
+    EXPECT_DOUBLE_EQ(PhysicsCalculator::calculateTheoreticalCapacitance(1600.0, 10.0, 0.0),
+                     PhysicsCalculator::calculateParallelPlateCapacitance(1600.0, 10.0, 0.0) *
+                         reinstalled->factor(10.0, 0.0));
+
+    // 恢复原几何时从缓存加载
+    ASSERT_TRUE(config.setPlateArea(2500.0));
+    ASSERT_TRUE(FringingCapacitanceModel::ensureInstalled(config, cacheDir.string(), options));
+    EXPECT_TRUE(PhysicsCalculator::getFringingModel()->isLoadedFromCache());
+}
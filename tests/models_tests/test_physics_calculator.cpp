@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "models/include/physics_calculator.h"
+#include "models/include/measurement_data.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+// 两个double之间相差的可表示数个数（ULP），NaN与NaN视为相等
+uint64_t ulpDistance(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<uint64_t>::max();
+    }
+    int64_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(double));
+    std::memcpy(&ib, &b, sizeof(double));
+    // 转为按数值单调的整数表示
+    if (ia < 0) ia = std::numeric_limits<int64_t>::min() - ia;
+    if (ib < 0) ib = std::numeric_limits<int64_t>::min() - ib;
+    return ia > ib ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib)
+                   : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia);
+}
+}
+
+// 测试批量电容计算与标量版本逐位一致（包括边界值和成段重复的角度）
+TEST(PhysicsCalculatorTest, BatchCapacitanceMatchesScalar) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> distance(-5.0, 200.0);
+    std::uniform_real_distribution<> angle(-90.0, 90.0);
+
+    const size_t count = 10007;
+    std::vector<double> d(count), a(count);
+    for (size_t i = 0; i < count; ++i) {
+        d[i] = distance(gen);
+        a[i] = (i / 37) % 3 == 0 ? angle(gen) : a[i > 0 ? i - 1 : 0];
+    }
+    d[0] = 0.0;
+    d[1] = -0.0;
+    d[2] = std::numeric_limits<double>::quiet_NaN();
+    d[3] = std::numeric_limits<double>::denorm_min();
+    a[4] = -0.0;
+    a[5] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> batch(count);
+    PhysicsCalculator::calculateParallelPlateCapacitance(d.data(), a.data(), count, batch.data(), 2380.0, 1.7);
+
+    uint64_t worst = 0;
+    for (size_t i = 0; i < count; ++i) {
+        double scalar = PhysicsCalculator::calculateParallelPlateCapacitance(2380.0, d[i], a[i], 1.7);
+        worst = std::max(worst, ulpDistance(batch[i], scalar));
+    }
+    EXPECT_EQ(worst, 0u);
+
+    // 不传角度时按0°计算，输出可以覆盖输入
+    std::vector<double> original = d;
+    PhysicsCalculator::calculateParallelPlateCapacitance(d.data(), nullptr, count, d.data(), 2500.0);
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(ulpDistance(d[i], PhysicsCalculator::calculateParallelPlateCapacitance(2500.0, original[i])), 0u)
+            << "index " << i;
+    }
+}
+
+// 测试批量角度计算与标量版本逐位一致
+TEST(PhysicsCalculatorTest, BatchAngleMatchesScalar) {
+    std::mt19937 gen(8);
+    std::uniform_real_distribution<> distance(0.0, 300.0);
+
+    const size_t count = 4096;
+    std::vector<double> d1(count), d2(count), batch(count);
+    for (size_t i = 0; i < count; ++i) {
+        d1[i] = distance(gen);
+        d2[i] = distance(gen);
+    }
+
+    PhysicsCalculator::calculateAngleFromSensors(d1.data(), d2.data(), count, 80.0, batch.data());
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(ulpDistance(batch[i], PhysicsCalculator::calculateAngleFromSensors(d1[i], d2[i], 80.0)), 0u)
+            << "index " << i;
+    }
+
+    PhysicsCalculator::calculateAngleFromSensors(d1.data(), d2.data(), count, 0.0, batch.data());
+    EXPECT_DOUBLE_EQ(batch[0], 0.0);
+}
+
+// 测试批量构造的测量数据与逐条构造一致
+TEST(PhysicsCalculatorTest, MeasurementBatchMatchesConstructor) {
+    std::vector<double> heights = {0.0, 5.0, 12.5, 80.0};
+    std::vector<double> angles = {0.0, 10.0, -30.0, 45.0};
+    std::vector<SensorData> sensors(heights.size());
+    sensors[2].capacitance = 4.2;
+
+    auto batch = MeasurementData::createBatch(heights, angles, sensors);
+    ASSERT_EQ(batch.size(), heights.size());
+    for (size_t i = 0; i < heights.size(); ++i) {
+        MeasurementData single(heights[i], angles[i], sensors[i]);
+        EXPECT_EQ(ulpDistance(batch[i].getTheoreticalCapacitance(), single.getTheoreticalCapacitance()), 0u);
+        EXPECT_DOUBLE_EQ(batch[i].getSetHeight(), heights[i]);
+        EXPECT_DOUBLE_EQ(batch[i].getSetAngle(), angles[i]);
+        EXPECT_DOUBLE_EQ(batch[i].getSensorData().capacitance, sensors[i].capacitance);
+        EXPECT_DOUBLE_EQ(batch[i].getPlateArea(), 2500.0);
+        EXPECT_GT(batch[i].getTimestamp(), 0);
+        EXPECT_DOUBLE_EQ(batch[i].getCapacitanceDifference(), single.getCapacitanceDifference());
+    }
+}
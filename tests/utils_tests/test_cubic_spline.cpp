@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "utils/include/cubic_spline.h"
+#include <cmath>
+
+// 测试样条通过所有节点，且对光滑函数误差很小
+TEST(CubicSplineTest, InterpolatesSmoothFunction) {
+    std::vector<double> x, y;
+    for (int i = 0; i <= 50; ++i) {
+        x.push_back(i * 0.1);
+        y.push_back(std::sin(x.back()));
+    }
+
+    CubicSpline spline;
+    ASSERT_TRUE(spline.build(x, y));
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(spline.evaluate(x[i]), y[i], 1e-12);
+    }
+    for (double xi = 0.5; xi < 4.5; xi += 0.037) {
+        EXPECT_NEAR(spline.evaluate(xi), std::sin(xi), 1e-5);
+    }
+}
+
+// 测试自然边界：对直线数据精确
+TEST(CubicSplineTest, ReproducesLinearData) {
+    std::vector<double> x = {0.0, 1.0, 3.0, 3.5, 7.0};
+    std::vector<double> y;
+    for (double xi : x) y.push_back(2.0 * xi - 1.0);
+
+    CubicSpline spline;
+    ASSERT_TRUE(spline.build(x, y));
+    EXPECT_NEAR(spline.evaluate(2.2), 3.4, 1e-12);
+    EXPECT_NEAR(spline.evaluate(-1.0), -3.0, 1e-12);  // 外推
+}
+
+// 测试批量求值（游标与二分查找结果一致）
+TEST(CubicSplineTest, BatchMatchesSingleEvaluation) {
+    std::vector<double> x, y;
+    for (int i = 0; i < 1000; ++i) {
+        x.push_back(i + 0.3 * std::sin(i));
+        y.push_back(std::cos(i * 0.01));
+    }
+    CubicSpline spline;
+    ASSERT_TRUE(spline.build(x, y));
+
+    std::vector<double> query;
+    for (double q = -5.0; q < 1005.0; q += 0.77) query.push_back(q);
+    auto batch = spline.evaluate(query);
+    for (size_t j = 0; j < query.size(); ++j) {
+        EXPECT_DOUBLE_EQ(batch[j], spline.evaluate(query[j]));
+    }
+
+    std::vector<double> reversed(query.rbegin(), query.rend());
+    auto unsortedBatch = spline.evaluate(reversed);
+    EXPECT_DOUBLE_EQ(unsortedBatch.front(), batch.back());
+}
+
+// 测试非法输入
+TEST(CubicSplineTest, RejectsInvalidNodes) {
+    CubicSpline spline;
+    EXPECT_FALSE(spline.build({1.0}, {1.0}));
+    EXPECT_FALSE(spline.build({0.0, 1.0, 1.0}, {0.0, 1.0, 2.0}));
+    EXPECT_FALSE(spline.build({0.0, 1.0}, {0.0}));
+    EXPECT_FALSE(spline.isValid());
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "utils/include/fft_plan.h"
+#include <cmath>
+#include <random>
+
+class FFTPlanTest : public ::testing::Test {
+protected:
+    using Complex = FFTPlan::Complex;
+
+    // 朴素DFT作为参考实现
+    static std::vector<Complex> referenceDFT(const std::vector<Complex>& x) {
+        size_t n = x.size();
+        std::vector<Complex> result(n);
+        for (size_t k = 0; k < n; ++k) {
+            Complex sum(0.0, 0.0);
+            for (size_t t = 0; t < n; ++t) {
+                double angle = -2.0 * M_PI * static_cast<double>((k * t) % n) / n;
+                sum += x[t] * Complex(std::cos(angle), std::sin(angle));
+            }
+            result[k] = sum;
+        }
+        return result;
+    }
+
+    static std::vector<Complex> randomSignal(size_t n) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> dist(-1.0, 1.0);
+        std::vector<Complex> x(n);
+        for (auto& v : x) {
+            v = Complex(dist(gen), dist(gen));
+        }
+        return x;
+    }
+};
+
+// 测试2的幂长度与参考DFT一致
+TEST_F(FFTPlanTest, PowerOfTwoMatchesDFT) {
+    for (size_t n : {1u, 2u, 8u, 64u, 256u}) {
+        auto x = randomSignal(n);
+        auto expected = referenceDFT(x);
+        auto plan = FFTPlan::get(n);
+        EXPECT_TRUE(plan->isPowerOfTwo());
+
+        auto result = plan->forward(x);
+        for (size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(std::abs(result[k] - expected[k]), 0.0, 1e-9) << "n=" << n << " k=" << k;
+        }
+    }
+}
+
+// 测试任意长度（Bluestein）与参考DFT一致
+TEST_F(FFTPlanTest, ArbitraryLengthMatchesDFT) {
+    for (size_t n : {3u, 7u, 100u, 127u, 1000u}) {
+        auto x = randomSignal(n);
+        auto expected = referenceDFT(x);
+        auto plan = FFTPlan::get(n);
+        EXPECT_FALSE(plan->isPowerOfTwo());
+
+        auto result = plan->forward(x);
+        for (size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(std::abs(result[k] - expected[k]), 0.0, 1e-8) << "n=" << n << " k=" << k;
+        }
+    }
+}
+
+// 测试逆变换还原原始序列
+TEST_F(FFTPlanTest, InverseRoundTrip) {
+    for (size_t n : {16u, 30u, 1024u, 999u}) {
+        auto x = randomSignal(n);
+        auto y = x;
+        auto plan = FFTPlan::get(n);
+        plan->forward(y.data());
+        plan->inverse(y.data());
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(std::abs(y[i] - x[i]), 0.0, 1e-10);
+        }
+    }
+}
+
+// 测试实数输入变换与复数变换一致
+TEST_F(FFTPlanTest, RealTransformMatchesComplex) {
+    for (size_t n : {2u, 10u, 64u, 99u, 250u}) {
+        auto x = randomSignal(n);
+        std::vector<double> real(n);
+        std::vector<Complex> complexInput(n);
+        for (size_t i = 0; i < n; ++i) {
+            real[i] = x[i].real();
+            complexInput[i] = Complex(real[i], 0.0);
+        }
+
+        auto plan = FFTPlan::get(n);
+        auto expected = plan->forward(complexInput);
+        auto result = plan->forwardReal(real);
+
+        ASSERT_EQ(result.size(), n / 2 + 1);
+        for (size_t k = 0; k <= n / 2; ++k) {
+            EXPECT_NEAR(std::abs(result[k] - expected[k]), 0.0, 1e-9) << "n=" << n << " k=" << k;
+        }
+    }
+}
+
+// 测试超过65536点的长序列仍能正确定位频率
+TEST_F(FFTPlanTest, LongSignalBeyondOldLimit) {
+    const size_t n = 100000;
+    const size_t bin = 1234;
+    std::vector<double> signal(n);
+    for (size_t i = 0; i < n; ++i) {
+        signal[i] = std::sin(2.0 * M_PI * bin * static_cast<double>(i) / n);
+    }
+
+    auto spectrum = FFTPlan::get(n)->forwardReal(signal);
+    size_t peak = 0;
+    for (size_t k = 1; k < spectrum.size(); ++k) {
+        if (std::abs(spectrum[k]) > std::abs(spectrum[peak])) peak = k;
+    }
+
+    EXPECT_EQ(peak, bin);
+    EXPECT_NEAR(std::abs(spectrum[bin]) * 2.0 / n, 1.0, 1e-6);
+}
+
+// 测试计划缓存复用
+TEST_F(FFTPlanTest, PlansAreCached) {
+    auto a = FFTPlan::get(4096);
+    auto b = FFTPlan::get(4096);
+    EXPECT_EQ(a.get(), b.get());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "utils/include/format_utils.h"
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace {
+
+std::string streamFixed(double value, int decimals) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(decimals) << value;
+    return oss.str();
+}
+
+std::string referenceTimestamp(int64_t ms, const char* format, bool utc) {
+    std::time_t time = static_cast<std::time_t>(std::floor(ms / 1000.0));
+    std::tm tm{};
+    if (utc) {
+        gmtime_r(&time, &tm);
+    } else {
+        localtime_r(&time, &tm);
+    }
+    char buffer[128];
+    size_t length = std::strftime(buffer, sizeof(buffer), format, &tm);
+    return std::string(buffer, length);
+}
+
+} // namespace
+
+// 测试定点输出与流的 fixed + setprecision 逐字一致
+TEST(FormatUtilsTest, FixedMatchesStream) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-8, 12);
+
+    std::vector<double> values = {0.0, -0.0, 0.5, 1.005, 2.675, -123.456, 1e15, 999.995, 0.125};
+    for (int i = 0; i < 2000; ++i) {
+        values.push_back(mantissa(rng) * std::pow(10.0, exponent(rng)));
+    }
+
+    for (double value : values) {
+        for (int decimals : {0, 1, 2, 3, 6}) {
+            EXPECT_EQ(FormatUtils::formatFixed(value, decimals), streamFixed(value, decimals))
+                << value << " decimals=" << decimals;
+        }
+    }
+
+    // 超出栈缓冲区的量级
+    EXPECT_EQ(FormatUtils::formatFixed(1e200, 2), streamFixed(1e200, 2));
+    EXPECT_EQ(FormatUtils::formatFixed(INFINITY, 2), streamFixed(INFINITY, 2));
+
+    std::string out = "x=";
+    FormatUtils::appendFixed(out, 3.14159, 2);
+    out += ';';
+    FormatUtils::appendInteger(out, -1234567890123LL);
+    EXPECT_EQ(out, "x=3.14;-1234567890123");
+}
+
+// 测试最短表示可以精确还原
+TEST(FormatUtilsTest, ShortestRoundTrips) {
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 1000; ++i) {
+        double value = dist(rng);
+        std::string text;
+        FormatUtils::appendShortest(text, value);
+        EXPECT_EQ(std::strtod(text.c_str(), nullptr), value) << text;
+    }
+
+    std::string text;
+    FormatUtils::appendShortest(text, 0.1);
+    EXPECT_EQ(text, "0.1");
+}
+
+// 测试缓存的时间戳格式化在秒、分钟、小时和日期边界上与strftime一致
+TEST(FormatUtilsTest, CachedTimestampMatchesStrftime) {
+    const char* format = "%Y-%m-%d %H:%M:%S";
+    TimestampFormatter local(format);
+    TimestampFormatter utc(format, TimeUtils::TimeZone::UTC);
+    TimestampFormatter iso("%Y-%m-%dT%T", TimeUtils::TimeZone::UTC);
+
+    // 2024-02-29 23:58:30 UTC 附近，跨越分钟、小时、日期和月份
+    const int64_t start = 1709251110000LL;
+    for (int64_t ms = start; ms < start + 180000; ms += 750) {
+        EXPECT_EQ(local.format(ms), referenceTimestamp(ms, format, false)) << ms;
+        EXPECT_EQ(utc.format(ms), referenceTimestamp(ms, format, true)) << ms;
+        EXPECT_EQ(iso.format(ms), referenceTimestamp(ms, "%Y-%m-%dT%H:%M:%S", true)) << ms;
+    }
+
+    // 时间倒退与1970年之前的时间戳
+    EXPECT_EQ(utc.format(0), "1970-01-01 00:00:00");
+    EXPECT_EQ(utc.format(-1), "1969-12-31 23:59:59");
+    EXPECT_EQ(utc.format(start), referenceTimestamp(start, format, true));
+
+    // 秒字段多次出现、不可拆分的转换
+    TimestampFormatter twice("%S|%M|%S", TimeUtils::TimeZone::UTC);
+    EXPECT_EQ(twice.format(61000), "01|01|01");
+    TimestampFormatter epoch("%s");
+    EXPECT_EQ(epoch.format(1234567000), "1234567");
+}
+
+// 测试毫秒与后缀
+TEST(FormatUtilsTest, MillisecondsAndSuffix) {
+    TimestampFormatter formatter("%H:%M:%S", TimeUtils::TimeZone::UTC, true, "Z");
+    EXPECT_EQ(formatter.format(3723004), "01:02:03.004Z");
+    EXPECT_EQ(formatter.format(3723999), "01:02:03.999Z");
+    EXPECT_EQ(formatter.format(-1), "23:59:59.999Z");
+
+    EXPECT_EQ(TimeUtils::formatTimestamp(1709251199123LL, TimeUtils::TimeZone::UTC),
+              "2024-02-29 23:59:59.123Z");
+    EXPECT_EQ(TimeUtils::formatTimestamp(1709251200000LL, TimeUtils::TimeZone::UTC),
+              "2024-03-01 00:00:00.000Z");
+}
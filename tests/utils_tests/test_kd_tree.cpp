@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "utils/include/kd_tree.h"
+#include <algorithm>
+#include <random>
+
+// 测试k近邻查询与暴力搜索一致
+TEST(KdTree2DTest, MatchesBruteForce) {
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<> dist(-10.0, 10.0);
+    std::vector<double> x(500), y(500);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = dist(gen);
+        y[i] = dist(gen);
+    }
+
+    KdTree2D tree;
+    tree.build(x, y);
+    EXPECT_EQ(tree.size(), x.size());
+
+    std::vector<size_t> indices;
+    std::vector<double> distances;
+    for (int q = 0; q < 100; ++q) {
+        double qx = dist(gen);
+        double qy = dist(gen);
+        tree.nearest(qx, qy, 5, indices, distances);
+
+        std::vector<double> expected(x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            expected[i] = (x[i] - qx) * (x[i] - qx) + (y[i] - qy) * (y[i] - qy);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        ASSERT_EQ(distances.size(), 5u);
+        for (size_t j = 0; j < 5; ++j) {
+            EXPECT_DOUBLE_EQ(distances[j], expected[j]);
+        }
+    }
+}
+
+// 测试点数少于k以及空树
+TEST(KdTree2DTest, HandlesSmallInputs) {
+    KdTree2D tree;
+    std::vector<size_t> indices;
+    std::vector<double> distances;
+    tree.nearest(0.0, 0.0, 3, indices, distances);
+    EXPECT_TRUE(indices.empty());
+
+    tree.build({1.0, 2.0}, {0.0, 0.0});
+    tree.nearest(0.0, 0.0, 3, indices, distances);
+    ASSERT_EQ(indices.size(), 2u);
+    EXPECT_EQ(indices[0], 0u);
+    EXPECT_DOUBLE_EQ(distances[1], 4.0);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "utils/include/laplace_solver.h"
+#include <cmath>
+
+// 测试贯穿整个宽度的两块极板之间电位线性分布，电荷与间距成反比
+TEST(LaplaceSolverTest, FullWidthPlatesGiveLinearPotential) {
+    const size_t n = 32;
+    LaplaceSolver2D solver(n, n);
+    for (size_t i = 0; i <= n; ++i) {
+        solver.setFixed(i, 8, 0.0, 1);
+        solver.setFixed(i, 24, 1.0, 2);
+    }
+
+    ASSERT_GT(solver.solve(1e-10), 0);
+    for (size_t j = 8; j <= 24; ++j) {
+        EXPECT_NEAR(solver.value(n / 2, j), (j - 8) / 16.0, 1e-8) << "j=" << j;
+        EXPECT_NEAR(solver.value(0, j), solver.value(n, j), 1e-8);
+    }
+    // 极板外侧没有电场
+    EXPECT_NEAR(solver.value(5, 30), 1.0, 1e-8);
+    EXPECT_NEAR(solver.value(5, 2), 0.0, 1e-8);
+
+    EXPECT_NEAR(solver.charge(2), (n + 1) / 16.0, 1e-7);
+    EXPECT_NEAR(solver.charge(1), -solver.charge(2), 1e-7);
+    EXPECT_TRUE(solver.isFixed(3, 24));
+    EXPECT_EQ(solver.labelAt(3, 24), 2);
+    EXPECT_FALSE(solver.isFixed(3, 23));
+}
+
+// 测试细薄电极的多重网格收敛速度与最大值原理
+TEST(LaplaceSolverTest, ThinElectrodesConverge) {
+    const size_t nx = 256;
+    const size_t ny = 128;
+    LaplaceSolver2D solver(nx, ny);
+    for (size_t i = 96; i <= 160; ++i) {
+        solver.setFixed(i, 60, 0.0, 1);
+        solver.setFixed(i, 68, 1.0, 2);
+    }
+
+    int cycles = solver.solve(1e-8);
+    ASSERT_GT(cycles, 0);
+    EXPECT_LT(cycles, 40);
+
+    for (size_t j = 0; j <= ny; j += 7) {
+        for (size_t i = 0; i <= nx; i += 7) {
+            EXPECT_GE(solver.value(i, j), -1e-9);
+            EXPECT_LE(solver.value(i, j), 1.0 + 1e-9);
+        }
+    }
+    // 边缘场使电容大于平行板值 64/8
+    EXPECT_GT(solver.charge(2), 8.0);
+    EXPECT_NEAR(solver.charge(1), -solver.charge(2), 1e-3 * solver.charge(2));
+}
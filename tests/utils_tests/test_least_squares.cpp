@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "utils/include/least_squares.h"
+#include <cmath>
+#include <random>
+
+// 测试超定线性方程组与精确解一致
+TEST(LeastSquaresTest, SolvesOverdeterminedSystem) {
+    // y = 1 + 2a - 3b，列主序
+    const size_t rows = 6;
+    std::vector<double> a = {
+        1, 1, 1, 1, 1, 1,
+        0, 1, 2, 3, 4, 5,
+        1, 0, 2, 1, 3, 2
+    };
+    std::vector<double> b(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        b[i] = 1.0 + 2.0 * a[rows + i] - 3.0 * a[2 * rows + i];
+    }
+
+    LeastSquaresSolver solver(a, rows, 3);
+    EXPECT_FALSE(solver.usesSVD());
+    EXPECT_EQ(solver.rank(), 3u);
+
+    auto x = solver.solve(b);
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NEAR(x[1], 2.0, 1e-12);
+    EXPECT_NEAR(x[2], -3.0, 1e-12);
+}
+
+// 测试秩亏矩阵退回SVD并仍得到零残差解
+TEST(LeastSquaresTest, RankDeficientFallsBackToSVD) {
+    // 第二列是第一列的两倍
+    std::vector<double> a = {1, 2, 3, 2, 4, 6};
+    std::vector<double> b = {5, 10, 15};
+
+    LeastSquaresSolver solver(a, 3, 2);
+    EXPECT_TRUE(solver.usesSVD());
+    EXPECT_EQ(solver.rank(), 1u);
+
+    // 解不唯一，但须满足 x0 + 2 x1 = 5 且为有限值
+    auto x = solver.solve(b);
+    EXPECT_TRUE(std::isfinite(x[0]) && std::isfinite(x[1]));
+    EXPECT_NEAR(x[0] + 2.0 * x[1], 5.0, 1e-10);
+}
+
+// 测试高阶多项式（正规方程在此阶数下已严重病态）仍能准确恢复系数
+TEST(LeastSquaresTest, HighDegreePolynomialIsStable) {
+    std::vector<double> expected = {1.0, -2.0, 0.5, 3.0, -1.0, 0.25, 0.1, -0.05, 0.02, -0.01, 0.001};
+    std::vector<double> x, y;
+    for (int i = 0; i <= 400; ++i) {
+        double xi = 0.5 + i * 0.01;
+        double value = 0.0;
+        for (size_t k = expected.size(); k-- > 0;) {
+            value = value * xi + expected[k];
+        }
+        x.push_back(xi);
+        y.push_back(value);
+    }
+
+    std::vector<double> coefficients;
+    ASSERT_TRUE(LeastSquaresSolver::fitPolynomial(x.data(), y.data(), nullptr, x.size(), 10, coefficients));
+    ASSERT_EQ(coefficients.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_NEAR(coefficients[k], expected[k], 1e-5) << "k=" << k;
+    }
+}
+
+// 测试权重：零权重的点不影响拟合
+TEST(LeastSquaresTest, WeightedFitIgnoresZeroWeight) {
+    std::vector<double> x = {0, 1, 2, 3, 4};
+    std::vector<double> y = {1, 3, 5, 100, 9};
+    std::vector<double> w = {1, 1, 1, 0, 1};
+
+    std::vector<double> coefficients;
+    ASSERT_TRUE(LeastSquaresSolver::fitPolynomial(x.data(), y.data(), w.data(), x.size(), 1, coefficients));
+    EXPECT_NEAR(coefficients[0], 1.0, 1e-10);
+    EXPECT_NEAR(coefficients[1], 2.0, 1e-10);
+}
+
+// 测试共享自变量的批量拟合
+TEST(LeastSquaresTest, BatchSharesFactorization) {
+    std::vector<double> x;
+    for (int i = 0; i < 50; ++i) x.push_back(i * 0.2);
+
+    std::vector<std::vector<double>> ySeries(100, std::vector<double>(x.size()));
+    for (size_t s = 0; s < ySeries.size(); ++s) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            ySeries[s][i] = s + 0.5 * x[i] - 0.1 * s * x[i] * x[i];
+        }
+    }
+
+    std::vector<std::vector<double>> coefficients;
+    ASSERT_TRUE(LeastSquaresSolver::fitPolynomials(x, ySeries, 2, coefficients));
+    ASSERT_EQ(coefficients.size(), ySeries.size());
+    for (size_t s = 0; s < ySeries.size(); ++s) {
+        EXPECT_NEAR(coefficients[s][0], static_cast<double>(s), 1e-9);
+        EXPECT_NEAR(coefficients[s][1], 0.5, 1e-9);
+        EXPECT_NEAR(coefficients[s][2], -0.1 * s, 1e-9);
+    }
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "utils/include/quantile_sketch.h"
+#include "utils/include/statistics_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+double exactQuantile(const std::vector<double>& values, double q) {
+    return StatisticsUtils::percentile(values, q * 100.0);
+}
+}
+
+// 测试精确百分位数的插值
+TEST(QuantileSketchTest, ExactPercentile) {
+    std::vector<double> values = {5.0, 1.0, 4.0, 2.0, 3.0};
+    EXPECT_DOUBLE_EQ(StatisticsUtils::percentile(values, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(StatisticsUtils::percentile(values, 50.0), 3.0);
+    EXPECT_DOUBLE_EQ(StatisticsUtils::percentile(values, 90.0), 4.6);
+    EXPECT_DOUBLE_EQ(StatisticsUtils::percentile(values, 100.0), 5.0);
+}
+
+// 测试均匀分布上的中位数和尾部分位数
+TEST(QuantileSketchTest, UniformQuantiles) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<> dist(0.0, 100.0);
+    QuantileSketch sketch;
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i) {
+        double v = dist(gen);
+        values.push_back(v);
+        sketch.add(v);
+    }
+
+    EXPECT_DOUBLE_EQ(sketch.count(), 100000.0);
+    EXPECT_LE(sketch.centroids().size(), 100u);
+    for (double q : {0.01, 0.1, 0.5, 0.9, 0.99}) {
+        EXPECT_NEAR(sketch.quantile(q), exactQuantile(values, q), 0.5) << "q=" << q;
+    }
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.0), *std::min_element(values.begin(), values.end()));
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), *std::max_element(values.begin(), values.end()));
+    EXPECT_NEAR(sketch.cdf(50.0), 0.5, 0.01);
+}
+
+// 测试偏态分布的尾部精度
+TEST(QuantileSketchTest, SkewedTails) {
+    std::mt19937 gen(11);
+    std::lognormal_distribution<> dist(0.0, 1.0);
+    QuantileSketch sketch;
+    std::vector<double> values;
+    for (int i = 0; i < 50000; ++i) {
+        double v = dist(gen);
+        values.push_back(v);
+        sketch.add(v);
+    }
+
+    for (double q : {0.01, 0.5, 0.99}) {
+        double exact = exactQuantile(values, q);
+        EXPECT_NEAR(sketch.quantile(q), exact, 0.02 * exact) << "q=" << q;
+    }
+}
+
+// 测试分块草图合并后与整体草图一致
+TEST(QuantileSketchTest, MergeMatchesSingleSketch) {
+    std::mt19937 gen(5);
+    std::normal_distribution<> dist(200.0, 15.0);
+    QuantileSketch whole;
+    std::vector<QuantileSketch> parts(4);
+    std::vector<double> values;
+    for (int i = 0; i < 40000; ++i) {
+        double v = dist(gen);
+        values.push_back(v);
+        whole.add(v);
+        parts[i % 4].add(v);
+    }
+
+    QuantileSketch combined;
+    for (const auto& part : parts) {
+        combined.merge(part);
+    }
+
+    EXPECT_DOUBLE_EQ(combined.count(), whole.count());
+    EXPECT_DOUBLE_EQ(combined.min(), whole.min());
+    EXPECT_DOUBLE_EQ(combined.max(), whole.max());
+    for (double q : {0.01, 0.5, 0.99}) {
+        EXPECT_NEAR(combined.quantile(q), exactQuantile(values, q), 0.3) << "q=" << q;
+    }
+}
+
+// 测试边界情况
+TEST(QuantileSketchTest, EdgeCases) {
+    QuantileSketch sketch;
+    EXPECT_TRUE(sketch.empty());
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+
+    sketch.add(7.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 7.0);
+
+    sketch.add(std::nan(""));
+    EXPECT_DOUBLE_EQ(sketch.count(), 1.0);
+
+    sketch.reset();
+    EXPECT_TRUE(sketch.empty());
+}
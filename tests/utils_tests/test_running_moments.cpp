@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "utils/include/running_moments.h"
+#include "utils/include/statistics_utils.h"
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+class RunningMomentsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 gen(17);
+        std::gamma_distribution<> skewed(2.0, 3.0);
+        std::normal_distribution<> noise(0.0, 1.0);
+        for (int i = 0; i < 5000; ++i) {
+            double a = 1000.0 + skewed(gen);   // 大偏移量检验数值稳定性
+            a_.push_back(a);
+            b_.push_back(-0.5 * a + noise(gen));
+        }
+    }
+
+    std::vector<double> a_;
+    std::vector<double> b_;
+};
+
+// 测试单次遍历结果与两遍算法一致
+TEST_F(RunningMomentsTest, MatchesTwoPassStatistics) {
+    RunningMoments moments(2);
+    for (size_t i = 0; i < a_.size(); ++i) {
+        double values[2] = {a_[i], b_[i]};
+        moments.add(values);
+    }
+
+    double mean = StatisticsUtils::mean(a_);
+    double stdDev = StatisticsUtils::stdDev(a_, mean);
+    EXPECT_EQ(moments.count(), a_.size());
+    EXPECT_NEAR(moments.mean(0), mean, 1e-9);
+    EXPECT_NEAR(moments.variance(0), StatisticsUtils::variance(a_, mean), 1e-8);
+    EXPECT_NEAR(moments.skewness(0), StatisticsUtils::skewness(a_, mean, stdDev), 1e-8);
+    EXPECT_NEAR(moments.kurtosis(0), StatisticsUtils::kurtosis(a_, mean, stdDev), 1e-8);
+    EXPECT_DOUBLE_EQ(moments.min(0), *std::min_element(a_.begin(), a_.end()));
+    EXPECT_DOUBLE_EQ(moments.max(0), *std::max_element(a_.begin(), a_.end()));
+
+    EXPECT_LT(moments.correlation(0, 1), -0.9);
+    EXPECT_DOUBLE_EQ(moments.correlation(0, 1), moments.correlation(1, 0));
+    EXPECT_DOUBLE_EQ(moments.correlation(1, 1), 1.0);
+}
+
+// 测试分块合并与顺序统计一致
+TEST_F(RunningMomentsTest, MergeEqualsSequential) {
+    RunningMoments sequential(2);
+    RunningMoments first(2), second(2), third(2);
+    for (size_t i = 0; i < a_.size(); ++i) {
+        double values[2] = {a_[i], b_[i]};
+        sequential.add(values);
+        (i < 100 ? first : (i < 3000 ? second : third)).add(values);
+    }
+
+    RunningMoments merged(2);
+    merged.merge(first);
+    merged.merge(second);
+    merged.merge(third);
+
+    EXPECT_EQ(merged.count(), sequential.count());
+    for (size_t d = 0; d < 2; ++d) {
+        EXPECT_NEAR(merged.mean(d), sequential.mean(d), 1e-9);
+        EXPECT_NEAR(merged.variance(d), sequential.variance(d), 1e-8);
+        EXPECT_NEAR(merged.skewness(d), sequential.skewness(d), 1e-8);
+        EXPECT_NEAR(merged.kurtosis(d), sequential.kurtosis(d), 1e-8);
+    }
+    EXPECT_NEAR(merged.covariance(0, 1), sequential.covariance(0, 1), 1e-8);
+}
+
+// 测试中位数（奇偶个数）
+TEST(StatisticsUtilsMedianTest, OddAndEven) {
+    EXPECT_DOUBLE_EQ(StatisticsUtils::median({5.0, 1.0, 3.0}), 3.0);
+    EXPECT_DOUBLE_EQ(StatisticsUtils::median({4.0, 1.0, 3.0, 2.0}), 2.5);
+    EXPECT_DOUBLE_EQ(StatisticsUtils::median({}), 0.0);
+}
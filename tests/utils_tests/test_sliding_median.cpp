@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "utils/include/sliding_median.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// 测试奇偶元素个数下的中位数
+TEST(SlidingMedianTest, OddAndEvenCounts) {
+    SlidingMedian median;
+    EXPECT_TRUE(median.empty());
+
+    median.insert(5.0);
+    EXPECT_DOUBLE_EQ(median.median(), 5.0);
+
+    median.insert(1.0);
+    EXPECT_DOUBLE_EQ(median.median(), 3.0);
+
+    median.insert(9.0);
+    EXPECT_DOUBLE_EQ(median.median(), 5.0);
+
+    EXPECT_TRUE(median.erase(5.0));
+    EXPECT_DOUBLE_EQ(median.median(), 5.0);
+    EXPECT_FALSE(median.erase(42.0));
+    EXPECT_EQ(median.size(), 2u);
+}
+
+// 测试滑动窗口结果与排序法一致（含重复值）
+TEST(SlidingMedianTest, MatchesSortedWindow) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> dist(0, 20);
+    std::vector<double> data(2000);
+    for (auto& v : data) {
+        v = dist(gen);
+    }
+
+    const size_t window = 15;
+    SlidingMedian median;
+    for (size_t i = 0; i < data.size(); ++i) {
+        median.insert(data[i]);
+        if (i >= window) {
+            ASSERT_TRUE(median.erase(data[i - window]));
+        }
+        if (i + 1 >= window) {
+            std::vector<double> sorted(data.begin() + (i + 1 - window), data.begin() + i + 1);
+            std::sort(sorted.begin(), sorted.end());
+            ASSERT_DOUBLE_EQ(median.median(), sorted[window / 2]) << "i=" << i;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "utils/include/thread_pool.h"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+// 测试每个块恰好执行一次
+TEST(ThreadPoolTest, ParallelForVisitsEveryChunkOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(visits.size(), [&](size_t chunk) { visits[chunk]++; });
+
+    for (const auto& v : visits) {
+        EXPECT_EQ(v.load(), 1);
+    }
+}
+
+// 测试submit通过future返回结果
+TEST(ThreadPoolTest, SubmitReturnsFuture) {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() { return 6 * 7; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+// 测试池内任务嵌套调用parallelFor不会死锁
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+    ThreadPool pool(2);
+    std::vector<std::future<long>> futures;
+    for (int t = 0; t < 4; ++t) {
+        futures.push_back(pool.submit([&pool]() {
+            std::vector<long> partial(64, 0);
+            pool.parallelFor(partial.size(), [&](size_t chunk) {
+                partial[chunk] = static_cast<long>(chunk);
+            });
+            return std::accumulate(partial.begin(), partial.end(), 0L);
+        }));
+    }
+    for (auto& f : futures) {
+        EXPECT_EQ(f.get(), 63L * 64L / 2L);
+    }
+}
+
+// 测试异常传递到调用线程
+TEST(ThreadPoolTest, ParallelForRethrows) {
+    ThreadPool pool(3);
+    std::atomic<int> executed{0};
+    EXPECT_THROW(pool.parallelFor(16, [&](size_t chunk) {
+        executed++;
+        if (chunk == 5) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+    EXPECT_EQ(executed.load(), 16);
+}
+
+// 测试取消令牌在副本之间共享状态
+TEST(ThreadPoolTest, CancellationTokenIsShared) {
+    CancellationToken token;
+    CancellationToken copy = token;
+    EXPECT_FALSE(copy.isCancelled());
+    token.cancel();
+    EXPECT_TRUE(copy.isCancelled());
+    copy.reset();
+    EXPECT_FALSE(token.isCancelled());
+}